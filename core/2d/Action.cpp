@@ -33,11 +33,16 @@ THE SOFTWARE.
 #include "base/UTF8.h"
 
 NS_AX_BEGIN
+
+AX_POOL_ALLOCATED_IMPL(Action)
+
 //
 // Action Base Class
 //
 
-Action::Action() : _originalTarget(nullptr), _target(nullptr), _tag(Action::INVALID_TAG), _flags(0) {}
+Action::Action()
+    : _originalTarget(nullptr), _target(nullptr), _tag(Action::INVALID_TAG), _flags(0), _tweenIndex(-1)
+{}
 
 Action::~Action()
 {
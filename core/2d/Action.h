@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "base/Ref.h"
 #include "math/Math.h"
 #include "base/ScriptSupport.h"
+#include "base/PoolAllocator.h"
 
 NS_AX_BEGIN
 
@@ -53,6 +54,8 @@ enum
 class AX_DLL Action : public Ref, public Clonable
 {
 public:
+    AX_POOL_ALLOCATED_DECL(Action)
+
     /** Default tag used for all the actions. */
     static const int INVALID_TAG = -1;
     /**
@@ -178,6 +181,10 @@ protected:
     int _tag;
     /** The action flag field. To categorize action into certain groups.*/
     unsigned int _flags;
+    /** Slot of the action in the tween batch of the ActionManager, -1 when the action is stepped on its own. */
+    int _tweenIndex;
+
+    friend class ActionManager;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Action);
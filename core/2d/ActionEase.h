@@ -71,6 +71,8 @@ public:
     bool initWithAction(ActionInterval* action);
 
 protected:
+    friend class ActionManager;
+
     /** The inner action */
     ActionInterval* _inner;
 
@@ -114,6 +114,8 @@ public:
     bool initWithDuration(float d);
 
 protected:
+    friend class ActionManager;
+
     float _elapsed;
     bool _firstTick;
     bool _done;
@@ -454,6 +456,8 @@ public:
     void calculateAngles(float& startAngle, float& diffAngle, float dstAngle);
 
 protected:
+    friend class ActionManager;
+
     bool _is3D;
     Vec3 _dstAngle;
     Vec3 _startAngle;
@@ -520,6 +524,8 @@ public:
     bool initWithDuration(float duration, const Vec3& deltaAngle3D);
 
 protected:
+    friend class ActionManager;
+
     bool _is3D;
     Vec3 _deltaAngle;
     Vec3 _startAngle;
@@ -574,6 +580,8 @@ public:
     bool initWithDuration(float duration, const Vec3& deltaPosition);
 
 protected:
+    friend class ActionManager;
+
     bool _is3D;
     Vec3 _positionDelta;
     Vec3 _startPosition;
@@ -1052,6 +1060,8 @@ public:
     bool initWithDuration(float duration, float sx, float sy, float sz);
 
 protected:
+    friend class ActionManager;
+
     float _scaleX;
     float _scaleY;
     float _scaleZ;
@@ -1201,6 +1211,7 @@ protected:
     uint8_t _fromOpacity;
     friend class FadeOut;
     friend class FadeIn;
+    friend class ActionManager;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(FadeTo);
@@ -1316,6 +1327,8 @@ public:
     bool initWithDuration(float duration, uint8_t red, uint8_t green, uint8_t blue);
 
 protected:
+    friend class ActionManager;
+
     Color3B _to;
     Color3B _from;
 
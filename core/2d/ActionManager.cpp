@@ -30,15 +30,137 @@ THE SOFTWARE.
 #include "2d/ActionManager.h"
 #include "2d/Node.h"
 #include "2d/Action.h"
+#include "2d/ActionInterval.h"
+#include "2d/ActionEase.h"
+#include "2d/TweenFunction.h"
 #include "base/Scheduler.h"
 #include "base/Macros.h"
 
+#include <typeinfo>
+
 NS_AX_BEGIN
+
+// State of the batched tweens, one slot per action in contiguous arrays. A tween sets up to 3 components of its target
+// to from + delta * ease(elapsed / duration), which is what the update of the supported actions computes.
+struct ActionManager::TweenBatch
+{
+    enum Kind : uint8_t
+    {
+        POSITION,
+        SCALE,
+        ROTATION_SKEW,
+        ROTATION_3D,
+        OPACITY,
+        COLOR,
+    };
+
+    using EaseFunc = float (*)(float);
+
+    std::vector<ActionInterval*> actions;  // nullptr for removed slots, they are compacted at the next update
+    std::vector<Node*> targets;
+    std::vector<uint8_t> kinds;
+    std::vector<uint8_t> paused;
+    std::vector<uint8_t> firstTicks;
+    std::vector<EaseFunc> eases;  // nullptr for linear tweens
+    std::vector<float> elapsed;
+    std::vector<float> durations;
+    std::vector<float> times;
+    std::vector<float> from[3];
+    std::vector<float> delta[3];
+    std::vector<float> values[3];
+    std::vector<float> previous[3];  // position set last by MoveBy, for stacking
+
+    std::vector<Action*> finished;
+    size_t removed = 0;
+
+    size_t size() const { return actions.size(); }
+
+    void resize(size_t size)
+    {
+        actions.resize(size);
+        targets.resize(size);
+        kinds.resize(size);
+        paused.resize(size);
+        firstTicks.resize(size);
+        eases.resize(size);
+        elapsed.resize(size);
+        durations.resize(size);
+        times.resize(size);
+        for (int k = 0; k < 3; ++k)
+        {
+            from[k].resize(size);
+            delta[k].resize(size);
+            values[k].resize(size);
+            previous[k].resize(size);
+        }
+    }
+
+    void move(size_t dst, size_t src)
+    {
+        actions[dst]    = actions[src];
+        targets[dst]    = targets[src];
+        kinds[dst]      = kinds[src];
+        paused[dst]     = paused[src];
+        firstTicks[dst] = firstTicks[src];
+        eases[dst]      = eases[src];
+        elapsed[dst]    = elapsed[src];
+        durations[dst]  = durations[src];
+        for (int k = 0; k < 3; ++k)
+        {
+            from[k][dst]     = from[k][src];
+            delta[k][dst]    = delta[k][src];
+            previous[k][dst] = previous[k][src];
+        }
+    }
+};
+
+// the eases which only map the time of their inner action by a tween function, see EASE_TEMPLATE_IMPL
+struct TweenEase
+{
+    const std::type_info& type;
+    float (*func)(float);
+};
+
+static const TweenEase s_tweenEases[] = {
+    {typeid(EaseExponentialIn), tweenfunc::expoEaseIn},
+    {typeid(EaseExponentialOut), tweenfunc::expoEaseOut},
+    {typeid(EaseExponentialInOut), tweenfunc::expoEaseInOut},
+    {typeid(EaseSineIn), tweenfunc::sineEaseIn},
+    {typeid(EaseSineOut), tweenfunc::sineEaseOut},
+    {typeid(EaseSineInOut), tweenfunc::sineEaseInOut},
+    {typeid(EaseBounceIn), tweenfunc::bounceEaseIn},
+    {typeid(EaseBounceOut), tweenfunc::bounceEaseOut},
+    {typeid(EaseBounceInOut), tweenfunc::bounceEaseInOut},
+    {typeid(EaseBackIn), tweenfunc::backEaseIn},
+    {typeid(EaseBackOut), tweenfunc::backEaseOut},
+    {typeid(EaseBackInOut), tweenfunc::backEaseInOut},
+    {typeid(EaseQuadraticActionIn), tweenfunc::quadraticIn},
+    {typeid(EaseQuadraticActionOut), tweenfunc::quadraticOut},
+    {typeid(EaseQuadraticActionInOut), tweenfunc::quadraticInOut},
+    {typeid(EaseQuarticActionIn), tweenfunc::quartEaseIn},
+    {typeid(EaseQuarticActionOut), tweenfunc::quartEaseOut},
+    {typeid(EaseQuarticActionInOut), tweenfunc::quartEaseInOut},
+    {typeid(EaseQuinticActionIn), tweenfunc::quintEaseIn},
+    {typeid(EaseQuinticActionOut), tweenfunc::quintEaseOut},
+    {typeid(EaseQuinticActionInOut), tweenfunc::quintEaseInOut},
+    {typeid(EaseCircleActionIn), tweenfunc::circEaseIn},
+    {typeid(EaseCircleActionOut), tweenfunc::circEaseOut},
+    {typeid(EaseCircleActionInOut), tweenfunc::circEaseInOut},
+    {typeid(EaseCubicActionIn), tweenfunc::cubicEaseIn},
+    {typeid(EaseCubicActionOut), tweenfunc::cubicEaseOut},
+    {typeid(EaseCubicActionInOut), tweenfunc::cubicEaseInOut},
+};
+
 //
 // singleton stuff
 //
 
-ActionManager::ActionManager() : _currentTarget(nullptr), _currentTargetSalvaged(false) {}
+ActionManager::ActionManager()
+    : _currentTarget(nullptr)
+    , _currentTargetSalvaged(false)
+    , _tweens(new TweenBatch())
+    , _tweenBatchingEnabled(true)
+{}
 
 ActionManager::~ActionManager()
 {
@@ -66,6 +188,11 @@ void ActionManager::removeActionAtIndex(ssize_t index,
 {
     Action* action = static_cast<Action*>(element.actions[index]);
 
+    if (action->_tweenIndex >= 0)
+    {
+        removeTween(action, element);
+    }
+
     if (action == element.currentAction && (!element.currentActionSalvaged))
     {
         element.currentAction->retain();
@@ -100,6 +227,7 @@ void ActionManager::pauseTarget(Node* target)
     if (it != _targets.end())
     {
         it->second.paused = true;
+        setTweensPaused(it->second, true);
     }
 }
 
@@ -109,6 +237,7 @@ void ActionManager::resumeTarget(Node* target)
     if (it != _targets.end())
     {
         it->second.paused = false;
+        setTweensPaused(it->second, false);
     }
 }
 
@@ -119,6 +248,7 @@ Vector<Node*> ActionManager::pauseAllRunningActions()
     for (auto& [target, element] : _targets)
     {
         element.paused = true;
+        setTweensPaused(element, true);
         idsWithActions.pushBack(const_cast<Node*>(target));
     }
 
@@ -157,6 +287,8 @@ void ActionManager::addAction(Action* action, Node* target, bool paused)
     actionHandle.actions.pushBack(action);
 
     action->startWithTarget(target);
+
+    addTween(action, actionHandle);
 }
 
 // remove
@@ -189,6 +321,7 @@ void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHan
         element.currentActionSalvaged = true;
     }
 
+    removeTweens(element);
     element.actions.clear();
     if (_currentTarget == &element)
     {
@@ -203,6 +336,7 @@ void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHan
 
 void ActionManager::eraseTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt)
 {
+    removeTweens(actionIt->second);
     actionIt->first->release();
     actionIt = _targets.erase(actionIt);
 }
@@ -387,28 +521,333 @@ ssize_t ActionManager::getNumberOfRunningActions() const
     return count;
 }
 
+// tween batch
+
+static void setTweenComponents(float* components, const Vec3& v)
+{
+    components[0] = v.x;
+    components[1] = v.y;
+    components[2] = v.z;
+}
+
+bool ActionManager::addTween(Action* action, ActionHandle& element)
+{
+    if (!_tweenBatchingEnabled)
+        return false;
+
+    // only the exact types are batched, subclasses may override update
+    auto& type                = typeid(*action);
+    Action* tween             = action;
+    TweenBatch::EaseFunc ease = nullptr;
+    for (auto&& tweenEase : s_tweenEases)
+    {
+        if (tweenEase.type == type)
+        {
+            ease  = tweenEase.func;
+            tween = static_cast<ActionEase*>(action)->_inner;
+            break;
+        }
+    }
+    if (tween == nullptr)
+        return false;
+
+    auto& tweenType   = typeid(*tween);
+    float from[3]     = {};
+    float delta[3]    = {};
+    float previous[3] = {};
+    uint8_t kind;
+    if (tweenType == typeid(MoveTo) || tweenType == typeid(MoveBy))
+    {
+        auto moveBy = static_cast<MoveBy*>(tween);
+        kind        = TweenBatch::POSITION;
+        setTweenComponents(from, moveBy->_startPosition);
+        setTweenComponents(delta, moveBy->_positionDelta);
+        setTweenComponents(previous, moveBy->_previousPosition);
+    }
+    else if (tweenType == typeid(ScaleTo) || tweenType == typeid(ScaleBy))
+    {
+        auto scaleTo = static_cast<ScaleTo*>(tween);
+        kind         = TweenBatch::SCALE;
+        from[0]      = scaleTo->_startScaleX;
+        from[1]      = scaleTo->_startScaleY;
+        from[2]      = scaleTo->_startScaleZ;
+        delta[0]     = scaleTo->_deltaX;
+        delta[1]     = scaleTo->_deltaY;
+        delta[2]     = scaleTo->_deltaZ;
+    }
+    else if (tweenType == typeid(RotateTo))
+    {
+        auto rotateTo = static_cast<RotateTo*>(tween);
+        kind          = rotateTo->_is3D ? TweenBatch::ROTATION_3D : TweenBatch::ROTATION_SKEW;
+        setTweenComponents(from, rotateTo->_startAngle);
+        setTweenComponents(delta, rotateTo->_diffAngle);
+    }
+    else if (tweenType == typeid(RotateBy))
+    {
+        auto rotateBy = static_cast<RotateBy*>(tween);
+        kind          = rotateBy->_is3D ? TweenBatch::ROTATION_3D : TweenBatch::ROTATION_SKEW;
+        setTweenComponents(from, rotateBy->_startAngle);
+        setTweenComponents(delta, rotateBy->_deltaAngle);
+    }
+    else if (tweenType == typeid(FadeTo))
+    {
+        auto fadeTo = static_cast<FadeTo*>(tween);
+        kind        = TweenBatch::OPACITY;
+        from[0]     = fadeTo->_fromOpacity;
+        delta[0]    = fadeTo->_toOpacity - fadeTo->_fromOpacity;
+    }
+    else if (tweenType == typeid(TintTo))
+    {
+        auto tintTo = static_cast<TintTo*>(tween);
+        kind        = TweenBatch::COLOR;
+        from[0]     = tintTo->_from.r;
+        from[1]     = tintTo->_from.g;
+        from[2]     = tintTo->_from.b;
+        delta[0]    = tintTo->_to.r - tintTo->_from.r;
+        delta[1]    = tintTo->_to.g - tintTo->_from.g;
+        delta[2]    = tintTo->_to.b - tintTo->_from.b;
+    }
+    else
+    {
+        return false;
+    }
+
+    auto& batch      = *_tweens;
+    const auto index = batch.size();
+    auto interval    = static_cast<ActionInterval*>(action);
+    batch.resize(index + 1);
+    batch.actions[index]    = interval;
+    batch.targets[index]    = interval->getOriginalTarget();
+    batch.kinds[index]      = kind;
+    batch.paused[index]     = element.paused;
+    batch.firstTicks[index] = interval->_firstTick;
+    batch.eases[index]      = ease;
+    batch.elapsed[index]    = interval->_elapsed;
+    batch.durations[index]  = interval->getDuration();
+    for (int k = 0; k < 3; ++k)
+    {
+        batch.from[k][index]     = from[k];
+        batch.delta[k][index]    = delta[k];
+        batch.previous[k][index] = previous[k];
+    }
+
+    action->_tweenIndex = static_cast<int>(index);
+    ++element.tweenCount;
+    return true;
+}
+
+void ActionManager::removeTween(Action* action, ActionHandle& element)
+{
+    // the slot is compacted at the next update, so the order of the tweens is kept
+    auto& batch          = *_tweens;
+    const auto index     = action->_tweenIndex;
+    batch.actions[index] = nullptr;
+    batch.targets[index] = nullptr;
+    batch.paused[index]  = true;
+    ++batch.removed;
+
+    action->_tweenIndex = -1;
+    --element.tweenCount;
+}
+
+void ActionManager::removeTweens(ActionHandle& element)
+{
+    for (ssize_t i = 0; element.tweenCount > 0 && i < element.actions.size(); ++i)
+    {
+        auto action = element.actions.at(i);
+        if (action->_tweenIndex >= 0)
+            removeTween(action, element);
+    }
+}
+
+void ActionManager::setTweensPaused(ActionHandle& element, bool paused)
+{
+    if (element.tweenCount == 0)
+        return;
+
+    for (auto&& action : element.actions)
+    {
+        if (action->_tweenIndex >= 0)
+            _tweens->paused[action->_tweenIndex] = paused;
+    }
+}
+
+size_t ActionManager::getNumberOfBatchedTweens() const
+{
+    return _tweens->size() - _tweens->removed;
+}
+
+void ActionManager::updateTweens(float dt)
+{
+    auto& batch = *_tweens;
+
+    if (batch.removed)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            if (batch.actions[i] == nullptr)
+                continue;
+
+            if (i != count)
+            {
+                batch.move(count, i);
+                batch.actions[count]->_tweenIndex = static_cast<int>(count);
+            }
+            ++count;
+        }
+        batch.resize(count);
+        batch.removed = 0;
+    }
+
+    // tweens added while the targets are set start at the next update
+    const auto count = batch.size();
+    if (count == 0)
+        return;
+
+    // advance the time like ActionInterval::step, branch free so the compiler can vectorize it
+    auto paused     = batch.paused.data();
+    auto firstTicks = batch.firstTicks.data();
+    auto elapsed    = batch.elapsed.data();
+    auto durations  = batch.durations.data();
+    auto times      = batch.times.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float stepped = firstTicks[i] ? 0.0f : elapsed[i] + dt;
+        elapsed[i]          = paused[i] ? elapsed[i] : stepped;
+        firstTicks[i]       = firstTicks[i] & paused[i];
+        // needed for rewind. elapsed could be negative
+        times[i] = std::max(0.0f, std::min(1.0f, elapsed[i] / durations[i]));
+    }
+
+    auto eases = batch.eases.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (eases[i] && !paused[i])
+            times[i] = eases[i](times[i]);
+    }
+
+    for (int k = 0; k < 3; ++k)
+    {
+        auto from   = batch.from[k].data();
+        auto delta  = batch.delta[k].data();
+        auto values = batch.values[k].data();
+        for (size_t i = 0; i < count; ++i)
+            values[i] = from[i] + delta[i] * times[i];
+    }
+
+    // Write the values to the targets. The setters are virtual and may add or remove actions, which may grow the
+    // arrays, so they are indexed again for every tween
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto action = batch.actions[i];
+        if (action == nullptr || batch.paused[i])
+            continue;
+
+        action->_elapsed   = batch.elapsed[i];
+        action->_firstTick = false;
+
+        // like ActionInterval::step, a script handling the update replaces it
+        const float updateDt = std::max(0.0f, std::min(1.0f, batch.elapsed[i] / batch.durations[i]));
+        if (action->sendUpdateEventToScript(updateDt, action))
+            continue;
+
+        action->_done = action->_elapsed >= batch.durations[i];
+
+        auto target = batch.targets[i];
+        switch (batch.kinds[i])
+        {
+        case TweenBatch::POSITION:
+        {
+#if AX_ENABLE_STACKABLE_ACTIONS
+            // the other actions of the target may have moved it since the last update
+            const Vec3 currentPos = target->getPosition3D();
+            float newPos[3];
+            setTweenComponents(newPos, currentPos);
+            for (int k = 0; k < 3; ++k)
+            {
+                batch.from[k][i] += newPos[k] - batch.previous[k][i];
+                newPos[k] = batch.previous[k][i] = batch.from[k][i] + batch.delta[k][i] * batch.times[i];
+            }
+            target->setPosition3D(Vec3(newPos[0], newPos[1], newPos[2]));
+#else
+            target->setPosition3D(Vec3(batch.values[0][i], batch.values[1][i], batch.values[2][i]));
+#endif  // AX_ENABLE_STACKABLE_ACTIONS
+            break;
+        }
+        case TweenBatch::SCALE:
+            target->setScaleX(batch.values[0][i]);
+            target->setScaleY(batch.values[1][i]);
+            target->setScaleZ(batch.values[2][i]);
+            break;
+        case TweenBatch::ROTATION_SKEW:
+#if AX_USE_PHYSICS
+            if (batch.from[0][i] == batch.from[1][i] && batch.delta[0][i] == batch.delta[1][i])
+            {
+                target->setRotation(batch.values[0][i]);
+                break;
+            }
+#endif  // AX_USE_PHYSICS
+            target->setRotationSkewX(batch.values[0][i]);
+            target->setRotationSkewY(batch.values[1][i]);
+            break;
+        case TweenBatch::ROTATION_3D:
+            target->setRotation3D(Vec3(batch.values[0][i], batch.values[1][i], batch.values[2][i]));
+            break;
+        case TweenBatch::OPACITY:
+            target->setOpacity((uint8_t)batch.values[0][i]);
+            break;
+        case TweenBatch::COLOR:
+            target->setColor(
+                Color3B((uint8_t)batch.values[0][i], (uint8_t)batch.values[1][i], (uint8_t)batch.values[2][i]));
+            break;
+        }
+
+        // the setter may have removed the action
+        if (batch.actions[i] == action && action->_done)
+        {
+            action->retain();
+            batch.finished.emplace_back(action);
+        }
+    }
+
+    for (auto&& action : batch.finished)
+    {
+        if (action->_tweenIndex >= 0)
+        {
+            action->stop();
+            removeAction(action);
+        }
+        action->release();
+    }
+    batch.finished.clear();
+}
+
 // main loop
 void ActionManager::update(float dt)
 {
+    updateTweens(dt);
+
     for (auto actionIt = _targets.begin(); actionIt != _targets.end();)
     {
         auto elt               = &actionIt->second;
         _currentTarget         = elt;
         _currentTargetSalvaged = false;
 
-        if (!_currentTarget->paused)
+        // skip the targets whose actions are all batched
+        if (!_currentTarget->paused && _currentTarget->tweenCount < _currentTarget->actions.size())
         {
             // The 'actions' MutableArray may change while inside this loop.
             for (_currentTarget->actionIndex = 0; _currentTarget->actionIndex < _currentTarget->actions.size();
                  _currentTarget->actionIndex++)
             {
-                _currentTarget->currentAction =
-                    static_cast<Action*>(_currentTarget->actions[_currentTarget->actionIndex]);
-                if (_currentTarget->currentAction == nullptr)
+                auto nextAction = static_cast<Action*>(_currentTarget->actions[_currentTarget->actionIndex]);
+                if (nextAction == nullptr || nextAction->_tweenIndex >= 0)
                 {
                     continue;
                 }
 
+                _currentTarget->currentAction         = nextAction;
                 _currentTarget->currentActionSalvaged = false;
 
                 _currentTarget->currentAction->step(dt);
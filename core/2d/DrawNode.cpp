@@ -37,6 +37,7 @@
 #include "renderer/Shaders.h"
 #include "renderer/backend/ProgramState.h"
 #include "poly2tri/poly2tri.h"
+#include "xxhash.h"
 
 NS_AX_BEGIN
 
@@ -131,7 +132,10 @@ void DrawNode::ensureCapacity(int count)
 
         _customCommandTriangle.createVertexBuffer(sizeof(V2F_C4B_T2F), _bufferCapacityTriangle,
                                                   CustomCommand::BufferUsage::STATIC);
-        _customCommandTriangle.updateVertexBuffer(_bufferTriangle, _bufferCapacityTriangle * sizeof(V2F_C4B_T2F));
+
+        // the new gpu buffer is empty, everything recorded so far must be uploaded again
+        _uploadTriangle = VertexUploadState{};
+        _dirtyTriangle  = true;
     }
 }
 
@@ -146,7 +150,10 @@ void DrawNode::ensureCapacityGLPoint(int count)
 
         _customCommandPoint.createVertexBuffer(sizeof(V2F_C4B_T2F), _bufferCapacityPoint,
                                                CustomCommand::BufferUsage::STATIC);
-        _customCommandPoint.updateVertexBuffer(_bufferPoint, _bufferCapacityPoint * sizeof(V2F_C4B_T2F));
+
+        // the new gpu buffer is empty, everything recorded so far must be uploaded again
+        _uploadPoint = VertexUploadState{};
+        _dirtyPoint  = true;
     }
 }
 
@@ -161,7 +168,10 @@ void DrawNode::ensureCapacityGLLine(int count)
 
         _customCommandLine.createVertexBuffer(sizeof(V2F_C4B_T2F), _bufferCapacityLine,
                                               CustomCommand::BufferUsage::STATIC);
-        _customCommandLine.updateVertexBuffer(_bufferLine, _bufferCapacityLine * sizeof(V2F_C4B_T2F));
+
+        // the new gpu buffer is empty, everything recorded so far must be uploaded again
+        _uploadLine = VertexUploadState{};
+        _dirtyLine  = true;
     }
 }
 
@@ -254,10 +264,59 @@ void DrawNode::updateUniforms(const Mat4& transform, CustomCommand& cmd)
     pipelineDescriptor.programState->setUniform(alphaUniformLocation, &alpha, sizeof(alpha));
 }
 
+void DrawNode::uploadVertices(CustomCommand& cmd,
+                              const V2F_C4B_T2F* buffer,
+                              int count,
+                              VertexUploadState& state)
+{
+    if (_isStatic && count == state.gpuCount)
+    {
+        // the geometry was rebuilt (usually clear() + the same draw calls), only re-upload when it really changed
+        const auto hash = XXH32(buffer, count * sizeof(V2F_C4B_T2F), 0);
+        if (hash == state.gpuHash)
+        {
+            state.uploadedCount = count;
+            cmd.setVertexDrawInfo(0, count);
+            return;
+        }
+    }
+
+    // vertices are only appended between clears, so [uploadedCount, count) is the whole dirty range
+    const int first = state.uploadedCount < count ? state.uploadedCount : 0;
+    if (first < count)
+    {
+        cmd.updateVertexBuffer(const_cast<V2F_C4B_T2F*>(buffer + first), first * sizeof(V2F_C4B_T2F),
+                               (count - first) * sizeof(V2F_C4B_T2F));
+    }
+    cmd.setVertexDrawInfo(0, count);
+
+    state.uploadedCount = count;
+    state.gpuCount      = count;
+    state.gpuHash       = _isStatic ? XXH32(buffer, count * sizeof(V2F_C4B_T2F), 0) : 0;
+}
+
+void DrawNode::setStatic(bool isStatic)
+{
+    if (_isStatic == isStatic)
+        return;
+
+    _isStatic = isStatic;
+
+    // the stored hashes are only maintained while static, force a full upload on the next draw
+    _uploadTriangle.gpuCount = -1;
+    _uploadPoint.gpuCount    = -1;
+    _uploadLine.gpuCount     = -1;
+}
+
 void DrawNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
     if (_bufferCountTriangle)
     {
+        if (_dirtyTriangle)
+        {
+            uploadVertices(_customCommandTriangle, _bufferTriangle, _bufferCountTriangle, _uploadTriangle);
+            _dirtyTriangle = false;
+        }
         updateBlendState(_customCommandTriangle);
         updateUniforms(transform, _customCommandTriangle);
         _customCommandTriangle.init(_globalZOrder);
@@ -266,6 +325,11 @@ void DrawNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 
     if (_bufferCountPoint)
     {
+        if (_dirtyPoint)
+        {
+            uploadVertices(_customCommandPoint, _bufferPoint, _bufferCountPoint, _uploadPoint);
+            _dirtyPoint = false;
+        }
         updateBlendState(_customCommandPoint);
         updateUniforms(transform, _customCommandPoint);
         _customCommandPoint.init(_globalZOrder);
@@ -274,6 +338,11 @@ void DrawNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 
     if (_bufferCountLine)
     {
+        if (_dirtyLine)
+        {
+            uploadVertices(_customCommandLine, _bufferLine, _bufferCountLine, _uploadLine);
+            _dirtyLine = false;
+        }
         updateBlendState(_customCommandLine);
         updateUniforms(transform, _customCommandLine);
         _customCommandLine.init(_globalZOrder);
@@ -288,10 +357,8 @@ void DrawNode::drawPoint(const Vec2& position, const float pointSize, const Colo
     V2F_C4B_T2F* point = _bufferPoint + _bufferCountPoint;
     *point             = {position, color, Tex2F(pointSize, 0)};
 
-    _customCommandPoint.updateVertexBuffer(point, _bufferCountPoint * sizeof(V2F_C4B_T2F), sizeof(V2F_C4B_T2F));
     _bufferCountPoint += 1;
     _dirtyPoint = true;
-    _customCommandPoint.setVertexDrawInfo(0, _bufferCountPoint);
 }
 
 void DrawNode::drawPoints(const Vec2* position, unsigned int numberOfPoints, const Color4B& color)
@@ -312,11 +379,8 @@ void DrawNode::drawPoints(const Vec2* position,
         *(point + i) = {position[i], color, Tex2F(pointSize, 0)};
     }
 
-    _customCommandPoint.updateVertexBuffer(point, _bufferCountPoint * sizeof(V2F_C4B_T2F),
-                                           numberOfPoints * sizeof(V2F_C4B_T2F));
     _bufferCountPoint += numberOfPoints;
     _dirtyPoint = true;
-    _customCommandPoint.setVertexDrawInfo(0, _bufferCountPoint);
 }
 
 void DrawNode::drawLine(const Vec2& origin, const Vec2& destination, const Color4B& color)
@@ -328,10 +392,8 @@ void DrawNode::drawLine(const Vec2& origin, const Vec2& destination, const Color
     *point       = {origin, color, Tex2F(0.0, 0.0)};
     *(point + 1) = {destination, color, Tex2F(0.0, 0.0)};
 
-    _customCommandLine.updateVertexBuffer(point, _bufferCountLine * sizeof(V2F_C4B_T2F), 2 * sizeof(V2F_C4B_T2F));
     _bufferCountLine += 2;
     _dirtyLine = true;
-    _customCommandLine.setVertexDrawInfo(0, _bufferCountLine);
 }
 
 void DrawNode::drawRect(const Vec2& origin, const Vec2& destination, const Color4B& color)
@@ -356,8 +418,7 @@ void DrawNode::drawPoly(const Vec2* poli, unsigned int numberOfPoints, bool clos
         ensureCapacityGLLine(vertex_count);
     }
 
-    V2F_C4B_T2F* point  = _bufferLine + _bufferCountLine;
-    V2F_C4B_T2F* cursor = point;
+    V2F_C4B_T2F* point = _bufferLine + _bufferCountLine;
 
     unsigned int i = 0;
     for (; i < numberOfPoints - 1; i++)
@@ -372,10 +433,8 @@ void DrawNode::drawPoly(const Vec2* poli, unsigned int numberOfPoints, bool clos
         *(point + 1) = {poli[0], color, Tex2F(0.0, 0.0)};
     }
 
-    _customCommandLine.updateVertexBuffer(cursor, _bufferCountLine * sizeof(V2F_C4B_T2F),
-                                          vertex_count * sizeof(V2F_C4B_T2F));
     _bufferCountLine += vertex_count;
-    _customCommandLine.setVertexDrawInfo(0, _bufferCountLine);
+    _dirtyLine = true;
 }
 
 void DrawNode::drawCircle(const Vec2& center,
@@ -530,11 +589,8 @@ void DrawNode::drawDot(const Vec2& pos, float radius, const Color4B& color)
     triangles[0]                    = triangle0;
     triangles[1]                    = triangle1;
 
-    _customCommandTriangle.updateVertexBuffer(triangles, _bufferCountTriangle * sizeof(V2F_C4B_T2F),
-                                              vertex_count * sizeof(V2F_C4B_T2F));
     _bufferCountTriangle += vertex_count;
     _dirtyTriangle = true;
-    _customCommandTriangle.setVertexDrawInfo(0, _bufferCountTriangle);
 }
 
 void DrawNode::drawRect(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Vec2& p4, const Color4B& color)
@@ -611,11 +667,8 @@ void DrawNode::drawSegment(const Vec2& from, const Vec2& to, float radius, const
     };
     triangles[5] = triangles5;
 
-    _customCommandTriangle.updateVertexBuffer(triangles, _bufferCountTriangle * sizeof(V2F_C4B_T2F),
-                                              vertex_count * sizeof(V2F_C4B_T2F));
     _bufferCountTriangle += vertex_count;
     _dirtyTriangle = true;
-    _customCommandTriangle.setVertexDrawInfo(0, _bufferCountTriangle);
 }
 
 void DrawNode::drawPolygon(const Vec2* verts,
@@ -735,10 +788,7 @@ void DrawNode::drawPolygon(const Vec2* verts,
         free(extrude);
     }
 
-    _customCommandTriangle.updateVertexBuffer(triangles, _bufferCountTriangle * sizeof(V2F_C4B_T2F),
-                                              vertex_count * sizeof(V2F_C4B_T2F));
     _bufferCountTriangle += vertex_count;
-    _customCommandTriangle.setVertexDrawInfo(0, _bufferCountTriangle);
     _dirtyTriangle = true;
 }
 
@@ -894,22 +944,22 @@ void DrawNode::drawTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, cons
     V2F_C4B_T2F_Triangle triangle   = {a, b, c};
     triangles[0]                    = triangle;
 
-    _customCommandTriangle.updateVertexBuffer(triangles, _bufferCountTriangle * sizeof(V2F_C4B_T2F),
-                                              vertex_count * sizeof(V2F_C4B_T2F));
     _bufferCountTriangle += vertex_count;
     _dirtyTriangle = true;
-    _customCommandTriangle.setVertexDrawInfo(0, _bufferCountTriangle);
 }
 
 void DrawNode::clear()
 {
-    _bufferCountTriangle = 0;
-    _dirtyTriangle       = true;
-    _bufferCountLine     = 0;
-    _dirtyLine           = true;
-    _bufferCountPoint    = 0;
-    _dirtyPoint          = true;
-    _lineWidth           = _defaultLineWidth;
+    _bufferCountTriangle          = 0;
+    _dirtyTriangle                = true;
+    _uploadTriangle.uploadedCount = 0;
+    _bufferCountLine              = 0;
+    _dirtyLine                    = true;
+    _uploadLine.uploadedCount     = 0;
+    _bufferCountPoint             = 0;
+    _dirtyPoint                   = true;
+    _uploadPoint.uploadedCount    = 0;
+    _lineWidth                    = _defaultLineWidth;
 }
 
 const BlendFunc& DrawNode::getBlendFunc() const
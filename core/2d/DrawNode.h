@@ -405,6 +405,17 @@ public:
 
     bool isIsolated() const { return _isolated; }
 
+    /**
+     * Primitives are always recorded on the CPU side and uploaded once per frame in draw(), only the
+     * range appended since the last upload is sent to the GPU.
+     * When static is set, the node additionally expects its geometry to be rebuilt identically most of the
+     * time (e.g. clear() followed by the same draw calls every frame) and skips the upload when the
+     * recorded vertices didn't change since the last frame.
+     */
+    void setStatic(bool isStatic);
+
+    bool isStatic() const { return _isStatic; }
+
     DrawNode(float lineWidth = DEFAULT_LINE_WIDTH);
     virtual ~DrawNode();
     virtual bool init() override;
@@ -426,6 +437,15 @@ protected:
     void updateBlendState(CustomCommand& cmd);
     void updateUniforms(const Mat4& transform, CustomCommand& cmd);
 
+    struct VertexUploadState
+    {
+        int uploadedCount = 0;  // vertices at the front of the buffer which are already on the gpu
+        int gpuCount      = 0;  // vertices uploaded by the last upload, used by static nodes
+        uint32_t gpuHash  = 0;
+    };
+
+    void uploadVertices(CustomCommand& cmd, const V2F_C4B_T2F* buffer, int count, VertexUploadState& state);
+
     int _bufferCapacityTriangle  = 0;
     int _bufferCountTriangle     = 0;
     V2F_C4B_T2F* _bufferTriangle = nullptr;
@@ -446,10 +466,15 @@ protected:
     CustomCommand _customCommandPoint;
     CustomCommand _customCommandLine;
 
+    VertexUploadState _uploadTriangle;
+    VertexUploadState _uploadPoint;
+    VertexUploadState _uploadLine;
+
     bool _dirtyTriangle     = false;
     bool _dirtyPoint        = false;
     bool _dirtyLine         = false;
     bool _isolated          = false;
+    bool _isStatic          = false;
     float _lineWidth        = 0.0f;
     float _defaultLineWidth = 0.0f;
 
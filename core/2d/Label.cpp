@@ -52,6 +52,8 @@
 
 NS_AX_BEGIN
 
+AX_POOL_ALLOCATED_IMPL(Label)
+
 namespace
 {
 void updateBlend(backend::BlendDescriptor& blendDescriptor, BlendFunc blendFunc)
@@ -34,6 +34,7 @@
 #include "2d/FontAtlas.h"
 #include "2d/FontFreeType.h"
 #include "base/Types.h"
+#include "base/PoolAllocator.h"
 
 NS_AX_BEGIN
 
@@ -114,6 +115,8 @@ class TextureAtlas;
 class AX_DLL Label : public Node, public LabelProtocol, public BlendProtocol
 {
 public:
+    AX_POOL_ALLOCATED_DECL(Label)
+
     enum class Overflow
     {
         // In NONE mode, the dimensions is (0,0) and the content size will change dynamically to fit the label.
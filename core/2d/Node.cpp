@@ -64,6 +64,7 @@ NS_AX_BEGIN
 // FIXME:: Yes, nodes might have a sort problem once every 30 days if the game runs at 60 FPS and each frame sprites are
 // reordered.
 std::uint32_t Node::s_globalOrderOfArrival = 0;
+std::uint32_t Node::s_hierarchyRevision    = 0;
 int Node::__attachedNodeCount              = 0;
 
 // MARK: Constructor, Destructor, Init
@@ -674,6 +675,7 @@ void Node::setParent(Node* parent)
     _parent           = parent;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    ++s_hierarchyRevision;
 }
 
 /// isRelativeAnchorPoint getter
@@ -1228,7 +1230,7 @@ void Node::visit()
     visit(renderer, parentTransform, FLAGS_TRANSFORM_DIRTY);
 }
 
-uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
+void Node::applyNormalizedPosition(uint32_t parentFlags)
 {
     if (_usingNormalizedPosition)
     {
@@ -1242,6 +1244,36 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
             _normalizedPositionDirty                            = false;
         }
     }
+}
+
+bool Node::isTransformPassApplied() const
+{
+    return _transformPassParent && _transformPassFrame == _director->getTotalFrames() + 1;
+}
+
+uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (_transformPassFrame == _director->getTotalFrames() + 1)
+    {
+        // already updated by the TransformHierarchy of the scene, valid as long as nothing changed since
+        if (_transformPassParent == &parentTransform && !_transformUpdated && !_contentSizeDirty &&
+            (!_parent || _parent->_transformPassParent))
+            return parentFlags | _transformPassFlags;
+
+        // visited with another transform, or changed during the frame: compute it here like without the
+        // pass, the children follow since the pass isn't applied anymore, and the next pass refreshes
+        // the world transforms of the subtree
+        applyNormalizedPosition(parentFlags);
+        _transformPassParent = nullptr;
+        _transformUpdated    = true;
+        _modelViewTransform.set(this->transform(parentTransform));
+        if (_hitTestIndexed)
+            _eventDispatcher->setHitTestDirtyForNode(this);
+        return parentFlags | _transformPassFlags | FLAGS_TRANSFORM_DIRTY |
+               (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
+    }
+
+    applyNormalizedPosition(parentFlags);
 
     // Fixes Github issue #16100. Basically when having two cameras, one camera might set as dirty the
     // node that is not visited by it, and might affect certain calculations. Besides, it is faster to do this.
@@ -1253,7 +1285,11 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
     flags |= (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
 
     if (flags & FLAGS_DIRTY_MASK)
+    {
         _modelViewTransform = this->transform(parentTransform);
+        if (_hitTestIndexed)
+            _eventDispatcher->setHitTestDirtyForNode(this);
+    }
 
     _transformUpdated = false;
     _contentSizeDirty = false;
@@ -1281,8 +1317,13 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
     // IMPORTANT:
     // To ease the migration to v3.0, we still support the Mat4 stack,
     // but it is deprecated and your code should not rely on it
-    _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    // The stack isn't maintained for nodes updated by a TransformHierarchy.
+    const bool useMatrixStack = !isTransformPassApplied();
+    if (useMatrixStack)
+    {
+        _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
 
     bool visibleByCamera = isVisitableByVisitingCamera();
 
@@ -1313,7 +1354,8 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
         this->draw(renderer, _modelViewTransform, flags);
     }
 
-    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (useMatrixStack)
+        _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
@@ -56,6 +56,7 @@ class ActionManager;
 class Component;
 class ComponentContainer;
 class EventDispatcher;
+class TransformHierarchy;
 class Scene;
 class Renderer;
 class Director;
@@ -1870,6 +1871,10 @@ protected:
 
     Mat4 transform(const Mat4& parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
+    void applyNormalizedPosition(uint32_t parentFlags);
+
+    // whether the transform of this frame was computed by a TransformHierarchy and is still valid
+    bool isTransformPassApplied() const;
 
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
@@ -1954,6 +1959,7 @@ protected:
     float _globalZOrder;  ///< Global order used to sort the node
 
     static std::uint32_t s_globalOrderOfArrival;
+    static std::uint32_t s_hierarchyRevision;  ///< changes whenever a node gets or loses its parent
 
     Vector<Node*> _children;             ///< array of children nodes
     NodeIndexerMap_t* _childrenIndexer;  ///< The children indexer for fast find child
@@ -1992,6 +1998,9 @@ protected:
     bool _usingNormalizedPosition;
     bool _normalizedPositionDirty;
     
+    bool _hitTestIndexed = false;  ///< whether a listener of the node is in the hit test index of the EventDispatcher
+    bool _hitTestDirty   = false;  ///< whether the bounds in the hit test index are outdated
+
     bool _childFollowCameraMask;
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
@@ -2017,6 +2026,11 @@ protected:
 
     backend::ProgramState* _programState = nullptr;
 
+    // state of the last TransformHierarchy pass over this node
+    std::uint32_t _transformPassFrame = 0;
+    std::uint32_t _transformPassFlags = 0;
+    const Mat4* _transformPassParent  = nullptr;  ///< the transform the pass expects visit to be called with
+
 // Physics:remaining backwardly compatible
 #if AX_USE_PHYSICS
     PhysicsBody* _physicsBody;
@@ -2038,6 +2052,9 @@ public:
 
     static int __attachedNodeCount;
 
+    friend class TransformHierarchy;
+    friend class EventDispatcher;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Node);
 };
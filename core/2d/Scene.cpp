@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "2d/Scene.h"
 #include "base/Director.h"
 #include "2d/Camera.h"
+#include "2d/TransformHierarchy.h"
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
 #include "base/UTF8.h"
@@ -73,6 +74,7 @@ Scene::~Scene()
 #endif
     _director->getEventDispatcher()->removeEventListener(_event);
     AX_SAFE_RELEASE(_event);
+    AX_SAFE_DELETE(_transformHierarchy);
 
 #if AX_USE_PHYSICS
     delete _physicsWorld;
@@ -179,11 +181,22 @@ const std::vector<Camera*>& Scene::getCameras()
     return _cameras;
 }
 
+void Scene::setTransformHierarchyEnabled(bool enabled)
+{
+    if (enabled && !_transformHierarchy)
+        _transformHierarchy = new TransformHierarchy();
+    else if (!enabled)
+        AX_SAFE_DELETE(_transformHierarchy);
+}
+
 void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eyeProjection)
 {
     Camera* defaultCamera = nullptr;
     const auto& transform = getNodeToParentTransform();
 
+    if (_transformHierarchy)
+        _transformHierarchy->update(this, transform);
+
     for (const auto& camera : getCameras())
     {
         if (!camera->isVisible())
@@ -40,6 +40,7 @@ class BaseLight;
 class Renderer;
 class EventListenerCustom;
 class EventCustom;
+class TransformHierarchy;
 #if AX_USE_PHYSICS
 class PhysicsWorld;
 #endif
@@ -126,6 +127,20 @@ public:
 
     void setCameraOrderDirty() { _cameraOrderDirty = true; }
 
+    /** Enable the flattened transform pass: render() updates the world transforms of all nodes in one linear
+     * pass over a TransformHierarchy before visiting, and Node::visit no longer maintains the deprecated
+     * modelview matrix stack of the Director. Useful for big UI trees whose structure rarely changes.
+     *
+     * @param enabled True to enable, disabled by default.
+     * @js NA
+     */
+    void setTransformHierarchyEnabled(bool enabled);
+
+    /** Whether the flattened transform pass is enabled.
+     * @js NA
+     */
+    bool isTransformHierarchyEnabled() const { return _transformHierarchy != nullptr; }
+
     void onProjectionChanged(EventCustom* event);
 
 private:
@@ -150,6 +165,8 @@ protected:
 
     std::vector<BaseLight*> _lights;
 
+    TransformHierarchy* _transformHierarchy = nullptr;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Scene);
 
@@ -47,6 +47,8 @@ THE SOFTWARE.
 
 NS_AX_BEGIN
 
+AX_POOL_ALLOCATED_IMPL(Sprite)
+
 // MARK: create, init, dealloc
 Sprite* Sprite::createWithTexture(Texture2D* texture)
 {
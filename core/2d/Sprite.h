@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "renderer/TrianglesCommand.h"
 #include "renderer/CustomCommand.h"
 #include "2d/AutoPolygon.h"
+#include "base/PoolAllocator.h"
 
 NS_AX_BEGIN
 
@@ -100,6 +101,8 @@ struct transformValues_;
 class AX_DLL Sprite : public Node, public TextureProtocol
 {
 public:
+    AX_POOL_ALLOCATED_DECL(Sprite)
+
     enum class RenderMode
     {
         QUAD,
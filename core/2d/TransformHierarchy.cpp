@@ -0,0 +1,123 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "2d/TransformHierarchy.h"
+#include "2d/ProtectedNode.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+
+NS_AX_BEGIN
+
+void TransformHierarchy::rebuild(Node* root)
+{
+    _root     = root;
+    _revision = Node::s_hierarchyRevision;
+
+    _nodes.clear();
+    _parents.clear();
+
+    // depth first, iterative since UI trees can be very deep
+    std::vector<std::pair<Node*, int>> stack;
+    stack.emplace_back(root, -1);
+    while (!stack.empty())
+    {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        const int index = static_cast<int>(_nodes.size());
+        _nodes.emplace_back(node);
+        _parents.emplace_back(parent);
+
+        for (auto child : node->getChildren())
+            stack.emplace_back(child, index);
+        if (auto protectedNode = dynamic_cast<ProtectedNode*>(node))
+        {
+            for (auto child : protectedNode->getProtectedChildren())
+                stack.emplace_back(child, index);
+        }
+    }
+
+    const auto count = _nodes.size();
+    _subtreeEnds.resize(count);
+    for (size_t i = 0; i < count; ++i)
+        _subtreeEnds[i] = static_cast<int>(i + 1);
+    for (size_t i = count; i-- > 1;)
+    {
+        auto& parentEnd = _subtreeEnds[_parents[i]];
+        parentEnd       = std::max(parentEnd, _subtreeEnds[i]);
+    }
+
+    // the nodes which are not dirty keep their current transform
+    _flags.assign(count, 0);
+    _worlds.resize(count);
+    for (size_t i = 0; i < count; ++i)
+        _worlds[i].set(_nodes[i]->_modelViewTransform);
+}
+
+void TransformHierarchy::update(Node* root, const Mat4& parentTransform)
+{
+    if (_root != root || _revision != Node::s_hierarchyRevision)
+        rebuild(root);
+
+    const auto frame = root->_director->getTotalFrames() + 1;
+    const auto count = _nodes.size();
+    for (size_t i = 0; i < count;)
+    {
+        auto node = _nodes[i];
+        if (!node->_visible)
+        {
+            // like visit, invisible nodes and their children are not updated
+            i = _subtreeEnds[i];
+            continue;
+        }
+
+        const auto parent = _parents[i];
+        uint32_t flags    = parent < 0 ? 0 : _flags[parent];
+
+        node->applyNormalizedPosition(flags);
+        flags |= (node->_transformUpdated ? Node::FLAGS_TRANSFORM_DIRTY : 0);
+        flags |= (node->_contentSizeDirty ? Node::FLAGS_CONTENT_SIZE_DIRTY : 0);
+
+        if (flags & Node::FLAGS_DIRTY_MASK)
+        {
+            Mat4::multiply(parent < 0 ? parentTransform : _worlds[parent], node->getNodeToParentTransform(),
+                           &_worlds[i]);
+            node->_modelViewTransform.set(_worlds[i]);
+            if (node->_hitTestIndexed)
+                node->_eventDispatcher->setHitTestDirtyForNode(node);
+        }
+
+        node->_transformUpdated    = false;
+        node->_contentSizeDirty    = false;
+        node->_transformPassFrame  = frame;
+        node->_transformPassFlags  = flags;
+        node->_transformPassParent = parent < 0 ? &parentTransform : &_nodes[parent]->_modelViewTransform;
+
+        _flags[i] = flags;
+        ++i;
+    }
+}
+
+NS_AX_END
@@ -0,0 +1,80 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "2d/Node.h"
+#include <vector>
+
+NS_AX_BEGIN
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * Flattened copy of a node tree which updates the world transforms of all nodes in one linear pass.
+ *
+ * The nodes are stored depth first with the index of their parent, the world matrices in one
+ * contiguous array. A world matrix is only recomputed when the node or one of its ancestors changed.
+ * Node::visit then uses the precomputed matrices instead of calculating them while recursing and no
+ * longer maintains the deprecated modelview matrix stack of the Director for these nodes.
+ *
+ * The arrays are rebuilt whenever a node is added or removed anywhere, so it pays off for big trees
+ * whose structure rarely changes, i.e. UI. Enable it with Scene::setTransformHierarchyEnabled.
+ * @js NA
+ */
+class AX_DLL TransformHierarchy
+{
+public:
+    /**
+     * Update the world transforms of root and all visible descendants for the current frame.
+     *
+     * @param root The root node of the tree.
+     * @param parentTransform The transform root is visited with.
+     */
+    void update(Node* root, const Mat4& parentTransform);
+
+    /** Get the number of nodes in the flattened tree. */
+    size_t getNodeCount() const { return _nodes.size(); }
+
+protected:
+    void rebuild(Node* root);
+
+    Node* _root             = nullptr;
+    std::uint32_t _revision = 0;
+
+    std::vector<Node*> _nodes;            // weak refs, depth first
+    std::vector<int> _parents;            // index of the parent node, -1 for root
+    std::vector<int> _subtreeEnds;        // index after the last descendant, to skip invisible subtrees
+    std::vector<std::uint32_t> _flags;    // dirty flags of the current frame
+    std::vector<Mat4> _worlds;            // world transforms
+};
+
+// end of _2d group
+/// @}
+
+NS_AX_END
@@ -31,6 +31,7 @@
 #include "3d/MeshMaterial.h"
 #include "3d/AttachNode.h"
 #include "3d/Mesh.h"
+#include "3d/MeshRendererBVH.h"
 
 #include "base/Director.h"
 #include "base/AsyncTaskPool.h"
@@ -267,6 +268,9 @@ MeshRenderer::MeshRenderer()
     , _blend(BlendFunc::ALPHA_NON_PREMULTIPLIED)
     , _lightMask(-1)
     , _aabbDirty(true)
+    , _staticBVH(nullptr)
+    , _staticBVHIndex(0)
+    , _instancing(false)
     , _shaderUsingLight(false)
     , _forceDepthWrite(false)
     , _wireframe(false)
@@ -277,6 +281,8 @@ MeshRenderer::MeshRenderer()
 
 MeshRenderer::~MeshRenderer()
 {
+    if (_staticBVH)
+        _staticBVH->remove(this);
     _meshes.clear();
     _meshVertexDatas.clear();
     AX_SAFE_RELEASE_NULL(_skeleton);
@@ -706,6 +712,7 @@ void MeshRenderer::enableInstancing(MeshMaterial::InstanceMaterialType instanceM
 
 void MeshRenderer::enableInstancing(MeshMaterial* instanceMat, int count)
 {
+    _instancing = true;
     for (auto&& mesh : _meshes)
     {
         mesh->enableInstancing(true, MAX(1, count));
@@ -715,6 +722,7 @@ void MeshRenderer::enableInstancing(MeshMaterial* instanceMat, int count)
 
 void MeshRenderer::disableInstancing()
 {
+    _instancing = false;
     for (auto&& mesh : _meshes)
         mesh->enableInstancing(false, 0);
 }
@@ -851,17 +859,27 @@ void MeshRenderer::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform
 
 void MeshRenderer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-#if AX_USE_CULLING
-    // TODO new-renderer: interface isVisibleInFrustum removal
-    //  camera clipping
-//    if(_children.empty() && Camera::getVisitingCamera() &&
-//    !Camera::getVisitingCamera()->isVisibleInFrustum(&getAABB()))
-//        return;
-#endif
-
     if (_skeleton)
         _skeleton->updateBoneMatrix();
 
+#if AX_USE_CULLING
+    // camera clipping, the children are visited anyway
+    auto camera = Camera::getVisitingCamera();
+    if (camera && !_instancing)
+    {
+        if (updateAABB(transform) && _staticBVH)
+            _staticBVH->updateBounds(this, _aabb);
+
+        bool visible = _staticBVH ? _staticBVH->isVisible(this, camera) : camera->isVisibleInFrustum(&_aabb);
+        if (!visible)
+        {
+            renderer->addCulledMeshes(_meshes.size());
+            return;
+        }
+    }
+    renderer->addDrawnMeshes(_meshes.size());
+#endif
+
     Color4F color(getDisplayedColor());
     color.a = getDisplayedOpacity() / 255.0f;
 
@@ -929,32 +947,32 @@ AABB MeshRenderer::getAABBRecursively()
 
 const AABB& MeshRenderer::getAABB() const
 {
-    Mat4 nodeToWorldTransform(getNodeToWorldTransform());
+    updateAABB(getNodeToWorldTransform());
+    return _aabb;
+}
 
+bool MeshRenderer::updateAABB(const Mat4& nodeToWorldTransform) const
+{
     // If nodeToWorldTransform matrix isn't changed, we don't need to transform aabb.
     if (memcmp(_nodeToWorldTransform.m, nodeToWorldTransform.m, sizeof(Mat4)) == 0 && !_aabbDirty)
     {
-        return _aabb;
+        return false;
     }
-    else
+
+    _aabb.reset();
+    if (_meshes.size())
     {
-        _aabb.reset();
-        if (_meshes.size())
+        for (const auto& it : _meshes)
         {
-            Mat4 transform(nodeToWorldTransform);
-            for (const auto& it : _meshes)
-            {
-                if (it->isVisible())
-                    _aabb.merge(it->getAABB());
-            }
-
-            _aabb.transform(transform);
-            _nodeToWorldTransform = nodeToWorldTransform;
-            _aabbDirty            = false;
+            if (it->isVisible())
+                _aabb.merge(it->getAABB());
         }
-    }
 
-    return _aabb;
+        _aabb.transform(nodeToWorldTransform);
+        _nodeToWorldTransform.set(nodeToWorldTransform);
+        _aabbDirty = false;
+    }
+    return true;
 }
 
 Action* MeshRenderer::runAction(Action* action)
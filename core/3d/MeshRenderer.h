@@ -51,6 +51,7 @@ class Mesh;
 class Texture2D;
 class MeshSkin;
 class AttachNode;
+class MeshRendererBVH;
 struct NodeData;
 /** @brief MeshRenderer: A mesh can be loaded from model files, .obj, .c3t, .c3b
  *and a mesh renderer renders a list of these loaded meshes with specified materials
@@ -147,6 +148,9 @@ public:
      */
     AABB getAABBRecursively();
 
+    /** Gets the hierarchy of static mesh renderers culling this mesh renderer, see MeshRendererBVH::add. */
+    MeshRendererBVH* getStaticBVH() const { return _staticBVH; }
+
     /**
      * Executes an action, and returns the action that is executed. For the MeshRenderer special logic is needed to take
      * care of Fading.
@@ -247,6 +251,9 @@ public:
 
     void onAABBDirty() { _aabbDirty = true; }
 
+    // updates the cached aabb for the world transform, returns true if it was recalculated
+    bool updateAABB(const Mat4& nodeToWorldTransform) const;
+
     void afterAsyncLoad(void* param);
 
     static AABB getAABBRecursivelyImp(Node* node);
@@ -320,6 +327,9 @@ protected:
     mutable Mat4 _nodeToWorldTransform;  // cache current matrix
     unsigned int _lightMask;
     mutable bool _aabbDirty;
+    MeshRendererBVH* _staticBVH;
+    unsigned int _staticBVHIndex;
+    bool _instancing;  // instances are drawn at the transforms of other nodes, so the aabb can't cull them
     bool _shaderUsingLight;  // Is the current shader using lighting?
     bool _forceDepthWrite;   // Always write to depth buffer
     bool _wireframe;         // render in wireframe mode
@@ -340,6 +350,8 @@ protected:
         NodeDatas* nodeDatas;
     };
     AsyncLoadParam _asyncLoadParam;
+
+    friend class MeshRendererBVH;
 };
 
 ///////////////////////////////////////////////////////
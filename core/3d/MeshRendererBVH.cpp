@@ -0,0 +1,215 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "3d/MeshRendererBVH.h"
+#include "3d/MeshRenderer.h"
+#include "2d/Camera.h"
+#include "base/Director.h"
+
+#include <algorithm>
+#include <numeric>
+
+NS_AX_BEGIN
+
+namespace
+{
+// mesh renderers per leaf
+constexpr unsigned int BVH_LEAF_SIZE = 4;
+}  // namespace
+
+MeshRendererBVH* MeshRendererBVH::create()
+{
+    auto ret = new MeshRendererBVH();
+    ret->autorelease();
+    return ret;
+}
+
+MeshRendererBVH::MeshRendererBVH() : _cullCamera(nullptr), _cullFrame(0), _stamp(0), _dirty(false) {}
+
+MeshRendererBVH::~MeshRendererBVH()
+{
+    for (auto&& item : _items)
+        item.meshRenderer->_staticBVH = nullptr;
+}
+
+void MeshRendererBVH::add(MeshRenderer* meshRenderer)
+{
+    if (meshRenderer->_staticBVH == this)
+        return;
+    if (meshRenderer->_staticBVH)
+        meshRenderer->_staticBVH->remove(meshRenderer);
+
+    meshRenderer->_staticBVH      = this;
+    meshRenderer->_staticBVHIndex = static_cast<unsigned int>(_items.size());
+
+    const auto& aabb = meshRenderer->getAABB();
+    _items.emplace_back(Item{meshRenderer, aabb, (aabb._min + aabb._max) * 0.5f, 0});
+    _dirty = true;
+}
+
+void MeshRendererBVH::remove(MeshRenderer* meshRenderer)
+{
+    if (meshRenderer->_staticBVH != this)
+        return;
+
+    auto index = meshRenderer->_staticBVHIndex;
+    if (index + 1 != _items.size())
+    {
+        _items[index]                               = _items.back();
+        _items[index].meshRenderer->_staticBVHIndex = index;
+    }
+    _items.pop_back();
+
+    meshRenderer->_staticBVH = nullptr;
+    _dirty                   = true;
+}
+
+void MeshRendererBVH::removeAll()
+{
+    for (auto&& item : _items)
+        item.meshRenderer->_staticBVH = nullptr;
+    _items.clear();
+    _dirty = true;
+}
+
+bool MeshRendererBVH::isVisible(MeshRenderer* meshRenderer, const Camera* camera)
+{
+    AXASSERT(meshRenderer->_staticBVH == this, "The mesh renderer isn't in this hierarchy!");
+
+    if (_dirty)
+    {
+        rebuild();
+        _cullCamera = nullptr;
+    }
+
+    // cull everything once per camera and frame, the mesh renderers drawn later only check their stamp
+    auto frame = Director::getInstance()->getTotalFrames();
+    if (camera != _cullCamera || frame != _cullFrame)
+    {
+        _cullCamera = camera;
+        _cullFrame  = frame;
+        cull(camera);
+    }
+
+    return _items[meshRenderer->_staticBVHIndex].visibleStamp == _stamp;
+}
+
+void MeshRendererBVH::updateBounds(MeshRenderer* meshRenderer, const AABB& aabb)
+{
+    auto& item = _items[meshRenderer->_staticBVHIndex];
+    if (item.aabb._min != aabb._min || item.aabb._max != aabb._max)
+    {
+        item.aabb   = aabb;
+        item.center = (aabb._min + aabb._max) * 0.5f;
+        _dirty      = true;
+    }
+}
+
+void MeshRendererBVH::rebuild()
+{
+    _dirty = false;
+    _nodes.clear();
+    _order.resize(_items.size());
+    std::iota(_order.begin(), _order.end(), 0u);
+
+    if (!_items.empty())
+    {
+        _nodes.reserve(_items.size() / BVH_LEAF_SIZE * 2 + 1);
+        buildNode(0, static_cast<unsigned int>(_items.size()));
+    }
+}
+
+int MeshRendererBVH::buildNode(unsigned int first, unsigned int count)
+{
+    const int index = static_cast<int>(_nodes.size());
+    _nodes.emplace_back();
+
+    AABB aabb;
+    AABB centers;
+    for (unsigned int i = first; i < first + count; ++i)
+    {
+        const auto& item = _items[_order[i]];
+        aabb.merge(item.aabb);
+        centers.updateMinMax(&item.center, 1);
+    }
+    _nodes[index].aabb  = aabb;
+    _nodes[index].first = first;
+    _nodes[index].count = count;
+
+    if (count <= BVH_LEAF_SIZE)
+        return index;
+
+    // split at the median of the centers along the longest axis
+    const Vec3 extent = centers._max - centers._min;
+    const int axis    = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    const auto begin  = _order.begin() + first;
+    const auto half   = count / 2;
+    std::nth_element(begin, begin + half, begin + count, [this, axis](unsigned int a, unsigned int b) {
+        const auto& ca = _items[a].center;
+        const auto& cb = _items[b].center;
+        return axis == 0 ? ca.x < cb.x : (axis == 1 ? ca.y < cb.y : ca.z < cb.z);
+    });
+
+    const int left      = buildNode(first, half);
+    const int right     = buildNode(first + half, count - half);
+    _nodes[index].left  = left;
+    _nodes[index].right = right;
+    return index;
+}
+
+void MeshRendererBVH::cull(const Camera* camera)
+{
+    ++_stamp;
+    if (_nodes.empty())
+        return;
+
+    _stack.clear();
+    _stack.emplace_back(0);
+    while (!_stack.empty())
+    {
+        const auto& node = _nodes[_stack.back()];
+        _stack.pop_back();
+
+        if (!camera->isVisibleInFrustum(&node.aabb))
+            continue;
+
+        if (node.left < 0)
+        {
+            for (unsigned int i = node.first; i < node.first + node.count; ++i)
+            {
+                auto& item = _items[_order[i]];
+                if (node.count == 1 || camera->isVisibleInFrustum(&item.aabb))
+                    item.visibleStamp = _stamp;
+            }
+        }
+        else
+        {
+            _stack.emplace_back(node.left);
+            _stack.emplace_back(node.right);
+        }
+    }
+}
+
+NS_AX_END
@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+
+#include "base/Ref.h"
+#include "3d/AABB.h"
+
+NS_AX_BEGIN
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+class Camera;
+class MeshRenderer;
+
+/**
+ * @brief A bounding volume hierarchy over static mesh renderers.
+ *
+ * The mesh renderers added to the hierarchy aren't tested against the camera frustum one by one, the hierarchy culls
+ * all of them at the first draw of each camera per frame instead, which keeps culling thousands of mesh renderers
+ * cheap. The hierarchy is rebuilt before the next query once the world bounds of a mesh renderer change, so it suits
+ * mesh renderers which rarely move.
+ *
+ * @note The hierarchy doesn't retain the mesh renderers, a mesh renderer removes itself when it's destroyed.
+ * Retain the hierarchy as long as it's used, the mesh renderers are culled one by one again once it's destroyed.
+ */
+class AX_DLL MeshRendererBVH : public Ref
+{
+public:
+    static MeshRendererBVH* create();
+
+    MeshRendererBVH();
+    ~MeshRendererBVH();
+
+    /** Adds a mesh renderer, it's removed from its previous hierarchy first. */
+    void add(MeshRenderer* meshRenderer);
+
+    void remove(MeshRenderer* meshRenderer);
+
+    void removeAll();
+
+    size_t getCount() const { return _items.size(); }
+
+    /** Whether the mesh renderer is inside the frustum of the camera. */
+    bool isVisible(MeshRenderer* meshRenderer, const Camera* camera);
+
+    /** Updates the world bounds of a mesh renderer, called by the mesh renderer when it draws. */
+    void updateBounds(MeshRenderer* meshRenderer, const AABB& aabb);
+
+protected:
+    struct Item
+    {
+        MeshRenderer* meshRenderer;
+        AABB aabb;
+        Vec3 center;
+        unsigned int visibleStamp;
+    };
+
+    struct BVHNode
+    {
+        AABB aabb;
+        // children of inner nodes, -1 for leaves
+        int left  = -1;
+        int right = -1;
+        // range of _order covered by leaves
+        unsigned int first = 0;
+        unsigned int count = 0;
+    };
+
+    void rebuild();
+    int buildNode(unsigned int first, unsigned int count);
+    void cull(const Camera* camera);
+
+    std::vector<Item> _items;
+    std::vector<unsigned int> _order;
+    std::vector<BVHNode> _nodes;
+    std::vector<int> _stack;
+
+    const Camera* _cullCamera;
+    unsigned int _cullFrame;
+    unsigned int _stamp;
+    bool _dirty;
+};
+
+// end of 3d group
+/// @}
+
+NS_AX_END
@@ -32,6 +32,8 @@
 #include <thread>
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/Data.h"
+#include "platform/FileUtils.h"
 
 #include "audio/AudioDecoderManager.h"
 #include "audio/AudioDecoder.h"
@@ -57,12 +59,16 @@ unsigned int __idIndex = 0;
 NS_AX_BEGIN
 
 AudioCache::AudioCache()
-    : _totalFrames(0)
-    , _framesRead(0)
-    , _format(-1)
+    : _format(-1)
     , _duration(0.0f)
+    , _totalFrames(0)
+    , _framesRead(0)
     , _alBufferId(INVALID_AL_BUFFER_ID)
+    , _decodeForMixer(false)
     , _queBufferFrames(0)
+    , _pcmSize(0)
+    , _lastPlayed(0)
+    , _keepEncodedData(false)
     , _state(State::INITIAL)
     , _isDestroyed(std::make_shared<bool>(false))
     , _id(++__idIndex)
@@ -130,6 +136,10 @@ void AudioCache::readDataTask(unsigned int selfId)
     AudioDecoder* decoder = AudioDecoderManager::createDecoder(_fileFullPath);
     do
     {
+        // decodes the clip again from memory once its pcm data was evicted
+        if (decoder != nullptr && _encodedData)
+            decoder->setEncodedData(_encodedData);
+
         if (decoder == nullptr || !decoder->open(_fileFullPath))
             break;
 
@@ -184,12 +194,20 @@ void AudioCache::readDataTask(unsigned int selfId)
             const uint32_t framesToReadOnce =
                 std::min(totalFrames, static_cast<uint32_t>(sampleRate * QUEUEBUFFER_TIME_STEP * QUEUEBUFFER_NUM));
 
-            alGenBuffers(1, &_alBufferId);
-            auto alError = alGetError();
-            if (alError != AL_NO_ERROR)
+            // 16 bits clips are kept in memory for the software mixer instead of an OpenAL buffer
+            const bool forMixer =
+                _decodeForMixer && sourceFormat == AUDIO_SOURCE_FORMAT::PCM_16 && channelCount <= 2;
+
+            ALenum alError = AL_NO_ERROR;
+            if (!forMixer)
             {
-                ALOGE("%s: attaching audio to buffer fail: %x", __FUNCTION__, alError);
-                break;
+                alGenBuffers(1, &_alBufferId);
+                alError = alGetError();
+                if (alError != AL_NO_ERROR)
+                {
+                    ALOGE("%s: attaching audio to buffer fail: %x", __FUNCTION__, alError);
+                    break;
+                }
             }
 
             std::vector<char> pcmBuffer(dataSize, 0);
@@ -235,7 +253,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                   totalFrames, _framesRead, remainingFrames);
             if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
                 alBufferi(_alBufferId, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-            alBufferData(_alBufferId, _format, pcmData, (ALsizei)dataSize, (ALsizei)sampleRate);
+            if (!forMixer)
+                alBufferData(_alBufferId, _format, pcmData, (ALsizei)dataSize, (ALsizei)sampleRate);
 #else
 #    if !AX_USE_ALSOFT
             /// Apple OpenAL framework, try adjust frames
@@ -285,7 +304,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                 "remainingFrames: %u",
                 totalFrames, _framesRead, adjustFrames, remainingFrames);
             _framesRead += adjustFrames;
-            alBufferData(_alBufferId, _format, pcmData, (ALsizei)dataSize, (ALsizei)sampleRate);
+            if (!forMixer)
+                alBufferData(_alBufferId, _format, pcmData, (ALsizei)dataSize, (ALsizei)sampleRate);
 #endif
             alError = alGetError();
             if (alError != AL_NO_ERROR)
@@ -294,6 +314,31 @@ void AudioCache::readDataTask(unsigned int selfId)
                 break;
             }
 
+            if (forMixer)
+            {
+                auto clip          = std::make_shared<AudioMixer::Clip>();
+                clip->channelCount = channelCount;
+                clip->sampleRate   = sampleRate;
+                clip->samples.assign(reinterpret_cast<const int16_t*>(pcmData),
+                                     reinterpret_cast<const int16_t*>(pcmData + dataSize));
+                _mixerClip = std::move(clip);
+            }
+
+            _pcmSize = dataSize;
+
+            // keep compressed clips resident, so evicting their pcm data doesn't cost file io later
+            if (_keepEncodedData && !_encodedData)
+            {
+                auto fileUtils = FileUtils::getInstance();
+                auto fileSize  = fileUtils->getFileSize(_fileFullPath);
+                if (fileSize > 0 && fileSize < dataSize / 2)
+                {
+                    auto encodedData = std::make_shared<Data>(fileUtils->getDataFromFile(_fileFullPath));
+                    if (!encodedData->isNull())
+                        _encodedData = std::move(encodedData);
+                }
+            }
+
             _state = State::READY;
         }
         else
@@ -340,6 +385,27 @@ void AudioCache::readDataTask(unsigned int selfId)
     ALOGVV("readDataTask end, cache id=%u", selfId);
 }
 
+void AudioCache::evictPcmData()
+{
+    // Note: It's in cocos thread, the caller ensures no player uses the buffer
+    std::lock_guard<std::mutex> lk(_readDataTaskMutex);
+    if (_state != State::READY || _pcmSize == 0)
+        return;
+
+    ALOGV("AudioCache (id=%u), evict buffer: %u, size: %u", _id, _alBufferId, _pcmSize);
+    if (_alBufferId != INVALID_AL_BUFFER_ID && alIsBuffer(_alBufferId))
+    {
+        alDeleteBuffers(1, &_alBufferId);
+    }
+    _alBufferId = INVALID_AL_BUFFER_ID;
+    _mixerClip.reset();
+    _pcmSize    = 0;
+    _framesRead = 0;
+
+    std::lock_guard<std::mutex> lk2(_playCallbackMutex);
+    _state = State::INITIAL;
+}
+
 void AudioCache::addPlayCallback(const std::function<void()>& callback)
 {
     std::lock_guard<std::mutex> lk(_playCallbackMutex);
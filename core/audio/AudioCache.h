@@ -35,12 +35,14 @@
 
 #include "platform/PlatformMacros.h"
 #include "audio/AudioMacros.h"
+#include "audio/AudioMixer.h"
 #include "audio/alconfig.h"
 
 NS_AX_BEGIN
 
 class AudioEngineImpl;
 class AudioPlayer;
+class Data;
 
 class AX_DLL AudioCache
 {
@@ -61,6 +63,9 @@ public:
     void addLoadCallback(const std::function<void(bool)>& callback);
 
 protected:
+    // deletes the decoded pcm data, the next play decodes the clip again
+    void evictPcmData();
+
     void setSkipReadDataTask(bool isSkip) { _isSkipReadDataTask = isSkip; };
     void readDataTask(unsigned int selfId);
 
@@ -80,6 +85,10 @@ protected:
      */
     ALuint _alBufferId;
 
+    // Cached pcm data of the software mixer, replaces _alBufferId when _decodeForMixer is set
+    std::shared_ptr<const AudioMixer::Clip> _mixerClip;
+    bool _decodeForMixer;
+
     /*Queue buffer related stuff
      *  Streaming in OpenAL when sizeInBytes greater then PCMDATA_CACHEMAXSIZE
      */
@@ -87,6 +96,14 @@ protected:
     ALsizei _queBufferSize[QUEUEBUFFER_NUM];
     uint32_t _queBufferFrames;
 
+    /*Memory budget related stuff;
+     * Size of the cached pcm data, the compressed file content is kept to decode it again once evicted
+     */
+    uint32_t _pcmSize;
+    std::shared_ptr<const Data> _encodedData;
+    uint64_t _lastPlayed;
+    bool _keepEncodedData;
+
     std::mutex _playCallbackMutex;
     std::vector<std::function<void()>> _playCallbacks;
 
@@ -27,11 +27,61 @@
 #include "audio/AudioDecoder.h"
 #include "audio/AudioMacros.h"
 #include "platform/FileUtils.h"
+#include "base/Data.h"
 
 #define LOG_TAG "AudioDecoder"
 
 NS_AX_BEGIN
 
+namespace
+{
+// read only stream over the encoded audio file kept in memory
+class EncodedDataStream : public IFileStream
+{
+public:
+    explicit EncodedDataStream(std::shared_ptr<const Data> data) : _data(std::move(data)) {}
+
+    bool open(std::string_view /*path*/, IFileStream::Mode mode) override { return mode == IFileStream::Mode::READ; }
+    int close() override
+    {
+        _data.reset();
+        return 0;
+    }
+
+    int64_t seek(int64_t offset, int origin) const override
+    {
+        int64_t base = 0;
+        if (origin == SEEK_CUR)
+            base = _offset;
+        else if (origin == SEEK_END)
+            base = size();
+        if (!_data || base + offset < 0 || base + offset > size())
+            return -1;
+        _offset = base + offset;
+        return _offset;
+    }
+
+    int read(void* buf, unsigned int size) const override
+    {
+        if (!_data)
+            return -1;
+        auto count = static_cast<unsigned int>((std::min)(static_cast<int64_t>(size), this->size() - _offset));
+        memcpy(buf, _data->getBytes() + _offset, count);
+        _offset += count;
+        return static_cast<int>(count);
+    }
+
+    int write(const void* /*buf*/, unsigned int /*size*/) const override { return -1; }
+    int64_t tell() const override { return _data ? _offset : -1; }
+    int64_t size() const override { return _data ? static_cast<int64_t>(_data->getSize()) : -1; }
+    bool isOpen() const override { return _data != nullptr; }
+
+private:
+    std::shared_ptr<const Data> _data;
+    mutable int64_t _offset = 0;
+};
+}  // namespace
+
 AudioDecoder::AudioDecoder()
     : _isOpened(false)
     , _totalFrames(0)
@@ -101,6 +151,18 @@ AUDIO_SOURCE_FORMAT AudioDecoder::getSourceFormat() const
 {
     return _sourceFormat;
 }
+
+void AudioDecoder::setEncodedData(std::shared_ptr<const Data> encodedData)
+{
+    _encodedData = std::move(encodedData);
+}
+
+std::unique_ptr<IFileStream> AudioDecoder::openFileStream(std::string_view fullPath) const
+{
+    if (_encodedData)
+        return std::make_unique<EncodedDataStream>(_encodedData);
+    return FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+}
 NS_AX_END  // namespace ax
 
 #undef LOG_TAG
@@ -28,10 +28,13 @@
 
 #include <stdint.h>
 #include <string>
+#include <memory>
 #include "platform/IFileStream.h"
 
 NS_AX_BEGIN
 
+class Data;
+
 enum class AUDIO_SOURCE_FORMAT : uint16_t
 {
     PCM_UNK,  // Unknown
@@ -133,10 +136,19 @@ public:
 
     virtual AUDIO_SOURCE_FORMAT getSourceFormat() const;
 
+    /**
+     * @brief Lets the next |open| read the encoded audio file from memory instead of the file system.
+     * @param encodedData The content of the audio file, it's shared with the decoder until the decoder is destroyed.
+     */
+    void setEncodedData(std::shared_ptr<const Data> encodedData);
+
 protected:
     AudioDecoder();
     virtual ~AudioDecoder();
 
+    /** Opens the stream of the audio file, decoders should use it instead of FileUtils::openFileStream. */
+    std::unique_ptr<IFileStream> openFileStream(std::string_view fullPath) const;
+
     bool _isOpened;
     uint32_t _totalFrames;
     uint32_t _bytesPerBlock;  // Same as bytesPerFrame when _samplesPerBlock is 1
@@ -144,6 +156,7 @@ protected:
     uint32_t _sampleRate;
     uint32_t _channelCount;
     AUDIO_SOURCE_FORMAT _sourceFormat;
+    std::shared_ptr<const Data> _encodedData;
 
     friend class AudioDecoderManager;
 };
@@ -130,7 +130,7 @@ bool AudioDecoderMp3::open(std::string_view fullPath)
 #if !AX_USE_MPG123
     do
     {
-        _fileStream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+        _fileStream = openFileStream(fullPath);
         if (!_fileStream)
         {
             ALOGE("Trouble with minimp3(1): %s\n", strerror(errno));
@@ -71,7 +71,7 @@ AudioDecoderOgg::~AudioDecoderOgg()
 
 bool AudioDecoderOgg::open(std::string_view fullPath)
 {
-    auto fs = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ).release();
+    auto fs = openFileStream(fullPath).release();
     if (!fs)
     {
         ALOGE("Trouble with ogg(1): %s\n", strerror(errno));
@@ -78,9 +78,9 @@ static bool wav_scan_chunk(WAV_FILE* wavf, uint32_t chunkID, void* header, void*
     }
     return false;
 }
-static bool wav_open(std::string_view fullPath, WAV_FILE* wavf)
+static bool wav_open(std::unique_ptr<IFileStream> stream, WAV_FILE* wavf)
 {
-    wavf->Stream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+    wavf->Stream = std::move(stream);
     if (!wavf->Stream)
         return false;
 
@@ -194,7 +194,7 @@ AudioDecoderWav::~AudioDecoderWav()
 
 bool AudioDecoderWav::open(std::string_view fullPath)
 {
-    if (wav_open(fullPath, &_wavf))
+    if (wav_open(openFileStream(fullPath), &_wavf))
     {
         auto& fmtInfo  = _wavf.FileHeader.Fmt;
         _sampleRate    = fmtInfo.SampleRate;
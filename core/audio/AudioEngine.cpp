@@ -249,7 +249,7 @@ AUDIO_ID AudioEngine::play2d(std::string_view filePath, const AudioPlayerSetting
             volume = 1.0f;
         }
 
-        ret = _audioEngineImpl->play2d(filePath, settings.loop, volume, settings.time);
+        ret = _audioEngineImpl->play2d(filePath, settings.loop, volume, settings.time, settings.priority);
         if (ret != INVALID_AUDIO_ID)
         {
             _audioPathIDMap[filePath.data()].emplace_back(ret);
@@ -608,6 +608,60 @@ int AudioEngine::getPlayingAudioCount()
     return static_cast<int>(_audioIDInfoMap.size());
 }
 
+bool AudioEngine::getStreamStats(AUDIO_ID audioID, AudioStreamStats& stats)
+{
+    if (_audioEngineImpl && _audioIDInfoMap.find(audioID) != _audioIDInfoMap.end())
+    {
+        return _audioEngineImpl->getStreamStats(audioID, stats);
+    }
+    return false;
+}
+
+void AudioEngine::setCacheBudget(size_t budget)
+{
+    if (lazyInit())
+    {
+        _audioEngineImpl->setCacheBudget(budget);
+    }
+}
+
+size_t AudioEngine::getCacheBudget()
+{
+    return _audioEngineImpl ? _audioEngineImpl->getCacheBudget() : 0;
+}
+
+AudioCacheStats AudioEngine::getCacheStats()
+{
+    AudioCacheStats stats;
+    if (_audioEngineImpl)
+    {
+        _audioEngineImpl->getCacheStats(stats);
+    }
+    return stats;
+}
+
+void AudioEngine::setMixerEnabled(bool enabled, unsigned int maxVoices)
+{
+    if (!lazyInit() || _audioEngineImpl->isMixerEnabled() == enabled)
+    {
+        return;
+    }
+
+    // the cached audio data of the mixer isn't playable by OpenAL sources and vice versa
+    uncacheAll();
+    _audioEngineImpl->setMixerEnabled(enabled, maxVoices);
+}
+
+bool AudioEngine::isMixerEnabled()
+{
+    return _audioEngineImpl && _audioEngineImpl->isMixerEnabled();
+}
+
+AudioMixer* AudioEngine::getMixer()
+{
+    return _audioEngineImpl ? _audioEngineImpl->getMixer() : nullptr;
+}
+
 void AudioEngine::setEnabled(bool isEnabled)
 {
     if (_isEnabled != isEnabled)
@@ -56,6 +56,7 @@ struct AX_DLL AudioPlayerSettings
     bool loop = false; // Whether audio instance loop or not.
     float volume = 1.0f; // Volume value (range from 0.0 to 1.0).
     float time = 0.0f; // The initial time offset when play audio
+    int priority = 0; // Voices with a lower priority are stolen first when the mixer runs out of voices.
 };
 
 /**
@@ -83,7 +84,46 @@ public:
     AudioProfile() : maxInstances(0), minDelay(0.0) {}
 };
 
+/**
+ * @struct AudioStreamStats
+ *
+ * @brief Statistics of an audio instance which is streamed from its file, see AudioEngine::getStreamStats.
+ * @js NA
+ */
+struct AudioStreamStats
+{
+    // Times the queued buffers ran dry before they were refilled.
+    unsigned int underruns = 0;
+    // The number of buffers decoded and queued.
+    unsigned int decodedBuffers = 0;
+    // Total time spent decoding buffers, in milliseconds.
+    float decodeTime = 0.0f;
+    // The longest time spent decoding a buffer, in milliseconds.
+    float maxDecodeTime = 0.0f;
+};
+
+/**
+ * @struct AudioCacheStats
+ *
+ * @brief Statistics of the decoded audio data cache, see AudioEngine::setCacheBudget.
+ * @js NA
+ */
+struct AudioCacheStats
+{
+    // Plays which found the audio data decoded.
+    unsigned int hits = 0;
+    // Plays which had to wait for the audio data to be decoded.
+    unsigned int misses = 0;
+    // Times decoded audio data was evicted to respect the budget.
+    unsigned int evictions = 0;
+    // Bytes of decoded audio data held by the cache.
+    size_t pcmSize = 0;
+    // Bytes of compressed audio files kept to decode evicted audio data again.
+    size_t encodedSize = 0;
+};
+
 class AudioEngineImpl;
+class AudioMixer;
 
 /**
  * @class AudioEngine
@@ -321,6 +361,55 @@ public:
      */
     static int getPlayingAudioCount();
 
+    /**
+     * Gets the streaming statistics of an audio instance.
+     * Long audio files are streamed while playing, all streams are refilled by one thread of the audio engine.
+     *
+     * @param audioID An audioID returned by the play2d function.
+     * @param stats Receives the statistics.
+     * @return False if the audio instance doesn't exist or isn't streamed.
+     */
+    static bool getStreamStats(AUDIO_ID audioID, AudioStreamStats& stats);
+
+    /**
+     * Sets the memory budget of decoded audio data.
+     * Once the decoded audio data exceeds the budget, the data of the least recently played audio files which aren't
+     * playing is released. Compressed audio files stay in memory and are decoded again asynchronously when played.
+     *
+     * @param budget The budget in bytes, 0 means no limit which is the default.
+     */
+    static void setCacheBudget(size_t budget);
+
+    /**
+     * Gets the memory budget of decoded audio data, see setCacheBudget.
+     */
+    static size_t getCacheBudget();
+
+    /**
+     * Gets the statistics of the decoded audio data cache.
+     */
+    static AudioCacheStats getCacheStats();
+
+    /**
+     * Enables the software mixer.
+     * Audio files decoded into memory are mixed by the engine and streamed through a single OpenAL source, so their
+     * plays no longer fail when the OpenAL sources run out. When all voices are in use, the voice with the lowest
+     * priority is stolen, see AudioPlayerSettings::priority. Long audio files are still streamed by their own source.
+     *
+     * @param enabled Whether to mix audio files in software.
+     * @param maxVoices The maximum number of voices mixed at the same time.
+     * @note All audio is stopped and uncached when the mode changes.
+     */
+    static void setMixerEnabled(bool enabled, unsigned int maxVoices = MIXER_DEFAULT_VOICES);
+
+    static bool isMixerEnabled();
+
+    /**
+     * Gets the software mixer, e.g. to set its master volume or query its statistics.
+     * @return nullptr if the mixer was never enabled.
+     */
+    static AudioMixer* getMixer();
+
     /**
      * Whether to enable playing audios
      * @note If it's disabled, current playing audios will be stopped and the later 'preload', 'play2d' methods will
@@ -39,6 +39,9 @@
 #include "base/Director.h"
 #include "base/Scheduler.h"
 #include "base/Utils.h"
+#include "base/FrameProfiler.h"
+#include "base/Data.h"
+#include <algorithm>
 
 #if AX_USE_ALSOFT
 #    include "alc/inprogext.h"
@@ -308,29 +311,39 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
     if (notificationID != AL_BUFFERS_PROCESSED)
         return;
 
-    AudioPlayer* player = nullptr;
-    s_instance->_threadMutex.lock();
-    for (const auto& e : s_instance->_audioPlayers)
-    {
-        player = e.second;
-        if (player->_alSource == sid && player->_streamingSource)
-        {
-            player->wakeupRotateThread();
-        }
-    }
-    s_instance->_threadMutex.unlock();
+    s_instance->wakeupStreamThread();
 }
 #endif
 
 NS_AX_BEGIN
 
-AudioEngineImpl::AudioEngineImpl() : _scheduled(false), _currentAudioID(0), _scheduler(nullptr)
+AudioEngineImpl::AudioEngineImpl()
+    : _streamWakeup(false)
+    , _streamExit(false)
+    , _cacheBudget(0)
+    , _cacheClock(0)
+    , _mixerEnabled(false)
+    , _mixerSource(INVALID_AL_SOURCE_ID)
+    , _mixerBufferFrames(0)
+    , _scheduled(false)
+    , _currentAudioID(0)
+    , _scheduler(nullptr)
 {
     s_instance = this;
 }
 
 AudioEngineImpl::~AudioEngineImpl()
 {
+    {
+        std::lock_guard<std::mutex> lck(_streamMutex);
+        _streamExit = true;
+    }
+    _streamCondition.notify_one();
+    if (_streamThread.joinable())
+    {
+        _streamThread.join();
+    }
+
     if (_scheduled && _scheduler != nullptr)
     {
         _scheduler->unschedule(AX_SCHEDULE_SELECTOR(AudioEngineImpl::update), this);
@@ -339,6 +352,10 @@ AudioEngineImpl::~AudioEngineImpl()
     if (s_ALContext)
     {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
+        if (_mixer)
+        {
+            alDeleteBuffers(MIXER_BUFFER_NUM, _mixerBuffers);
+        }
 
         _audioCaches.clear();
 
@@ -504,21 +521,16 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
         audioCache = new AudioCache();  // hlookup_second(it);
         _audioCaches.emplace(filePath, std::unique_ptr<AudioCache>(audioCache));
         audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-        unsigned int cacheId      = audioCache->_id;
-        auto isCacheDestroyed     = audioCache->_isDestroyed;
-        AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
-            if (*isCacheDestroyed)
-            {
-                ALOGV("AudioCache (id=%u) was destroyed, no need to launch readDataTask.", cacheId);
-                audioCache->setSkipReadDataTask(true);
-                return;
-            }
-            audioCache->readDataTask(cacheId);
-        });
+        _loadCache(audioCache);
     }
     else
     {
         audioCache = it->second.get();
+        if (audioCache->_state == AudioCache::State::INITIAL && audioCache->_isLoadingFinished)
+        {
+            // the pcm data was evicted, decode it again
+            _loadCache(audioCache);
+        }
     }
 
     if (audioCache && callback)
@@ -528,17 +540,24 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     return audioCache;
 }
 
-AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time)
+AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time, int priority)
 {
     if (s_ALDevice == nullptr)
     {
         return AudioEngine::INVALID_AUDIO_ID;
     }
 
-    ALuint alSource = findValidSource();
-    if (alSource == AL_INVALID)
+    // with the mixer enabled, the source is found once the audio turns out to be streamed, see _play2d
+    ALuint alSource = INVALID_AL_SOURCE_ID;
+    if (!_mixerEnabled)
     {
-        return AudioEngine::INVALID_AUDIO_ID;
+        _threadMutex.lock();
+        alSource = findValidSource();
+        _threadMutex.unlock();
+        if (alSource == INVALID_AL_SOURCE_ID)
+        {
+            return AudioEngine::INVALID_AUDIO_ID;
+        }
     }
 
     auto player = new AudioPlayer;
@@ -550,18 +569,26 @@ AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float vol
     player->_alSource = alSource;
     player->_loop     = loop;
     player->_volume   = volume;
+    player->_priority = priority;
     if (time > 0.0f)
     {
         player->_currTime  = time;
         player->_timeDirty = true;
     }
 
+    auto cacheIter = _audioCaches.find(filePath);
+    if (cacheIter != _audioCaches.end() && cacheIter->second->_state == AudioCache::State::READY)
+        ++_cacheStats.hits;
+    else
+        ++_cacheStats.misses;
+
     auto audioCache = preload(filePath, nullptr);
     if (audioCache == nullptr)
     {
         delete player;
         return AudioEngine::INVALID_AUDIO_ID;
     }
+    audioCache->_lastPlayed = ++_cacheClock;
 
     player->setCache(audioCache);
     _threadMutex.lock();
@@ -590,8 +617,29 @@ void AudioEngineImpl::_play2d(AudioCache* cache, AUDIO_ID audioID)
     // Note: It maybe in sub thread or main thread :(
     if (!*cache->_isDestroyed && cache->_state == AudioCache::State::READY)
     {
+        if (cache->_mixerClip && _mixer)
+        {
+            _playVoice(player, cache, audioID);
+            return;
+        }
+
+        if (player->_alSource == INVALID_AL_SOURCE_ID)
+        {
+            player->_alSource = findValidSource();
+            if (player->_alSource == INVALID_AL_SOURCE_ID)
+            {
+                ALOGD("AudioEngineImpl::_play2d, no source left for the stream!");
+                player->_removeByAudioEngine = true;
+                return;
+            }
+        }
+
         if (player->play2d())
         {
+            if (player->_streamingSource)
+            {
+                _addStreamingPlayer(player);
+            }
             _scheduler->runOnAxmolThread([audioID]() {
                 if (AudioEngine::_audioIDInfoMap.find(audioID) != AudioEngine::_audioIDInfoMap.end())
                 {
@@ -607,9 +655,150 @@ void AudioEngineImpl::_play2d(AudioCache* cache, AUDIO_ID audioID)
     }
 }
 
+void AudioEngineImpl::_playVoice(AudioPlayer* player, AudioCache* cache, AUDIO_ID audioID)
+{
+    if (player->_isDestroyed)
+        return;
+
+    AudioMixer::VoiceSettings settings;
+    settings.volume   = player->_volume;
+    settings.loop     = player->_loop;
+    settings.time     = player->_currTime;
+    settings.priority = player->_priority;
+
+    player->_mixerVoice = _mixer->play(cache->_mixerClip, settings);
+    if (player->_mixerVoice == AudioMixer::INVALID_VOICE)
+    {
+        ALOGD("AudioEngineImpl::_playVoice, no voice left for audio id=" AUDIO_ID_PRID, audioID);
+        player->_removeByAudioEngine = true;
+        return;
+    }
+    player->_ready = true;
+
+    wakeupStreamThread();
+    _scheduler->runOnAxmolThread([audioID]() {
+        if (AudioEngine::_audioIDInfoMap.find(audioID) != AudioEngine::_audioIDInfoMap.end())
+        {
+            AudioEngine::_audioIDInfoMap[audioID].state = AudioEngine::AudioState::PLAYING;
+        }
+    });
+}
+
+bool AudioEngineImpl::_isPlayerFinished(AudioPlayer* player) const
+{
+    if (player->_mixerVoice != AudioMixer::INVALID_VOICE)
+        return !_mixer->isPlaying(player->_mixerVoice);
+    return player->isFinished();
+}
+
+void AudioEngineImpl::setMixerEnabled(bool enabled, unsigned int maxVoices)
+{
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+    _mixerEnabled = enabled;
+
+    // once created, the mixer keeps its source until the engine is destroyed
+    if (!enabled)
+        return;
+    if (_mixer)
+    {
+        _mixer->setMaxVoices(maxVoices);
+        return;
+    }
+
+    _mixerSource = findValidSource();
+    if (_mixerSource == INVALID_AL_SOURCE_ID)
+    {
+        ALOGE("%s: no source left for the mixer!", __FUNCTION__);
+        _mixerEnabled = false;
+        return;
+    }
+
+    alGenBuffers(MIXER_BUFFER_NUM, _mixerBuffers);
+    auto alError = alGetError();
+    if (alError != AL_NO_ERROR)
+    {
+        ALOGE("%s: generating mixer buffers failed! error = %x", __FUNCTION__, alError);
+        _unusedSourcesPool.push(_mixerSource);
+        _mixerSource  = INVALID_AL_SOURCE_ID;
+        _mixerEnabled = false;
+        return;
+    }
+
+    // mix at the rate of the device to avoid resampling twice
+    ALCint frequency = 0;
+    alcGetIntegerv(s_ALDevice, ALC_FREQUENCY, 1, &frequency);
+    if (frequency <= 0)
+        frequency = 44100;
+
+    _mixerBufferFrames = static_cast<uint32_t>(frequency * MIXER_BUFFER_TIME_STEP);
+    _mixerPcm.resize(_mixerBufferFrames * 2);
+    _mixerFreeBuffers.assign(_mixerBuffers, _mixerBuffers + MIXER_BUFFER_NUM);
+
+    alSourcef(_mixerSource, AL_PITCH, 1.0f);
+    alSourcef(_mixerSource, AL_GAIN, 1.0f);
+    alSourcei(_mixerSource, AL_LOOPING, AL_FALSE);
+    CHECK_AL_ERROR_DEBUG();
+
+    {
+        std::lock_guard<std::mutex> streamLck(_streamMutex);
+        _mixer = std::make_unique<AudioMixer>(static_cast<uint32_t>(frequency), maxVoices);
+    }
+    if (!_streamThread.joinable())
+    {
+        _streamThread = std::thread(&AudioEngineImpl::_updateStreams, this);
+    }
+}
+
+bool AudioEngineImpl::_updateMixer(AudioMixer* mixer, float& minHeadroom)
+{
+    ALint processed = 0;
+    alGetSourcei(_mixerSource, AL_BUFFERS_PROCESSED, &processed);
+    while (processed-- > 0)
+    {
+        ALuint bufferId = 0;
+        alSourceUnqueueBuffers(_mixerSource, 1, &bufferId);
+        _mixerFreeBuffers.emplace_back(bufferId);
+    }
+
+    // without voices the queue runs dry, the thread sleeps until the next voice wakes it up
+    const bool hasVoices = mixer->getVoiceCount() > 0;
+    if (hasVoices)
+    {
+        while (!_mixerFreeBuffers.empty())
+        {
+            auto bufferId = _mixerFreeBuffers.back();
+            _mixerFreeBuffers.pop_back();
+
+            mixer->mix(_mixerPcm.data(), _mixerBufferFrames);
+            alBufferData(bufferId, AL_FORMAT_STEREO16, _mixerPcm.data(),
+                         static_cast<ALsizei>(_mixerPcm.size() * sizeof(int16_t)),
+                         static_cast<ALsizei>(mixer->getSampleRate()));
+            alSourceQueueBuffers(_mixerSource, 1, &bufferId);
+        }
+
+        ALint state = AL_STOPPED;
+        alGetSourcei(_mixerSource, AL_SOURCE_STATE, &state);
+        if (state != AL_PLAYING)
+        {
+            alSourcePlay(_mixerSource);
+        }
+        CHECK_AL_ERROR_DEBUG();
+    }
+
+    ALint queued = 0, offset = 0;
+    alGetSourcei(_mixerSource, AL_BUFFERS_QUEUED, &queued);
+    if (queued == 0)
+        return hasVoices;
+
+    alGetSourcei(_mixerSource, AL_SAMPLE_OFFSET, &offset);
+    const float headroom = static_cast<float>(queued * _mixerBufferFrames - offset) / mixer->getSampleRate();
+    minHeadroom          = std::min(minHeadroom, headroom);
+    return true;
+}
+
 ALuint AudioEngineImpl::findValidSource()
 {
-    ALuint sourceId = AL_INVALID;
+    ALuint sourceId = INVALID_AL_SOURCE_ID;
     if (!_unusedSourcesPool.empty())
     {
         sourceId = _unusedSourcesPool.front();
@@ -631,7 +820,11 @@ void AudioEngineImpl::setVolume(AUDIO_ID audioID, float volume)
 
     player->_volume = volume;
 
-    if (player->_ready)
+    if (player->_ready && player->_mixerVoice != AudioMixer::INVALID_VOICE)
+    {
+        _mixer->setVolume(player->_mixerVoice, volume);
+    }
+    else if (player->_ready)
     {
         alSourcef(player->_alSource, AL_GAIN, volume);
 
@@ -656,7 +849,12 @@ void AudioEngineImpl::setLoop(AUDIO_ID audioID, bool loop)
 
     if (player->_ready)
     {
-        if (player->_streamingSource)
+        if (player->_mixerVoice != AudioMixer::INVALID_VOICE)
+        {
+            player->setLoop(loop);
+            _mixer->setLoop(player->_mixerVoice, loop);
+        }
+        else if (player->_streamingSource)
         {
             player->setLoop(loop);
         }
@@ -696,6 +894,12 @@ bool AudioEngineImpl::pause(AUDIO_ID audioID)
     lck.unlock();
 
     bool ret = true;
+    if (player->_mixerVoice != AudioMixer::INVALID_VOICE)
+    {
+        _mixer->setPaused(player->_mixerVoice, true);
+        return ret;
+    }
+
     alSourcePause(player->_alSource);
 
     auto error = alGetError();
@@ -719,6 +923,12 @@ bool AudioEngineImpl::resume(AUDIO_ID audioID)
     auto player = iter->second;
     lck.unlock();
 
+    if (player->_mixerVoice != AudioMixer::INVALID_VOICE)
+    {
+        _mixer->setPaused(player->_mixerVoice, false);
+        return ret;
+    }
+
     alSourcePlay(player->_alSource);
 
     auto error = alGetError();
@@ -739,6 +949,10 @@ void AudioEngineImpl::stop(AUDIO_ID audioID)
         return;
 
     auto player = iter->second;
+    if (player->_mixerVoice != AudioMixer::INVALID_VOICE)
+    {
+        _mixer->stop(player->_mixerVoice);
+    }
     player->destroy();
 
     // Call '_updatePlayersState' method to cleanup immediately since the schedule may be cancelled without any
@@ -751,6 +965,10 @@ void AudioEngineImpl::stopAll()
     std::lock_guard<std::recursive_mutex> lck(_threadMutex);
     for (auto&& player : _audioPlayers)
     {
+        if (player.second->_mixerVoice != AudioMixer::INVALID_VOICE)
+        {
+            _mixer->stop(player.second->_mixerVoice);
+        }
         player.second->destroy();
     }
     // Note: Don't set the flag to false here, it should be set in 'update' function.
@@ -790,7 +1008,11 @@ float AudioEngineImpl::getCurrentTime(AUDIO_ID audioID)
     auto player = it->second;
     if (player->_ready)
     {
-        if (player->_streamingSource)
+        if (player->_mixerVoice != AudioMixer::INVALID_VOICE)
+        {
+            ret = _mixer->getTime(player->_mixerVoice);
+        }
+        else if (player->_streamingSource)
         {
             ret = player->getTime();
         }
@@ -826,6 +1048,12 @@ bool AudioEngineImpl::setCurrentTime(AUDIO_ID audioID, float time)
             break;
         }
 
+        if (player->_mixerVoice != AudioMixer::INVALID_VOICE)
+        {
+            ret = _mixer->setTime(player->_mixerVoice, time);
+            break;
+        }
+
         if (player->_streamingSource)
         {
             ret = player->setTime(time);
@@ -893,9 +1121,10 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
 
             it = _audioPlayers.erase(it);
             delete player;
-            _unusedSourcesPool.push(alSource);
+            if (alSource != INVALID_AL_SOURCE_ID)
+                _unusedSourcesPool.push(alSource);
         }
-        else if (player->_ready && player->isFinished())
+        else if (player->_ready && _isPlayerFinished(player))
         {
 
             std::string filePath;
@@ -921,7 +1150,8 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
             // clear cache when audio player finsihed properly
             player->setCache(nullptr);
             delete player;
-            _unusedSourcesPool.push(alSource);
+            if (alSource != INVALID_AL_SOURCE_ID)
+                _unusedSourcesPool.push(alSource);
         }
         else
         {
@@ -946,6 +1176,132 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
         _unscheduleUpdate();
 }
 
+void AudioEngineImpl::_addStreamingPlayer(AudioPlayer* player)
+{
+    player->_streamEngine = this;
+    {
+        std::lock_guard<std::mutex> lck(_streamMutex);
+        _streamingPlayers.emplace_back(player);
+        _streamWakeup = true;
+    }
+
+    // one thread refills all streams, instead of a thread per player
+    if (!_streamThread.joinable())
+    {
+        _streamThread = std::thread(&AudioEngineImpl::_updateStreams, this);
+    }
+    _streamCondition.notify_one();
+}
+
+void AudioEngineImpl::wakeupStreamThread()
+{
+    {
+        std::lock_guard<std::mutex> lck(_streamMutex);
+        _streamWakeup = true;
+    }
+    _streamCondition.notify_one();
+}
+
+void AudioEngineImpl::_updateStreams()
+{
+#if defined(__APPLE__)
+    pthread_setname_np("ALStreaming");
+#endif
+    AX_PROFILE_THREAD_NAME("ALStreaming");
+
+    std::vector<AudioPlayer*> players;
+    std::vector<std::pair<float, AudioPlayer*>> queue;
+    std::vector<AudioPlayer*> finished;
+    AudioMixer* mixer = nullptr;
+
+    std::unique_lock<std::mutex> lck(_streamMutex);
+    while (!_streamExit)
+    {
+        // players are only removed by this thread, so they stay valid while the lock is released
+        players = _streamingPlayers;
+        mixer   = _mixer.get();
+        lck.unlock();
+
+        // refill the queues closest to underrun first
+        queue.clear();
+        for (auto player : players)
+        {
+            queue.emplace_back(player->getStreamHeadroom(), player);
+        }
+        std::sort(queue.begin(), queue.end(),
+                  [](const std::pair<float, AudioPlayer*>& a, const std::pair<float, AudioPlayer*>& b) {
+            return a.first < b.first;
+        });
+
+        finished.clear();
+        float minHeadroom = QUEUEBUFFER_NUM * QUEUEBUFFER_TIME_STEP;
+        for (auto&& entry : queue)
+        {
+            AX_PROFILE_ZONE("AudioPlayer::updateStream");
+            auto player = entry.second;
+            if (player->updateStream())
+            {
+                minHeadroom = std::min(minHeadroom, player->getStreamHeadroom());
+            }
+            else
+            {
+                finished.emplace_back(player);
+            }
+        }
+
+        bool isMixing = false;
+        if (mixer != nullptr)
+        {
+            AX_PROFILE_ZONE("AudioMixer::mix");
+            isMixing = _updateMixer(mixer, minHeadroom);
+        }
+
+        lck.lock();
+        for (auto player : finished)
+        {
+            _streamingPlayers.erase(std::find(_streamingPlayers.begin(), _streamingPlayers.end(), player));
+            player->closeStream();
+        }
+
+        // wake up before the emptiest queue runs dry, at most every half buffer like the old per player threads
+        auto sleepTime = std::chrono::duration<float>(
+            std::clamp(minHeadroom / 2, 0.002f, QUEUEBUFFER_TIME_STEP / 2));
+        if (_streamingPlayers.empty() && !isMixing)
+        {
+            _streamCondition.wait(lck, [this] { return _streamExit || _streamWakeup; });
+        }
+        else
+        {
+            _streamCondition.wait_for(lck, sleepTime, [this] { return _streamExit || _streamWakeup; });
+        }
+        _streamWakeup = false;
+    }
+
+    // nothing refills the remaining streams anymore, let their players be destroyed
+    for (auto player : _streamingPlayers)
+    {
+        player->closeStream();
+    }
+    _streamingPlayers.clear();
+}
+
+bool AudioEngineImpl::getStreamStats(AUDIO_ID audioID, AudioStreamStats& stats)
+{
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+    auto iter = _audioPlayers.find(audioID);
+    if (iter == _audioPlayers.end() || !iter->second->_streamingSource)
+    {
+        return false;
+    }
+
+    auto player          = iter->second;
+    stats.underruns      = player->_underruns;
+    stats.decodedBuffers = player->_decodedBuffers;
+    stats.decodeTime     = player->_decodeTime;
+    stats.maxDecodeTime  = player->_maxDecodeTime;
+    return true;
+}
+
 void AudioEngineImpl::_unscheduleUpdate()
 {
     if (_scheduled)
@@ -955,6 +1311,100 @@ void AudioEngineImpl::_unscheduleUpdate()
     }
 }
 
+void AudioEngineImpl::_loadCache(AudioCache* audioCache)
+{
+    audioCache->_isLoadingFinished = false;
+    audioCache->_keepEncodedData   = _cacheBudget > 0;
+    audioCache->_decodeForMixer    = _mixerEnabled;
+    audioCache->_lastPlayed        = ++_cacheClock;
+
+    unsigned int cacheId  = audioCache->_id;
+    auto isCacheDestroyed = audioCache->_isDestroyed;
+    AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
+        if (*isCacheDestroyed)
+        {
+            ALOGV("AudioCache (id=%u) was destroyed, no need to launch readDataTask.", cacheId);
+            audioCache->setSkipReadDataTask(true);
+            return;
+        }
+        audioCache->readDataTask(cacheId);
+    });
+
+    // the load callbacks are invoked in cocos thread
+    audioCache->addLoadCallback([this](bool isSuccess) {
+        if (isSuccess)
+            _trimCaches();
+    });
+}
+
+void AudioEngineImpl::_trimCaches()
+{
+    if (_cacheBudget == 0)
+        return;
+
+    size_t pcmSize = 0;
+    for (auto&& item : _audioCaches)
+    {
+        if (item.second->_state == AudioCache::State::READY)
+            pcmSize += item.second->_pcmSize;
+    }
+    if (pcmSize <= _cacheBudget)
+        return;
+
+    // the buffers attached to sources can't be deleted
+    std::vector<AudioCache*> usedCaches;
+    _threadMutex.lock();
+    for (auto&& item : _audioPlayers)
+    {
+        if (item.second->_audioCache)
+            usedCaches.emplace_back(item.second->_audioCache);
+    }
+    _threadMutex.unlock();
+
+    while (pcmSize > _cacheBudget)
+    {
+        AudioCache* lruCache = nullptr;
+        for (auto&& item : _audioCaches)
+        {
+            auto cache = item.second.get();
+            if (cache->_state != AudioCache::State::READY || cache->_pcmSize == 0 ||
+                std::find(usedCaches.begin(), usedCaches.end(), cache) != usedCaches.end())
+                continue;
+            if (lruCache == nullptr || cache->_lastPlayed < lruCache->_lastPlayed)
+                lruCache = cache;
+        }
+        if (lruCache == nullptr)
+            break;
+
+        pcmSize -= lruCache->_pcmSize;
+        lruCache->evictPcmData();
+        ++_cacheStats.evictions;
+    }
+}
+
+void AudioEngineImpl::setCacheBudget(size_t budget)
+{
+    _cacheBudget = budget;
+    _trimCaches();
+}
+
+void AudioEngineImpl::getCacheStats(AudioCacheStats& stats)
+{
+    stats = _cacheStats;
+    stats.pcmSize     = 0;
+    stats.encodedSize = 0;
+    for (auto&& item : _audioCaches)
+    {
+        auto cache = item.second.get();
+        if (cache->_state != AudioCache::State::READY && !cache->_isLoadingFinished)
+            continue;
+        if (cache->_state == AudioCache::State::READY)
+            stats.pcmSize += cache->_pcmSize;
+        if (cache->_encodedData)
+            stats.encodedSize += cache->_encodedData->getSize();
+    }
+}
+
 void AudioEngineImpl::uncache(std::string_view filePath)
 {
     _audioCaches.erase(filePath);
@@ -31,10 +31,16 @@
 
 #    include <unordered_map>
 #    include <queue>
+#    include <condition_variable>
+#    include <mutex>
+#    include <thread>
+#    include <vector>
 
 #    include "base/Ref.h"
 #    include "audio/AudioMacros.h"
+#    include "audio/AudioEngine.h"
 #    include "audio/AudioCache.h"
+#    include "audio/AudioMixer.h"
 #    include "audio/AudioPlayer.h"
 
 NS_AX_BEGIN
@@ -48,7 +54,7 @@ public:
     ~AudioEngineImpl();
 
     bool init();
-    AUDIO_ID play2d(std::string_view fileFullPath, bool loop, float volume, float time);
+    AUDIO_ID play2d(std::string_view fileFullPath, bool loop, float volume, float time, int priority);
     void setVolume(AUDIO_ID audioID, float volume);
     void setLoop(AUDIO_ID audioID, bool loop);
     bool pause(AUDIO_ID audioID);
@@ -65,11 +71,33 @@ public:
     AudioCache* preload(std::string_view filePath, std::function<void(bool)> callback);
     void update(float dt);
 
+    // evicts the least recently played pcm data once the decoded clips exceed the budget, 0 means no limit
+    void setCacheBudget(size_t budget);
+    size_t getCacheBudget() const { return _cacheBudget; }
+    void getCacheStats(AudioCacheStats& stats);
+
+    void setMixerEnabled(bool enabled, unsigned int maxVoices);
+    bool isMixerEnabled() const { return _mixerEnabled; }
+    AudioMixer* getMixer() const { return _mixer.get(); }
+
+    bool getStreamStats(AUDIO_ID audioID, AudioStreamStats& stats);
+    // wakes the streaming thread, e.g. once a streaming player was destroyed or played a buffer
+    void wakeupStreamThread();
+
 private:
     // query players state per frame and dispatch finish callback if possible
     void _updatePlayers(bool forStop);
     void _play2d(AudioCache* cache, AUDIO_ID audioID);
     void _unscheduleUpdate();
+    void _loadCache(AudioCache* audioCache);
+    void _trimCaches();
+    void _addStreamingPlayer(AudioPlayer* player);
+    // the loop of the streaming thread, refills the queued buffers of all streaming players
+    void _updateStreams();
+    void _playVoice(AudioPlayer* player, AudioCache* cache, AUDIO_ID audioID);
+    bool _isPlayerFinished(AudioPlayer* player) const;
+    // refills the queue of the mixer source, returns false once it's idle
+    bool _updateMixer(AudioMixer* mixer, float& minHeadroom);
     ALuint findValidSource();
 #if defined(__APPLE__) && !AX_USE_ALSOFT
     static ALvoid myAlSourceNotificationCallback(ALuint sid, ALuint notificationID, ALvoid* userData);
@@ -89,6 +117,28 @@ private:
     // finish callbacks
     std::vector<std::function<void()>> _finishCallbacks;
 
+    // streaming players, removed by the streaming thread once their stream finished
+    std::thread _streamThread;
+    std::mutex _streamMutex;
+    std::condition_variable _streamCondition;
+    std::vector<AudioPlayer*> _streamingPlayers;
+    bool _streamWakeup;
+    bool _streamExit;
+
+    // pcm cache budget in bytes and the stamp of the latest played cache
+    size_t _cacheBudget;
+    uint64_t _cacheClock;
+    AudioCacheStats _cacheStats;
+
+    // software mixer, its source and buffers are only touched by the streaming thread once it's created
+    std::unique_ptr<AudioMixer> _mixer;
+    bool _mixerEnabled;
+    ALuint _mixerSource;
+    ALuint _mixerBuffers[MIXER_BUFFER_NUM];
+    std::vector<ALuint> _mixerFreeBuffers;
+    std::vector<int16_t> _mixerPcm;
+    uint32_t _mixerBufferFrames;
+
     bool _scheduled;
 
     AUDIO_ID _currentAudioID;
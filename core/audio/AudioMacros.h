@@ -33,6 +33,14 @@
 #define QUEUEBUFFER_NUM (3)
 #define QUEUEBUFFER_TIME_STEP (0.05f)
 
+// the output of the software mixer is queued in short buffers to keep the latency of sound effects low
+#define MIXER_BUFFER_NUM (4)
+#define MIXER_BUFFER_TIME_STEP (0.01f)
+#define MIXER_DEFAULT_VOICES (64)
+
+// source id of the players without an OpenAL source, AL_INVALID as an ALuint
+#define INVALID_AL_SOURCE_ID (0xFFFFFFFFu)
+
 #define QUOTEME_(x) #x
 #define QUOTEME(x) QUOTEME_(x)
 
@@ -0,0 +1,451 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "audio/AudioMixer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define AX_AUDIO_MIXER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define AX_AUDIO_MIXER_NEON
+#endif
+
+NS_AX_BEGIN
+
+namespace
+{
+// The kernels work on samples in the range of 16 bits pcm, the gain is applied while accumulating.
+
+// dst[i] += src[i] * gain
+void accumulatePcm16(float* dst, const int16_t* src, uint32_t samples, float gain)
+{
+    uint32_t i = 0;
+#if defined(AX_AUDIO_MIXER_SSE2)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 8 <= samples; i += 8)
+    {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+        __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16));
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(lo, g)));
+        _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(hi, g)));
+    }
+#elif defined(AX_AUDIO_MIXER_NEON)
+    for (; i + 8 <= samples; i += 8)
+    {
+        int16x8_t s    = vld1q_s16(src + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+        vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), lo, gain));
+        vst1q_f32(dst + i + 4, vmlaq_n_f32(vld1q_f32(dst + i + 4), hi, gain));
+    }
+#endif
+    for (; i < samples; ++i)
+        dst[i] += src[i] * gain;
+}
+
+// dst[2 * i] += src[i] * gain, dst[2 * i + 1] += src[i] * gain
+void accumulatePcm16Mono(float* dst, const int16_t* src, uint32_t frames, float gain)
+{
+    uint32_t i = 0;
+#if defined(AX_AUDIO_MIXER_SSE2)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= frames; i += 4)
+    {
+        __m128i s = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        __m128 v  = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16)), g);
+        float* d  = dst + i * 2;
+        _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), _mm_unpacklo_ps(v, v)));
+        _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), _mm_unpackhi_ps(v, v)));
+    }
+#elif defined(AX_AUDIO_MIXER_NEON)
+    for (; i + 4 <= frames; i += 4)
+    {
+        float32x4_t v    = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(src + i))), gain);
+        float32x4x2_t lr = vzipq_f32(v, v);
+        float* d         = dst + i * 2;
+        vst1q_f32(d, vaddq_f32(vld1q_f32(d), lr.val[0]));
+        vst1q_f32(d + 4, vaddq_f32(vld1q_f32(d + 4), lr.val[1]));
+    }
+#endif
+    for (; i < frames; ++i)
+    {
+        const float v = src[i] * gain;
+        dst[i * 2] += v;
+        dst[i * 2 + 1] += v;
+    }
+}
+
+// dst[i] += src[i] * gain
+void accumulateFloat(float* dst, const float* src, uint32_t samples, float gain)
+{
+    uint32_t i = 0;
+#if defined(AX_AUDIO_MIXER_SSE2)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= samples; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+#elif defined(AX_AUDIO_MIXER_NEON)
+    for (; i + 4 <= samples; i += 4)
+        vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), gain));
+#endif
+    for (; i < samples; ++i)
+        dst[i] += src[i] * gain;
+}
+
+#if defined(AX_AUDIO_MIXER_NEON)
+// rounds to nearest like the SSE2 and scalar paths, vcvtq_s32_f32 truncates
+inline int32x4_t roundToInt32(float32x4_t value)
+{
+#    if defined(__aarch64__) || defined(_M_ARM64)
+    return vcvtnq_s32_f32(value);
+#    else
+    // ARMv7 has no rounding conversion, add 0.5 with the sign of the value before truncating
+    const uint32x4_t sign  = vandq_u32(vreinterpretq_u32_f32(value), vdupq_n_u32(0x80000000u));
+    const float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vdupq_n_f32(0.5f)), sign));
+    return vcvtq_s32_f32(vaddq_f32(value, half));
+#    endif
+}
+#endif
+
+// saturates the mixed samples to 16 bits
+void convertToPcm16(int16_t* dst, const float* src, uint32_t samples)
+{
+    uint32_t i = 0;
+#if defined(AX_AUDIO_MIXER_SSE2)
+    const __m128 minValue = _mm_set1_ps(-32768.0f);
+    const __m128 maxValue = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= samples; i += 8)
+    {
+        __m128i a = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), minValue), maxValue));
+        __m128i b = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), minValue), maxValue));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(a, b));
+    }
+#elif defined(AX_AUDIO_MIXER_NEON)
+    for (; i + 8 <= samples; i += 8)
+    {
+        int16x4_t a = vqmovn_s32(roundToInt32(vld1q_f32(src + i)));
+        int16x4_t b = vqmovn_s32(roundToInt32(vld1q_f32(src + i + 4)));
+        vst1q_s16(dst + i, vcombine_s16(a, b));
+    }
+#endif
+    for (; i < samples; ++i)
+        dst[i] = static_cast<int16_t>(std::lrint(std::clamp(src[i], -32768.0f, 32767.0f)));
+}
+}  // namespace
+
+AudioMixer::AudioMixer(uint32_t sampleRate, unsigned int maxVoices)
+    : _voices(maxVoices)
+    , _sampleRate(sampleRate)
+    , _masterVolume(1.0f)
+    , _cullVolume(0.001f)
+    , _lastVoiceId(INVALID_VOICE)
+    , _serial(0)
+{}
+
+AudioMixer::VoiceId AudioMixer::play(std::shared_ptr<const Clip> clip, const VoiceSettings& settings)
+{
+    if (!clip || clip->channelCount < 1 || clip->channelCount > 2 || clip->sampleRate == 0 || clip->samples.empty())
+        return INVALID_VOICE;
+
+    std::lock_guard<std::mutex> lk(_mutex);
+
+    Voice* target = nullptr;
+    for (auto&& voice : _voices)
+    {
+        if (voice.id == INVALID_VOICE)
+        {
+            target = &voice;
+            break;
+        }
+    }
+
+    if (target == nullptr)
+    {
+        for (auto&& voice : _voices)
+        {
+            if (target == nullptr || voice.priority < target->priority ||
+                (voice.priority == target->priority &&
+                 (voice.volume < target->volume || (voice.volume == target->volume && voice.serial < target->serial))))
+                target = &voice;
+        }
+        if (target == nullptr || target->priority > settings.priority)
+        {
+            ++_stats.rejectedVoices;
+            return INVALID_VOICE;
+        }
+        ++_stats.stolenVoices;
+    }
+
+    if (++_lastVoiceId < 0)
+        _lastVoiceId = 0;
+
+    const double position = std::floor(settings.time * clip->sampleRate);
+
+    target->id       = _lastVoiceId;
+    target->position = position >= 0.0 && position < clip->getFrameCount() ? position : 0.0;
+    target->step     = static_cast<double>(clip->sampleRate) / _sampleRate;
+    target->volume   = settings.volume;
+    target->priority = settings.priority;
+    target->serial   = ++_serial;
+    target->loop     = settings.loop;
+    target->paused   = false;
+    target->clip     = std::move(clip);
+    return target->id;
+}
+
+AudioMixer::Voice* AudioMixer::findVoice(VoiceId voice)
+{
+    if (voice == INVALID_VOICE)
+        return nullptr;
+    auto it = std::find_if(_voices.begin(), _voices.end(), [voice](const Voice& v) { return v.id == voice; });
+    return it != _voices.end() ? &*it : nullptr;
+}
+
+const AudioMixer::Voice* AudioMixer::findVoice(VoiceId voice) const
+{
+    return const_cast<AudioMixer*>(this)->findVoice(voice);
+}
+
+void AudioMixer::stop(VoiceId voice)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    if (auto v = findVoice(voice))
+    {
+        v->id = INVALID_VOICE;
+        v->clip.reset();
+    }
+}
+
+void AudioMixer::stopAll()
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    for (auto&& voice : _voices)
+    {
+        voice.id = INVALID_VOICE;
+        voice.clip.reset();
+    }
+}
+
+bool AudioMixer::isPlaying(VoiceId voice) const
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    return findVoice(voice) != nullptr;
+}
+
+void AudioMixer::setPaused(VoiceId voice, bool paused)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    if (auto v = findVoice(voice))
+        v->paused = paused;
+}
+
+void AudioMixer::setVolume(VoiceId voice, float volume)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    if (auto v = findVoice(voice))
+        v->volume = volume;
+}
+
+void AudioMixer::setLoop(VoiceId voice, bool loop)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    if (auto v = findVoice(voice))
+        v->loop = loop;
+}
+
+void AudioMixer::setPriority(VoiceId voice, int priority)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    if (auto v = findVoice(voice))
+        v->priority = priority;
+}
+
+float AudioMixer::getTime(VoiceId voice) const
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    auto v = findVoice(voice);
+    return v ? static_cast<float>(v->position / v->clip->sampleRate) : 0.0f;
+}
+
+bool AudioMixer::setTime(VoiceId voice, float time)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    auto v = findVoice(voice);
+    if (v == nullptr || time < 0.0f)
+        return false;
+
+    const double position = std::floor(time * v->clip->sampleRate);
+    if (position >= v->clip->getFrameCount())
+        return false;
+    v->position = position;
+    return true;
+}
+
+void AudioMixer::setMasterVolume(float volume)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    _masterVolume = volume;
+}
+
+void AudioMixer::setCullVolume(float volume)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    _cullVolume = volume;
+}
+
+void AudioMixer::setMaxVoices(unsigned int maxVoices)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    _voices.resize(maxVoices);
+}
+
+unsigned int AudioMixer::getVoiceCount() const
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    return static_cast<unsigned int>(std::count_if(_voices.begin(), _voices.end(),
+                                                   [](const Voice& v) { return v.id != INVALID_VOICE; }));
+}
+
+AudioMixer::Stats AudioMixer::getStats() const
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    return _stats;
+}
+
+void AudioMixer::mix(int16_t* output, uint32_t frames)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+
+    _mixBuffer.assign(frames * 2, 0.0f);
+    _resampleBuffer.resize(frames * 2);
+    _stats.mixedVoices  = 0;
+    _stats.culledVoices = 0;
+
+    for (auto&& voice : _voices)
+    {
+        if (voice.id == INVALID_VOICE || voice.paused)
+            continue;
+
+        bool playing;
+        const float gain = voice.volume * _masterVolume;
+        if (gain < _cullVolume)
+        {
+            playing = skipVoice(voice, frames);
+            ++_stats.culledVoices;
+        }
+        else
+        {
+            playing = mixVoice(voice, gain, frames);
+            ++_stats.mixedVoices;
+        }
+
+        if (!playing)
+        {
+            voice.id = INVALID_VOICE;
+            voice.clip.reset();
+        }
+    }
+
+    convertToPcm16(output, _mixBuffer.data(), frames * 2);
+}
+
+bool AudioMixer::mixVoice(Voice& voice, float gain, uint32_t frames)
+{
+    const Clip& clip            = *voice.clip;
+    const uint32_t clipFrames   = clip.getFrameCount();
+    const uint32_t channelCount = clip.channelCount;
+    const int16_t* samples      = clip.samples.data();
+    float* output               = _mixBuffer.data();
+
+    uint32_t mixed = 0;
+    while (mixed < frames)
+    {
+        if (voice.position >= clipFrames)
+        {
+            if (!voice.loop)
+                return false;
+            voice.position = std::fmod(voice.position, clipFrames);
+        }
+
+        uint32_t count = frames - mixed;
+        if (voice.step == 1.0)
+        {
+            // same sample rate, mix the samples directly
+            const auto first = static_cast<uint32_t>(voice.position);
+            count            = (std::min)(count, clipFrames - first);
+            if (channelCount == 2)
+                accumulatePcm16(output + mixed * 2, samples + first * 2, count * 2, gain);
+            else
+                accumulatePcm16Mono(output + mixed * 2, samples + first, count, gain);
+            voice.position += count;
+        }
+        else
+        {
+            // linear resampling to the stereo scratch buffer, then mix it like the other voices
+            const auto available =
+                static_cast<uint32_t>(std::ceil((clipFrames - voice.position) / voice.step));
+            count = (std::min)(count, (std::max)(available, 1u));
+
+            float* resampled = _resampleBuffer.data();
+            double position  = voice.position;
+            for (uint32_t i = 0; i < count; ++i, position += voice.step)
+            {
+                const auto index  = (std::min)(static_cast<uint32_t>(position), clipFrames - 1);
+                const auto next   = index + 1 < clipFrames ? index + 1 : (voice.loop ? 0 : index);
+                const float frac  = static_cast<float>(position - index);
+                const int16_t* s0 = samples + index * channelCount;
+                const int16_t* s1 = samples + next * channelCount;
+
+                resampled[i * 2]     = s0[0] + (s1[0] - s0[0]) * frac;
+                resampled[i * 2 + 1] = channelCount == 2 ? s0[1] + (s1[1] - s0[1]) * frac : resampled[i * 2];
+            }
+            accumulateFloat(output + mixed * 2, resampled, count * 2, gain);
+            voice.position = position;
+        }
+        mixed += count;
+    }
+
+    return voice.loop || voice.position < clipFrames;
+}
+
+bool AudioMixer::skipVoice(Voice& voice, uint32_t frames)
+{
+    const uint32_t clipFrames = voice.clip->getFrameCount();
+
+    voice.position += frames * voice.step;
+    if (voice.position >= clipFrames)
+    {
+        if (!voice.loop)
+            return false;
+        voice.position = std::fmod(voice.position, clipFrames);
+    }
+    return true;
+}
+
+NS_AX_END
@@ -0,0 +1,166 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "platform/PlatformConfig.h"
+#include "platform/PlatformMacros.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+NS_AX_BEGIN
+
+/**
+ * @brief Mixes many logical voices of 16 bits pcm clips into one stereo 16 bits stream.
+ *
+ * The mixer doesn't depend on OpenAL, AudioEngine streams its output through a single source when the mixer mode is
+ * enabled, see AudioEngine::setMixerEnabled. All methods are thread safe.
+ */
+class AX_DLL AudioMixer
+{
+public:
+    using VoiceId = int;
+
+    static const VoiceId INVALID_VOICE = -1;
+
+    /** Decoded 16 bits pcm data with 1 or 2 interleaved channels, shared by all voices playing it. */
+    struct Clip
+    {
+        std::vector<int16_t> samples;
+        uint32_t channelCount = 1;
+        uint32_t sampleRate   = 44100;
+
+        uint32_t getFrameCount() const { return static_cast<uint32_t>(samples.size() / channelCount); }
+    };
+
+    struct VoiceSettings
+    {
+        float volume = 1.0f;
+        bool loop    = false;
+        // the initial time offset in seconds
+        float time = 0.0f;
+        // voices with a lower priority are stolen first once all voices are in use
+        int priority = 0;
+    };
+
+    struct Stats
+    {
+        // voices mixed by the last mix call
+        unsigned int mixedVoices = 0;
+        // voices skipped by the last mix call since they are inaudible
+        unsigned int culledVoices = 0;
+        // voices stopped to play voices of a higher or same priority
+        unsigned int stolenVoices = 0;
+        // plays rejected because all voices have a higher priority
+        unsigned int rejectedVoices = 0;
+    };
+
+    /**
+     * @param sampleRate The sample rate of the mixed stream.
+     * @param maxVoices The maximum number of voices playing at the same time.
+     */
+    AudioMixer(uint32_t sampleRate, unsigned int maxVoices);
+
+    /**
+     * Starts a voice playing the clip.
+     * When all voices are in use, the voice with the lowest priority, then the lowest volume, then the oldest one is
+     * stolen if its priority isn't higher than the new one.
+     *
+     * @return The id of the voice, INVALID_VOICE if no voice could be stolen.
+     */
+    VoiceId play(std::shared_ptr<const Clip> clip, const VoiceSettings& settings);
+
+    void stop(VoiceId voice);
+    void stopAll();
+
+    /** Whether the voice is playing or paused, false once it finished, was stopped or stolen. */
+    bool isPlaying(VoiceId voice) const;
+
+    void setPaused(VoiceId voice, bool paused);
+    void setVolume(VoiceId voice, float volume);
+    void setLoop(VoiceId voice, bool loop);
+    void setPriority(VoiceId voice, int priority);
+    float getTime(VoiceId voice) const;
+    bool setTime(VoiceId voice, float time);
+
+    /** Voices whose volume multiplied by the master volume is below the cull volume advance without being mixed. */
+    void setMasterVolume(float volume);
+    void setCullVolume(float volume);
+
+    /** Sets the maximum number of voices, the voices beyond the limit are stopped. */
+    void setMaxVoices(unsigned int maxVoices);
+
+    /** Gets the number of playing or paused voices. */
+    unsigned int getVoiceCount() const;
+
+    uint32_t getSampleRate() const { return _sampleRate; }
+
+    Stats getStats() const;
+
+    /**
+     * Mixes the playing voices.
+     * @param output Receives |frames| interleaved stereo frames.
+     */
+    void mix(int16_t* output, uint32_t frames);
+
+private:
+    struct Voice
+    {
+        std::shared_ptr<const Clip> clip;
+        VoiceId id = INVALID_VOICE;
+        // position in frames of the clip
+        double position = 0.0;
+        // clip frames per mixed frame
+        double step     = 1.0;
+        float volume    = 1.0f;
+        int priority    = 0;
+        uint64_t serial = 0;
+        bool loop       = false;
+        bool paused     = false;
+    };
+
+    Voice* findVoice(VoiceId voice);
+    const Voice* findVoice(VoiceId voice) const;
+
+    // mixes a voice into _mixBuffer, returns false once it finished
+    bool mixVoice(Voice& voice, float gain, uint32_t frames);
+    // advances an inaudible voice, returns false once it finished
+    bool skipVoice(Voice& voice, uint32_t frames);
+
+    mutable std::mutex _mutex;
+    std::vector<Voice> _voices;
+    std::vector<float> _mixBuffer;
+    std::vector<float> _resampleBuffer;
+    uint32_t _sampleRate;
+    float _masterVolume;
+    float _cullVolume;
+    VoiceId _lastVoiceId;
+    uint64_t _serial;
+    Stats _stats;
+};
+
+NS_AX_END
@@ -29,6 +29,7 @@
 #include "platform/PlatformConfig.h"
 #include "audio/AudioPlayer.h"
 #include "audio/AudioCache.h"
+#include "audio/AudioEngineImpl.h"
 #include "platform/FileUtils.h"
 #include "audio/AudioDecoder.h"
 #include "audio/AudioDecoderManager.h"
@@ -55,14 +56,21 @@ AudioPlayer::AudioPlayer()
     , _isDestroyed(false)
     , _removeByAudioEngine(false)
     , _ready(false)
+    , _alSource(INVALID_AL_SOURCE_ID)
+    , _priority(0)
+    , _mixerVoice(AudioMixer::INVALID_VOICE)
     , _currTime(0.0f)
     , _streamingSource(false)
-    , _rotateBufferThread(nullptr)
+    , _streamEngine(nullptr)
+    , _streamDecoder(nullptr)
+    , _streamBuffer(nullptr)
+    , _streamOffsetFrame(0)
     , _timeDirty(false)
-    , _isRotateThreadExited(false)
-#if defined(__APPLE__)
-    , _needWakeupRotateThread(false)
-#endif
+    , _isStreamClosed(false)
+    , _underruns(0)
+    , _decodedBuffers(0)
+    , _decodeTime(0.0f)
+    , _maxDecodeTime(0.0f)
     , _id(++__playerIdIndex)
 {
     memset(_bufferIds, 0, sizeof(_bufferIds));
@@ -107,22 +115,15 @@ void AudioPlayer::destroy()
 
         if (_streamingSource)
         {
-            if (_rotateBufferThread != nullptr)
+            if (_streamEngine != nullptr)
             {
-                while (!_isRotateThreadExited)
+                // the streaming thread closes the stream once it sees _isDestroyed
+                while (!_isStreamClosed)
                 {
-                    _sleepCondition.notify_one();
+                    _streamEngine->wakeupStreamThread();
                     std::this_thread::sleep_for(std::chrono::milliseconds(5));
                 }
-
-                if (_rotateBufferThread->joinable())
-                {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                ALOGVV("rotateBufferThread exited!");
+                ALOGVV("stream closed!");
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS
                 // some specific OpenAL implement defects existed on iOS platform
@@ -147,12 +148,15 @@ void AudioPlayer::destroy()
         }
     } while (false);
 
-    ALOGVV("Before alSourceStop");
-    alSourceStop(_alSource);
-    CHECK_AL_ERROR_DEBUG();
-    ALOGVV("Before alSourcei");
-    alSourcei(_alSource, AL_BUFFER, 0);
-    CHECK_AL_ERROR_DEBUG();
+    if (_alSource != INVALID_AL_SOURCE_ID)
+    {
+        ALOGVV("Before alSourceStop");
+        alSourceStop(_alSource);
+        CHECK_AL_ERROR_DEBUG();
+        ALOGVV("Before alSourcei");
+        alSourcei(_alSource, AL_BUFFER, 0);
+        CHECK_AL_ERROR_DEBUG();
+    }
 
     _removeByAudioEngine = true;
 
@@ -225,17 +229,16 @@ bool AudioPlayer::play2d()
         }
 
         {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
             if (_isDestroyed)
                 break;
 
             if (_streamingSource)
             {
                 // To continuously stream audio from a source without interruption, buffer queuing is required.
+                // The buffers are refilled by the streaming thread of AudioEngineImpl, see AudioEngineImpl::_play2d.
                 alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
                 CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = new std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                      _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
+                _streamOffsetFrame = _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1;
             }
             else
             {
@@ -281,161 +284,160 @@ bool AudioPlayer::play2d()
     return ret;
 }
 
-// rotateBufferThread is used to rotate alBufferData for _alSource when playing big audio file
-void AudioPlayer::rotateBufferThread(int offsetFrame)
+float AudioPlayer::getStreamHeadroom() const
 {
-#if defined(__APPLE__)
-    pthread_setname_np("ALStreaming");
-#endif
+    // the queued buffers which weren't played yet
+    ALint queued    = 0;
+    ALint processed = 0;
+    alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
+    alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &processed);
+    return (queued - processed) * QUEUEBUFFER_TIME_STEP;
+}
 
-    char* tmpBuffer           = nullptr;
-    auto& fullPath            = _audioCache->_fileFullPath;
-    AudioDecoder* decoder     = AudioDecoderManager::createDecoder(fullPath);
-    long long rotateSleepTime = static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2;
-    do
+// updateStream is used to rotate alBufferData for _alSource when playing big audio file, returns false once the stream
+// finished
+bool AudioPlayer::updateStream()
+{
+    if (_isDestroyed)
+        return false;
+
+    auto& fullPath = _audioCache->_fileFullPath;
+    if (_streamDecoder == nullptr)
     {
-        BREAK_IF(decoder == nullptr || !decoder->open(fullPath));
+        _streamDecoder = AudioDecoderManager::createDecoder(fullPath);
+        if (_streamDecoder == nullptr || !_streamDecoder->open(fullPath))
+            return false;
 
-        uint32_t framesRead         = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize   = decoder->framesToBytes(framesToRead);
-#if AX_USE_ALSOFT
-        const auto sourceFormat = decoder->getSourceFormat();
-#endif
-        tmpBuffer = (char*)malloc(bufferSize);
-        memset(tmpBuffer, 0, bufferSize);
+        const uint32_t bufferSize = _streamDecoder->framesToBytes(_audioCache->_queBufferFrames);
+        _streamBuffer             = (char*)malloc(bufferSize);
+        memset(_streamBuffer, 0, bufferSize);
 
-        if (offsetFrame != 0)
+        if (_streamOffsetFrame != 0)
         {
-            decoder->seek(offsetFrame);
+            _streamDecoder->seek(_streamOffsetFrame);
         }
+    }
 
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
+    AudioDecoder* decoder       = _streamDecoder;
+    uint32_t framesRead         = 0;
+    const uint32_t framesToRead = _audioCache->_queBufferFrames;
+#if AX_USE_ALSOFT
+    const auto sourceFormat = decoder->getSourceFormat();
+#endif
+
+    ALint sourceState;
+    ALint bufferProcessed = 0;
 
-        while (!_isDestroyed)
+    alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
+    if (sourceState == AL_PLAYING)
+    {
+        alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+        while (bufferProcessed > 0)
         {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING)
+            bufferProcessed--;
+            const auto decodeStart = std::chrono::steady_clock::now();
+            if (_timeDirty)
             {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0)
+                _timeDirty         = false;
+                _streamOffsetFrame = _currTime * decoder->getSampleRate();
+                decoder->seek(_streamOffsetFrame);
+            }
+            else
+            {
+                _currTime += QUEUEBUFFER_TIME_STEP;
+                if (_currTime > _audioCache->_duration)
                 {
-                    bufferProcessed--;
-                    if (_timeDirty)
+                    if (_loop)
                     {
-                        _timeDirty  = false;
-                        offsetFrame = _currTime * decoder->getSampleRate();
-                        decoder->seek(offsetFrame);
+                        _currTime = 0.0f;
                     }
                     else
                     {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration)
-                        {
-                            if (_loop)
-                            {
-                                _currTime = 0.0f;
-                            }
-                            else
-                            {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
-
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-
-                    if (framesRead == 0)
-                    {
-                        if (_loop)
-                        {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        }
-                        else
-                        {
-                            needToExitThread = true;
-                            break;
-                        }
+                        _currTime = _audioCache->_duration;
                     }
-                    /*
-                     While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
-                     already played. Those buffers can then be filled with new data or discarded. New or refilled
-                     buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
-                     always a new buffer to play in the queue, the source will continue to play.
-                     */
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-#if AX_USE_ALSOFT
-                    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
-                        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-#endif
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, decoder->framesToBytes(framesRead),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
                 }
             }
-            /* Make sure the source hasn't underrun */
-            else if (sourceState != AL_PAUSED)
-            {
-                ALint queued;
 
-                /* If no buffers are queued, playback is finished */
-                alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
-                if (queued == 0)
+            framesRead = decoder->readFixedFrames(framesToRead, _streamBuffer);
+
+            if (framesRead == 0)
+            {
+                if (_loop)
                 {
-                    needToExitThread = true;
+                    decoder->seek(0);
+                    framesRead = decoder->readFixedFrames(framesToRead, _streamBuffer);
                 }
                 else
                 {
-                    alSourcePlay(_alSource);
-                    if (alGetError() != AL_NO_ERROR)
-                    {
-                        ALOGE("Error restarting playback!");
-                        needToExitThread = true;
-                    }
+                    return false;
                 }
             }
-
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread)
-            {
-                break;
-            }
-#if defined(__APPLE__)
-            if (!_needWakeupRotateThread)
-            {
-                _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
-            }
-
-            _needWakeupRotateThread = false;
-#else
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
+            /*
+             While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
+             already played. Those buffers can then be filled with new data or discarded. New or refilled
+             buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
+             always a new buffer to play in the queue, the source will continue to play.
+             */
+            ALuint bid;
+            alSourceUnqueueBuffers(_alSource, 1, &bid);
+#if AX_USE_ALSOFT
+            if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
+                alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
 #endif
+            alBufferData(bid, _audioCache->_format, _streamBuffer, decoder->framesToBytes(framesRead),
+                         decoder->getSampleRate());
+            alSourceQueueBuffers(_alSource, 1, &bid);
+
+            // only written by the streaming thread
+            const float decodeTime =
+                std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+            ++_decodedBuffers;
+            _decodeTime.store(_decodeTime.load(std::memory_order_relaxed) + decodeTime, std::memory_order_relaxed);
+            if (decodeTime > _maxDecodeTime.load(std::memory_order_relaxed))
+                _maxDecodeTime.store(decodeTime, std::memory_order_relaxed);
         }
+    }
+    /* Make sure the source hasn't underrun */
+    else if (sourceState != AL_PAUSED)
+    {
+        ALint queued;
 
-    } while (false);
+        /* If no buffers are queued, playback is finished */
+        alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
+        if (queued == 0)
+        {
+            return false;
+        }
 
-    ALOGVV("Exit rotate buffer thread ...");
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
+        // the source stopped since its queue ran dry before it was refilled
+        ++_underruns;
+        alSourcePlay(_alSource);
+        if (alGetError() != AL_NO_ERROR)
+        {
+            ALOGE("Error restarting playback!");
+            return false;
+        }
+    }
+
+    return true;
 }
 
-#if defined(__APPLE__)
-void AudioPlayer::wakeupRotateThread()
+void AudioPlayer::closeStream()
 {
-    _needWakeupRotateThread = true;
-    _sleepCondition.notify_all();
+    ALOGVV("Close stream ...");
+    AudioDecoderManager::destroyDecoder(_streamDecoder);
+    _streamDecoder = nullptr;
+    free(_streamBuffer);
+    _streamBuffer = nullptr;
+
+    // the player may be deleted from now on
+    _isStreamClosed = true;
 }
-#endif
 
 bool AudioPlayer::isFinished() const
 {
     if (_streamingSource)
-        return _isRotateThreadExited;
+        return _isStreamClosed;
     else
     {
         ALint sourceState;
@@ -28,18 +28,20 @@
 
 #include "platform/PlatformConfig.h"
 
+#include <atomic>
 #include <string>
-#include <condition_variable>
 #include <mutex>
 #include <thread>
 
 #include "audio/AudioMacros.h"
+#include "audio/AudioMixer.h"
 #include "platform/PlatformMacros.h"
 #include "audio/alconfig.h"
 
 NS_AX_BEGIN
 
 class AudioCache;
+class AudioDecoder;
 class AudioEngineImpl;
 
 class AX_DLL AudioPlayer
@@ -61,11 +63,12 @@ public:
 
 protected:
     void setCache(AudioCache* cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
-#if defined(__APPLE__)
-    void wakeupRotateThread();
-#endif
+
+    // streaming, called on the streaming thread of AudioEngineImpl
+    float getStreamHeadroom() const;
+    bool updateStream();
+    void closeStream();
 
     AudioCache* _audioCache;
 
@@ -76,20 +79,28 @@ protected:
     bool _isDestroyed;
     bool _removeByAudioEngine;
     bool _ready;
-    ALuint _alSource;
+    ALuint _alSource;  // INVALID_AL_SOURCE_ID while the player is mixed by the software mixer
+
+    // voice of the software mixer, see AudioEngine::setMixerEnabled
+    int _priority;
+    AudioMixer::VoiceId _mixerVoice;
 
     // play by circular buffer
     float _currTime;
     bool _streamingSource;
     ALuint _bufferIds[QUEUEBUFFER_NUM];
-    std::thread* _rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
+    AudioEngineImpl* _streamEngine;  // set once the streaming thread refills the buffers
+    AudioDecoder* _streamDecoder;
+    char* _streamBuffer;
+    int _streamOffsetFrame;
     bool _timeDirty;
-    bool _isRotateThreadExited;
-#if defined(__APPLE__)
-    std::atomic_bool _needWakeupRotateThread;
-#endif
+    std::atomic_bool _isStreamClosed;
+
+    // streaming stats, written by the streaming thread
+    std::atomic<unsigned int> _underruns;
+    std::atomic<unsigned int> _decodedBuffers;
+    std::atomic<float> _decodeTime;
+    std::atomic<float> _maxDecodeTime;
 
     std::mutex _play2dMutex;
 
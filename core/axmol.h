@@ -39,6 +39,7 @@ THE SOFTWARE.
 
 // base
 #include "base/AsyncTaskPool.h"
+#include "base/JobSystem.h"
 #include "base/AutoreleasePool.h"
 #include "base/Configuration.h"
 #include "base/Console.h"
@@ -48,6 +49,8 @@ THE SOFTWARE.
 #include "base/IMEDispatcher.h"
 #include "base/Map.h"
 #include "base/NS.h"
+#include "base/PoolAllocator.h"
+#include "base/FrameProfiler.h"
 #include "base/Profiling.h"
 #include "base/Properties.h"
 #include "base/Ref.h"
@@ -134,6 +137,7 @@ THE SOFTWARE.
 #include "2d/ProtectedNode.h"
 #include "2d/RenderTexture.h"
 #include "2d/Scene.h"
+#include "2d/TransformHierarchy.h"
 #include "2d/Transition.h"
 #include "2d/TransitionPageTurn.h"
 #include "2d/TransitionProgress.h"
@@ -178,6 +182,7 @@ THE SOFTWARE.
 #include "platform/FileUtils.h"
 #include "platform/FileStream.h"
 #include "platform/Image.h"
+#include "platform/GLViewNull.h"
 #include "platform/PlatformConfig.h"
 #include "platform/PlatformMacros.h"
 #include "platform/SAXParser.h"
@@ -280,6 +285,7 @@ THE SOFTWARE.
 #include "3d/Skeleton3D.h"
 #include "3d/Skybox.h"
 #include "3d/MeshRenderer.h"
+#include "3d/MeshRendererBVH.h"
 #include "3d/MeshMaterial.h"
 #include "3d/Terrain.h"
 #include "3d/VertexAttribBinding.h"
@@ -25,6 +25,8 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "base/AsyncTaskPool.h"
+#include "base/JobSystem.h"
+#include "base/FrameProfiler.h"
 
 NS_AX_BEGIN
 
@@ -45,8 +47,48 @@ void AsyncTaskPool::destroyInstance()
     s_asyncTaskPool = nullptr;
 }
 
-AsyncTaskPool::AsyncTaskPool() {}
+AsyncTaskPool::AsyncTaskPool()
+    : _generations(new std::atomic<unsigned int>[int(TaskType::TASK_MAX_TYPE)]{})
+{}
 
-AsyncTaskPool::~AsyncTaskPool() {}
+AsyncTaskPool::~AsyncTaskPool()
+{
+    // like the old task threads, pending tasks are dropped with the pool
+    for (int i = 0; i < int(TaskType::TASK_MAX_TYPE); ++i)
+        ++_generations[i];
+}
+
+void AsyncTaskPool::stopTasks(TaskType type)
+{
+    ++_generations[(int)type];
+}
+
+void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type,
+                            TaskCallBack callback,
+                            void* callbackParam,
+                            std::function<void()> task)
+{
+    // the tasks keep the counters alive, they may still run after the pool was destroyed
+    auto generations  = _generations;
+    const auto index  = (int)type;
+    const auto queued = generations[index].load();
+
+    // each task continues the previous one of its type, FileUtils::performOperationOffthread relies on the order
+    std::lock_guard<std::mutex> lock(_lastTasksMutex);
+    _lastTasks[index] = JobSystem::getInstance()->then(
+        _lastTasks[index],
+        [generations = std::move(generations), index, queued, task = std::move(task), callback = std::move(callback),
+         callbackParam]() {
+            if (generations[index].load() != queued)
+                return;
+
+            {
+                AX_PROFILE_ZONE("AsyncTaskPool::task");
+                task();
+            }
+            Director::getInstance()->getScheduler()->runOnAxmolThread(std::bind(callback, callbackParam));
+        },
+        type == TaskType::TASK_OTHER ? JobSystem::Priority::LOW : JobSystem::Priority::NORMAL);
+}
 
 NS_AX_END
@@ -29,9 +29,11 @@ THE SOFTWARE.
 #include "platform/PlatformMacros.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/JobSystem.h"
 #include <vector>
 #include <queue>
 #include <memory>
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -48,6 +50,7 @@ NS_AX_BEGIN
 /**
  * @class AsyncTaskPool
  * @brief This class allows to perform background operations without having to manipulate threads.
+ * The tasks run on the workers of the JobSystem, tasks of the same type are no longer serialized.
  * @js NA
  */
 class AX_DLL AsyncTaskPool
@@ -75,6 +78,7 @@ public:
 
     /**
      * Stop tasks.
+     * Tasks of the type which didn't start yet are skipped and their callbacks are not called.
      *
      * @param type Task type you want to stop.
      */
@@ -83,7 +87,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others.
      * @param callback callback when the task is finished. The callback is called in the main thread instead of task
      * thread.
      * @param callbackParam parameter used by the callback.
@@ -95,7 +99,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others.
      * @param task: task can be lambda function to be performed off thread.
      * @lua NA
      */
@@ -105,120 +109,16 @@ public:
     ~AsyncTaskPool();
 
 protected:
-    // thread tasks internally used
-    class ThreadTasks
-    {
-        struct AsyncTaskCallBack
-        {
-            TaskCallBack callback;
-            void* callbackParam;
-        };
-
-    public:
-        ThreadTasks() : _stop(false)
-        {
-            _thread = std::thread([this] {
-                for (;;)
-                {
-                    std::function<void()> task;
-                    AsyncTaskCallBack callback;
-                    {
-                        std::unique_lock<std::mutex> lock(this->_queueMutex);
-                        this->_condition.wait(lock, [this] { return this->_stop || !this->_tasks.empty(); });
-                        if (this->_stop && this->_tasks.empty())
-                            return;
-                        task     = std::move(this->_tasks.front());
-                        callback = std::move(this->_taskCallBacks.front());
-                        this->_tasks.pop();
-                        this->_taskCallBacks.pop();
-                    }
-
-                    task();
-                    Director::getInstance()->getScheduler()->runOnAxmolThread(
-                        std::bind(callback.callback, callback.callbackParam));
-                }
-            });
-        }
-        ~ThreadTasks()
-        {
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-                _stop = true;
-
-                while (_tasks.size())
-                    _tasks.pop();
-                while (_taskCallBacks.size())
-                    _taskCallBacks.pop();
-            }
-            _condition.notify_all();
-            _thread.join();
-        }
-        void clear()
-        {
-            std::unique_lock<std::mutex> lock(_queueMutex);
-            while (_tasks.size())
-                _tasks.pop();
-            while (_taskCallBacks.size())
-                _taskCallBacks.pop();
-        }
-
-        void enqueue(TaskCallBack callback, void* callbackParam, std::function<void()> task)
-        {
-            AsyncTaskCallBack taskCallBack;
-            taskCallBack.callback      = std::move(callback);
-            taskCallBack.callbackParam = callbackParam;
-
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-
-                // don't allow enqueueing after stopping the pool
-                if (_stop)
-                {
-                    AX_ASSERT(0 && "already stop");
-                    return;
-                }
-
-                _tasks.push(std::move(task));
-                _taskCallBacks.push(std::move(taskCallBack));
-            }
-            _condition.notify_one();
-        }
-
-    private:
-        // need to keep track of thread so we can join them
-        std::thread _thread;
-        // the task queue
-        std::queue<std::function<void()>> _tasks;
-        std::queue<AsyncTaskCallBack> _taskCallBacks;
-
-        // synchronization
-        std::mutex _queueMutex;
-        std::condition_variable _condition;
-        bool _stop;
-    };
+    // bumped by stopTasks, tasks enqueued with an older generation are skipped
+    std::shared_ptr<std::atomic<unsigned int>[]> _generations;
 
-    // tasks
-    ThreadTasks _threadTasks[int(TaskType::TASK_MAX_TYPE)];
+    // the tasks of a type run one after another in FIFO order, like on the old task threads
+    std::mutex _lastTasksMutex;
+    JobSystem::JobHandle _lastTasks[int(TaskType::TASK_MAX_TYPE)];
 
     static AsyncTaskPool* s_asyncTaskPool;
 };
 
-inline void AsyncTaskPool::stopTasks(TaskType type)
-{
-    auto& threadTask = _threadTasks[(int)type];
-    threadTask.clear();
-}
-
-inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type,
-                                   TaskCallBack callback,
-                                   void* callbackParam,
-                                   std::function<void()> task)
-{
-    auto& threadTask = _threadTasks[(int)type];
-
-    threadTask.enqueue(std::move(callback), callbackParam, std::move(task));
-}
-
 inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type, std::function<void()> task)
 {
     enqueue(
@@ -53,12 +53,36 @@ AutoreleasePool::~AutoreleasePool()
     AXLOGINFO("deallocing AutoreleasePool: %p", this);
     clear();
 
+    // objects autoreleased by the last clear are left alone, they must not reclaim from a destroyed pool
+    for (const auto& obj : _managedObjectArray)
+    {
+        if (obj)
+            obj->_autoreleaseIndex = 0;
+    }
+
     PoolManager::getInstance()->pop();
 }
 
 void AutoreleasePool::addObject(Ref* object)
 {
     _managedObjectArray.emplace_back(object);
+    if (_reclaimOnRetain)
+        object->_autoreleaseIndex = static_cast<unsigned int>(_managedObjectArray.size());
+    ++_stats.autoreleased;
+}
+
+bool AutoreleasePool::reclaim(Ref* object)
+{
+    const auto index = object->_autoreleaseIndex - 1;
+    if (index < _managedObjectArray.size() && _managedObjectArray[index] == object)
+    {
+        // cleared slots are skipped by clear
+        _managedObjectArray[index] = nullptr;
+        object->_autoreleaseIndex  = 0;
+        ++_stats.reclaimed;
+        return true;
+    }
+    return false;
 }
 
 void AutoreleasePool::clear()
@@ -66,12 +90,20 @@ void AutoreleasePool::clear()
 #if defined(_AX_DEBUG) && (_AX_DEBUG > 0)
     _isClearing = true;
 #endif
-    std::vector<Ref*> releasings;
-    releasings.swap(_managedObjectArray);
-    for (const auto& obj : releasings)
+    // objects autoreleased by the releases go to the recycled storage and are released by the next clear
+    _releasingObjectArray.swap(_managedObjectArray);
+    _lastClearStats = _stats;
+    _stats          = Stats{};
+    for (const auto& obj : _releasingObjectArray)
     {
-        obj->release();
+        if (obj)
+        {
+            obj->_autoreleaseIndex = 0;
+            obj->release();
+            ++_lastClearStats.released;
+        }
     }
+    _releasingObjectArray.clear();
 #if defined(_AX_DEBUG) && (_AX_DEBUG > 0)
     _isClearing = false;
 #endif
@@ -94,7 +126,8 @@ void AutoreleasePool::dump()
     AXLOG("%20s%20s%20s", "Object pointer", "Object id", "reference count");
     for (const auto& obj : _managedObjectArray)
     {
-        AXLOG("%20p%20u\n", obj, obj->getReferenceCount());
+        if (obj)
+            AXLOG("%20p%20u\n", obj, obj->getReferenceCount());
     }
 }
 
@@ -89,6 +89,61 @@ public:
      */
     void clear();
 
+    /**
+     * Sets whether a retain of an object whose only reference is its pending release in this pool takes over
+     * that reference, instead of adding one which the clear releases again. Saves the release round trip
+     * for objects created and handed over right away, like nodes added as children.
+     *
+     * @warning Such objects are destroyed as soon as their new owner releases them, instead of living until
+     * the pool is cleared. Only enable it if objects aren't used after removing them from their owner in
+     * the frame they were created. Disabled by default.
+     *
+     * @param enabled   Whether a retain reclaims the pending release.
+     * @js NA
+     * @lua NA
+     */
+    void setReclaimOnRetain(bool enabled) { _reclaimOnRetain = enabled; }
+
+    bool isReclaimOnRetain() const { return _reclaimOnRetain; }
+
+    /**
+     * Cancels the pending release of an object, if it's in this pool.
+     *
+     * Ref::retain calls it for the objects whose only reference is the pending release,
+     * when the pool reclaims on retain, the retain takes over that reference then.
+     *
+     * @param object    The object.
+     * @return True if the pending release was canceled.
+     * @js NA
+     * @lua NA
+     */
+    bool reclaim(Ref* object);
+
+    /** Object counts of the pool between two clears. */
+    struct Stats
+    {
+        unsigned int autoreleased = 0;  ///< objects added to the pool
+        unsigned int reclaimed    = 0;  ///< pending releases canceled by a retain, see reclaim
+        unsigned int released     = 0;  ///< objects released by the clear
+    };
+
+    /**
+     * Returns the counts of the objects added since the last clear.
+     *
+     * @js NA
+     * @lua NA
+     */
+    const Stats& getStats() const { return _stats; }
+
+    /**
+     * Returns the counts of the objects handled by the last clear, which are the counts of the last frame
+     * for the pool of the engine.
+     *
+     * @js NA
+     * @lua NA
+     */
+    const Stats& getLastClearStats() const { return _lastClearStats; }
+
 #if defined(_AX_DEBUG) && (_AX_DEBUG > 0)
     /**
      * Whether the autorelease pool is doing `clear` operation.
@@ -133,8 +188,14 @@ private:
      * is in the pool.
      */
     std::vector<Ref*> _managedObjectArray;
+    /** The objects being released by clear, swapped with _managedObjectArray so both keep their storage. */
+    std::vector<Ref*> _releasingObjectArray;
     std::string _name;
 
+    Stats _stats;
+    Stats _lastClearStats;
+    bool _reclaimOnRetain = false;
+
 #if defined(_AX_DEBUG) && (_AX_DEBUG > 0)
     /**
      *  The flag for checking whether the pool is doing `clear` operation.
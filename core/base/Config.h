@@ -246,6 +246,26 @@ THE SOFTWARE.
 #    define AX_ENABLE_PROFILERS 0
 #endif
 
+/** @def AX_USE_POOL_ALLOCATOR
+ * If enabled, the engine types which opt in with AX_POOL_ALLOCATED_DECL (Sprite, Label, Action, EventListener and
+ * RenderCommand) are allocated from the size class pool of allocator::PoolAllocator instead of the global heap.
+ * Their statistics are printed by the allocator console command.
+ * Enabled by default.
+ */
+#ifndef AX_USE_POOL_ALLOCATOR
+#    define AX_USE_POOL_ALLOCATOR 1
+#endif
+
+/** @def AX_ENABLE_FRAME_PROFILER
+ * If enabled, the frame phases of the Director and the texture and async task workers are recorded as zones by
+ * FrameProfiler once it is started, e.g. by the profiler console command, and can be exported as Chrome trace JSON.
+ * A zone only costs an atomic load while the profiler is stopped.
+ * Enabled by default.
+ */
+#ifndef AX_ENABLE_FRAME_PROFILER
+#    define AX_ENABLE_FRAME_PROFILER 1
+#endif
+
 /** Enable Lua engine debug log. */
 #ifndef AX_LUA_ENGINE_DEBUG
 #    define AX_LUA_ENGINE_DEBUG 0
@@ -47,6 +47,8 @@
 #include "base/Scheduler.h"
 #include "platform/PlatformConfig.h"
 #include "base/Configuration.h"
+#include "base/PoolAllocator.h"
+#include "base/FrameProfiler.h"
 #include "2d/Scene.h"
 #include "platform/FileUtils.h"
 #include "renderer/TextureCache.h"
@@ -75,6 +77,15 @@ extern const char* axmolVersion(void);
 #define DEFAULT_COMMAND_SEPARATOR '|'
 
 static const size_t SEND_BUFSIZ = 512;
+// the most profiler frames waiting for a slow console, newer frames are dropped
+static const size_t MAX_PROFILER_FRAMES = 60;
+
+// a console which went away must not raise SIGPIPE on the sending thread
+#if defined(MSG_NOSIGNAL)
+static const int SEND_NOSIGNAL = MSG_NOSIGNAL;
+#else
+static const int SEND_NOSIGNAL = 0;
+#endif
 
 /** private functions */
 namespace
@@ -473,6 +484,7 @@ Console::Console()
     , _endThread(false)
     , _isIpv6Server(false)
     , _sendDebugStrings(false)
+    , _profilerStreamFd(-1)
     , _bindAddress()
 {
     createCommandAllocator();
@@ -483,6 +495,7 @@ Console::Console()
     createCommandFileUtils();
     createCommandFps();
     createCommandHelp();
+    createCommandProfiler();
     createCommandProjection();
     createCommandResolution();
     createCommandSceneGraph();
@@ -555,6 +568,13 @@ void Console::stop()
             _thread.join();
         }
     }
+
+    // the frame listener refers to this console
+    if (_profilerStreamFd != -1)
+    {
+        _profilerStreamFd = -1;
+        FrameProfiler::getInstance()->setFrameListener(nullptr);
+    }
 }
 
 void Console::addCommand(const Command& cmd)
@@ -736,10 +756,7 @@ void Console::loop()
 
             /* remove closed connections */
             for (int fd : to_remove)
-            {
-                _watcher.mod_event(fd, 0, yasio::socket_event::read);
-                _fds.erase(std::remove(_fds.begin(), _fds.end(), fd), _fds.end());
-            }
+                removeClient(fd);
         }
 
         /* Any message for the remote console ? send it! */
@@ -758,6 +775,9 @@ void Console::loop()
                 _DebugStringsMutex.unlock();
             }
         }
+
+        /* Any frame for the profiler stream ? send it! */
+        sendProfilerFrames();
     }
 
     // clean up: ignore stdin, stdout and stderr
@@ -961,6 +981,49 @@ void Console::addClient()
     }
 }
 
+void Console::removeClient(socket_native_type fd)
+{
+    stopProfilerStream(fd);
+    _watcher.mod_event(fd, 0, yasio::socket_event::read);
+    _fds.erase(std::remove(_fds.begin(), _fds.end(), fd), _fds.end());
+}
+
+void Console::sendProfilerFrames()
+{
+    socket_native_type fd;
+    std::vector<std::string> frames;
+    {
+        std::lock_guard<std::mutex> lock(_profilerFramesMutex);
+        if (_profilerFrames.empty())
+            return;
+        fd = _profilerStreamFd;
+        frames.swap(_profilerFrames);
+    }
+
+    for (auto&& frame : frames)
+    {
+        // stop streaming once the console went away
+        if (Console::Utility::sendToConsole(fd, frame.data(), frame.length(), SEND_NOSIGNAL) <
+            static_cast<ssize_t>(frame.length()))
+        {
+            stopProfilerStream(fd);
+            break;
+        }
+    }
+}
+
+void Console::stopProfilerStream(socket_native_type fd)
+{
+    {
+        std::lock_guard<std::mutex> lock(_profilerFramesMutex);
+        if (_profilerStreamFd == -1 || _profilerStreamFd != fd)
+            return;
+        _profilerStreamFd = -1;
+        _profilerFrames.clear();
+    }
+    FrameProfiler::getInstance()->setFrameListener(nullptr);
+}
+
 //
 // create commands
 //
@@ -1034,6 +1097,24 @@ void Console::createCommandHelp()
     addCommand({"help", "Print this message. Args: [ ]", AX_CALLBACK_2(Console::commandHelp, this)});
 }
 
+void Console::createCommandProfiler()
+{
+    addCommand({"profiler",
+                "Record the frame phases as Chrome trace JSON. Args: [-h | help | start | stop | dump [path] | stream "
+                "on | stream off | ]",
+                AX_CALLBACK_2(Console::commandProfiler, this)});
+    addSubCommand("profiler",
+                  {"start", "Start recording.", AX_CALLBACK_2(Console::commandProfilerSubCommandStartStop, this)});
+    addSubCommand("profiler", {"stop", "Stop recording, the recorded events are kept.",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandStartStop, this)});
+    addSubCommand("profiler",
+                  {"dump", "Write the recorded events to path, axmol-trace.json in the writable path by default.",
+                   AX_CALLBACK_2(Console::commandProfilerSubCommandDump, this)});
+    addSubCommand("profiler",
+                  {"stream", "Send the events of every frame to this console as JSON lines. Args: [on | off]",
+                   AX_CALLBACK_2(Console::commandProfilerSubCommandStream, this)});
+}
+
 void Console::createCommandProjection()
 {
     addCommand({"projection", "Change or print the current projection. Args: [-h | help | 2d | 3d | ]",
@@ -1091,12 +1172,12 @@ void Console::createCommandVersion()
 
 void Console::commandAllocator(socket_native_type fd, std::string_view /*args*/)
 {
-#if AX_ENABLE_ALLOCATOR_DIAGNOSTICS
+#if AX_USE_POOL_ALLOCATOR
     auto info = allocator::AllocatorDiagnostics::instance()->diagnostics();
-    Console::Utility::mydprintf(fd, info.c_str());
+    Console::Utility::mydprintf(fd, "%s", info.c_str());
 #else
     Console::Utility::mydprintf(
-        fd, "allocator diagnostics not available. AX_ENABLE_ALLOCATOR_DIAGNOSTICS must be set to 1 in ccConfig.h\n");
+        fd, "allocator diagnostics not available. AX_USE_POOL_ALLOCATOR must be set to 1 in Config.h\n");
 #endif
 }
 
@@ -1153,8 +1234,7 @@ void Console::commandDirectorSubCommandEnd(socket_native_type /*fd*/, std::strin
 
 void Console::commandExit(socket_native_type fd, std::string_view /*args*/)
 {
-    _watcher.mod_event(fd, 0, yasio::socket_event::read);
-    _fds.erase(std::remove(_fds.begin(), _fds.end(), fd), _fds.end());
+    removeClient(fd);
     closesocket(fd);
 }
 
@@ -1187,6 +1267,69 @@ void Console::commandHelp(socket_native_type fd, std::string_view /*args*/)
     sendHelp(fd, _commands, "\nAvailable commands:\n");
 }
 
+void Console::commandProfiler(socket_native_type fd, std::string_view /*args*/)
+{
+#if AX_ENABLE_FRAME_PROFILER
+    auto profiler = FrameProfiler::getInstance();
+    Console::Utility::mydprintf(fd, "Profiler is: %s, %u events per thread\n", profiler->isEnabled() ? "on" : "off",
+                                static_cast<unsigned int>(profiler->getEventsPerThread()));
+#else
+    Console::Utility::mydprintf(fd, "profiler not available. AX_ENABLE_FRAME_PROFILER must be set to 1 in Config.h\n");
+#endif
+}
+
+void Console::commandProfilerSubCommandStartStop(socket_native_type /*fd*/, std::string_view args)
+{
+    FrameProfiler::getInstance()->setEnabled(args.compare("start") == 0);
+}
+
+void Console::commandProfilerSubCommandDump(socket_native_type fd, std::string_view args)
+{
+    auto argv        = Console::Utility::split(args, ' ');
+    std::string path = argv.size() > 1 ? argv[1] : FileUtils::getInstance()->getWritablePath() + "axmol-trace.json";
+
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([=]() {
+        if (FrameProfiler::getInstance()->writeChromeTrace(path))
+            Console::Utility::mydprintf(fd, "Trace written to: %s\n", path.c_str());
+        else
+            Console::Utility::mydprintf(fd, "Failed to write the trace to: %s\n", path.c_str());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandProfilerSubCommandStream(socket_native_type fd, std::string_view args)
+{
+    auto argv   = Console::Utility::split(args, ' ');
+    bool stream = argv.size() > 1 && argv[1] == "on";
+
+    if (!stream)
+    {
+        // only the console thread changes the stream
+        stopProfilerStream(_profilerStreamFd);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_profilerFramesMutex);
+        _profilerStreamFd = fd;
+        _profilerFrames.clear();
+    }
+
+    // the axmol thread only queues the frames, the console thread sends them
+    auto profiler = FrameProfiler::getInstance();
+    profiler->setFrameListener([this](std::string_view json) {
+        {
+            std::lock_guard<std::mutex> lock(_profilerFramesMutex);
+            if (_profilerStreamFd == -1 || _profilerFrames.size() >= MAX_PROFILER_FRAMES)
+                return;
+            _profilerFrames.emplace_back(json);
+        }
+        _watcher.wakeup();
+    });
+    profiler->setEnabled(true);
+}
+
 void Console::commandProjection(socket_native_type fd, std::string_view /*args*/)
 {
     auto director = Director::getInstance();
@@ -225,6 +225,11 @@ protected:
     void performCommand(socket_native_type fd, std::string_view command);
 
     void addClient();
+    void removeClient(socket_native_type fd);
+
+    // profiler frames streamed to a console
+    void sendProfilerFrames();
+    void stopProfilerStream(socket_native_type fd);
 
     // create a map of command.
     void createCommandAllocator();
@@ -235,6 +240,7 @@ protected:
     void createCommandFileUtils();
     void createCommandFps();
     void createCommandHelp();
+    void createCommandProfiler();
     void createCommandProjection();
     void createCommandResolution();
     void createCommandSceneGraph();
@@ -259,6 +265,10 @@ protected:
     void commandFps(socket_native_type fd, std::string_view args);
     void commandFpsSubCommandOnOff(socket_native_type fd, std::string_view args);
     void commandHelp(socket_native_type fd, std::string_view args);
+    void commandProfiler(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandStartStop(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandDump(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandStream(socket_native_type fd, std::string_view args);
     void commandProjection(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand2d(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand3d(socket_native_type fd, std::string_view args);
@@ -289,6 +299,11 @@ protected:
     std::mutex _DebugStringsMutex;
     std::vector<std::string> _DebugStrings;
 
+    // frames of the profiler queued by the axmol thread, sent to _profilerStreamFd by the console thread
+    socket_native_type _profilerStreamFd;
+    std::mutex _profilerFramesMutex;
+    std::vector<std::string> _profilerFrames;
+
     intptr_t _touchId;
 
     std::string _bindAddress;
@@ -58,6 +58,8 @@ THE SOFTWARE.
 #include "base/AutoreleasePool.h"
 #include "base/Configuration.h"
 #include "base/AsyncTaskPool.h"
+#include "base/JobSystem.h"
+#include "base/FrameProfiler.h"
 #include "base/ObjectFactory.h"
 #include "platform/Application.h"
 #include "audio/AudioEngine.h"
@@ -66,6 +68,10 @@ THE SOFTWARE.
 #    include "base/ScriptSupport.h"
 #endif
 
+#if defined(AX_USE_GL)
+#    include "renderer/backend/opengl/ProgramBinaryCacheGL.h"
+#endif
+
 using namespace std;
 
 NS_AX_BEGIN
@@ -109,6 +115,8 @@ bool Director::init()
     // FPS
     _lastUpdate = std::chrono::steady_clock::now();
 
+    AX_PROFILE_THREAD_NAME("axmol");
+
     _console = new Console;
 
     // scheduler
@@ -261,6 +269,8 @@ void Director::setGLDefaultValues()
 // Draw the Scene
 void Director::drawScene()
 {
+    AX_PROFILE_ZONE("Director::drawScene");
+
     _renderer->beginFrame();
 
     // calculate "global" dt
@@ -268,12 +278,14 @@ void Director::drawScene()
 
     if (_glView)
     {
+        AX_PROFILE_ZONE("GLView::pollEvents");
         _glView->pollEvents();
     }
 
     // tick before glClear: issue #533
     if (!_paused)
     {
+        AX_PROFILE_ZONE("Scheduler::update");
         _eventDispatcher->dispatchEvent(_eventBeforeUpdate);
         _scheduler->update(_deltaTime);
         _eventDispatcher->dispatchEvent(_eventAfterUpdate);
@@ -296,14 +308,20 @@ void Director::drawScene()
     if (_runningScene)
     {
 #if (AX_USE_PHYSICS || (AX_USE_3D_PHYSICS && AX_ENABLE_BULLET_INTEGRATION) || AX_USE_NAVMESH)
-        _runningScene->stepPhysicsAndNavigation(_deltaTime);
+        {
+            AX_PROFILE_ZONE("Scene::stepPhysicsAndNavigation");
+            _runningScene->stepPhysicsAndNavigation(_deltaTime);
+        }
 #endif
         // clear draw stats
         _renderer->clearDrawStats();
 
         // render the scene
         if (_glView)
+        {
+            AX_PROFILE_ZONE("Scene::visit");
             _glView->renderScene(_runningScene, _renderer);
+        }
 
         _eventDispatcher->dispatchEvent(_eventAfterVisit);
     }
@@ -323,7 +341,10 @@ void Director::drawScene()
 #endif
     }
 
-    _renderer->render();
+    {
+        AX_PROFILE_ZONE("Renderer::render");
+        _renderer->render();
+    }
 
     _eventDispatcher->dispatchEvent(_eventAfterDraw);
 
@@ -334,6 +355,7 @@ void Director::drawScene()
     // swap buffers
     if (_glView)
     {
+        AX_PROFILE_ZONE("GLView::swapBuffers");
         _glView->swapBuffers();
     }
 
@@ -1039,15 +1061,20 @@ void Director::reset()
     // purge all managed caches
     AnimationCache::destroyInstance();
     SpriteFrameCache::destroyInstance();
-    FileUtils::destroyInstance();
+    // the async texture loads and tasks run on the job system and use FileUtils, finish them first
+    destroyTextureCache();
+#if defined(AX_USE_GL)
+    // the program binaries are written by jobs using FileUtils
+    backend::ProgramBinaryCacheGL::waitForSaves();
+#endif
     AsyncTaskPool::destroyInstance();
+    JobSystem::destroyInstance();
+    FileUtils::destroyInstance();
     backend::ProgramManager::destroyInstance();
 
     // axmol specific data structures
     UserDefault::destroyInstance();
     resetMatrixStack();
-
-    destroyTextureCache();
 }
 
 void Director::purgeDirector()
@@ -1532,7 +1559,24 @@ void Director::mainLoop()
         drawScene();
 
         // release the objects
-        PoolManager::getInstance()->getCurrentPool()->clear();
+        auto pool = PoolManager::getInstance()->getCurrentPool();
+        pool->clear();
+
+#if AX_ENABLE_FRAME_PROFILER
+        auto profiler = FrameProfiler::getInstance();
+        if (profiler->isEnabled())
+        {
+            auto& poolStats = pool->getLastClearStats();
+            profiler->addCounter("AutoreleasePool::autoreleased", poolStats.autoreleased);
+            profiler->addCounter("AutoreleasePool::reclaimed", poolStats.reclaimed);
+            profiler->addCounter("AutoreleasePool::released", poolStats.released);
+            profiler->addCounter("Renderer::drawnBatches", _renderer->getDrawnBatches());
+            profiler->addCounter("Renderer::drawnMeshes", _renderer->getDrawnMeshes());
+            profiler->addCounter("Renderer::culledMeshes", _renderer->getCulledMeshes());
+            profiler->addCounter("Renderer::instancedMeshes", _renderer->getInstancedMeshes());
+            profiler->markFrame();
+        }
+#endif
     }
 }
 
@@ -48,6 +48,15 @@
 namespace
 {
 
+// size of the cells of the hit test index in world units, bigger bounds are tested for every touch
+static const float HIT_TEST_CELL_SIZE = 128.0f;
+static const int HIT_TEST_MAX_CELLS   = 64;
+
+inline uint64_t hitTestCellKey(int x, int y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
 class DispatchGuard
 {
 public:
@@ -475,6 +484,14 @@ void EventDispatcher::associateNodeAndEventListener(Node* node, EventListener* l
     }
 
     listeners->emplace_back(listener);
+
+    if (listener->getType() == EventListener::Type::TOUCH_ONE_BY_ONE &&
+        static_cast<EventListenerTouchOneByOne*>(listener)->_hitTestByBounds)
+    {
+        addToHitTestIndex(listener);
+        node->_hitTestIndexed = true;
+        setHitTestDirtyForNode(node);
+    }
 }
 
 void EventDispatcher::dissociateNodeAndEventListener(Node* node, EventListener* listener)
@@ -490,6 +507,19 @@ void EventDispatcher::dissociateNodeAndEventListener(Node* node, EventListener*
             listeners->erase(iter);
         }
 
+        if (node->_hitTestIndexed)
+        {
+            removeFromHitTestIndex(listener);
+            node->_hitTestIndexed = std::any_of(listeners->begin(), listeners->end(), [this](EventListener* l) {
+                return _hitTestEntries.find(l) != _hitTestEntries.end();
+            });
+            if (!node->_hitTestIndexed && node->_hitTestDirty)
+            {
+                node->_hitTestDirty = false;
+                _hitTestDirtyNodes.erase(std::find(_hitTestDirtyNodes.begin(), _hitTestDirtyNodes.end(), node));
+            }
+        }
+
         if (listeners->empty())
         {
             _nodeListenersMap.erase(found);
@@ -498,6 +528,187 @@ void EventDispatcher::dissociateNodeAndEventListener(Node* node, EventListener*
     }
 }
 
+void EventDispatcher::setHitTestDirtyForNode(Node* node)
+{
+    if (!node->_hitTestDirty)
+    {
+        node->_hitTestDirty = true;
+        _hitTestDirtyNodes.emplace_back(node);
+    }
+}
+
+void EventDispatcher::addToHitTestIndex(EventListener* listener)
+{
+    // no bounds until the node is updated
+    auto& entry = _hitTestEntries[listener];
+    entry.aside = true;
+    _hitTestUnbounded.emplace_back(listener);
+}
+
+void EventDispatcher::removeFromHitTestIndex(EventListener* listener)
+{
+    auto iter = _hitTestEntries.find(listener);
+    if (iter == _hitTestEntries.end())
+        return;
+
+    auto& entry = iter->second;
+    if (entry.aside)
+        _hitTestUnbounded.erase(std::find(_hitTestUnbounded.begin(), _hitTestUnbounded.end(), listener));
+    else
+        eraseHitTestCells(listener, entry);
+    _hitTestEntries.erase(iter);
+}
+
+void EventDispatcher::insertHitTestCells(EventListener* listener, HitTestEntry& entry)
+{
+    for (int x = entry.minX; x <= entry.maxX; ++x)
+        for (int y = entry.minY; y <= entry.maxY; ++y)
+            _hitTestCells[hitTestCellKey(x, y)].emplace_back(listener);
+}
+
+void EventDispatcher::eraseHitTestCells(EventListener* listener, HitTestEntry& entry)
+{
+    for (int x = entry.minX; x <= entry.maxX; ++x)
+    {
+        for (int y = entry.minY; y <= entry.maxY; ++y)
+        {
+            auto cell = _hitTestCells.find(hitTestCellKey(x, y));
+            if (cell == _hitTestCells.end())
+                continue;
+
+            // the order in a cell doesn't matter, the candidates are dispatched in listener order
+            auto& cellListeners = cell->second;
+            auto it             = std::find(cellListeners.begin(), cellListeners.end(), listener);
+            if (it != cellListeners.end())
+            {
+                *it = cellListeners.back();
+                cellListeners.pop_back();
+            }
+            if (cellListeners.empty())
+                _hitTestCells.erase(cell);
+        }
+    }
+}
+
+void EventDispatcher::updateHitTestIndex()
+{
+    for (auto node : _hitTestDirtyNodes)
+    {
+        node->_hitTestDirty = false;
+
+        auto found = _nodeListenersMap.find(node);
+        if (found == _nodeListenersMap.end())
+            continue;
+
+        const auto& m    = node->_modelViewTransform;
+        const auto& size = node->getContentSize();
+
+        // only nodes lying in the world plane z = 0 can be tested by 2d bounds
+        const bool planar    = m.m[2] == 0 && m.m[6] == 0 && m.m[14] == 0;
+        const bool hasBounds = planar && size.width > 0 && size.height > 0;
+
+        Rect bounds;
+        int minX = 0, minY = 0, maxX = -1, maxY = -1;
+        bool aside = true;
+        if (hasBounds)
+        {
+            bounds           = RectApplyTransform(Rect(Vec2::ZERO, size), m);
+            const float minx = std::floor(bounds.getMinX() / HIT_TEST_CELL_SIZE);
+            const float miny = std::floor(bounds.getMinY() / HIT_TEST_CELL_SIZE);
+            const float maxx = std::floor(bounds.getMaxX() / HIT_TEST_CELL_SIZE);
+            const float maxy = std::floor(bounds.getMaxY() / HIT_TEST_CELL_SIZE);
+
+            // bounds spanning too many cells are kept aside and tested against every touch
+            if ((maxx - minx + 1) * (maxy - miny + 1) <= HIT_TEST_MAX_CELLS && std::abs(minx) < 1e8f &&
+                std::abs(miny) < 1e8f)
+            {
+                minX  = static_cast<int>(minx);
+                minY  = static_cast<int>(miny);
+                maxX  = static_cast<int>(maxx);
+                maxY  = static_cast<int>(maxy);
+                aside = false;
+            }
+        }
+
+        for (auto listener : *found->second)
+        {
+            auto iter = _hitTestEntries.find(listener);
+            if (iter == _hitTestEntries.end())
+                continue;
+
+            auto& entry          = iter->second;
+            const bool sameCells = !entry.aside && !aside && entry.minX == minX && entry.minY == minY &&
+                                   entry.maxX == maxX && entry.maxY == maxY;
+
+            if (!sameCells)
+            {
+                if (entry.aside && !aside)
+                    _hitTestUnbounded.erase(std::find(_hitTestUnbounded.begin(), _hitTestUnbounded.end(), listener));
+                else if (!entry.aside)
+                    eraseHitTestCells(listener, entry);
+
+                entry.minX = minX;
+                entry.minY = minY;
+                entry.maxX = maxX;
+                entry.maxY = maxY;
+                if (!aside)
+                    insertHitTestCells(listener, entry);
+                else if (!entry.aside)
+                    _hitTestUnbounded.emplace_back(listener);
+            }
+
+            entry.bounds    = bounds;
+            entry.hasBounds = hasBounds;
+            entry.aside     = aside;
+        }
+    }
+    _hitTestDirtyNodes.clear();
+}
+
+bool EventDispatcher::queryHitTestIndex(const Touch* touch, const Camera* camera)
+{
+    // intersect the touch ray with the world plane z = 0
+    const auto location = touch->getLocation();
+    Vec3 nearPoint(location.x, location.y, -1), farPoint(location.x, location.y, 1);
+    nearPoint = camera->unprojectGL(nearPoint);
+    farPoint  = camera->unprojectGL(farPoint);
+
+    const auto direction = farPoint - nearPoint;
+    if (direction.z == 0)
+        return false;
+
+    const auto t = -nearPoint.z / direction.z;
+    const Vec2 point(nearPoint.x + t * direction.x, nearPoint.y + t * direction.y);
+
+    ++_hitTestStamp;
+
+    auto cell = _hitTestCells.find(hitTestCellKey(static_cast<int>(std::floor(point.x / HIT_TEST_CELL_SIZE)),
+                                                  static_cast<int>(std::floor(point.y / HIT_TEST_CELL_SIZE))));
+    if (cell != _hitTestCells.end())
+    {
+        for (auto listener : cell->second)
+        {
+            if (_hitTestEntries[listener].bounds.containsPoint(point))
+                static_cast<EventListenerTouchOneByOne*>(listener)->_hitTestStamp = _hitTestStamp;
+        }
+    }
+
+    for (auto listener : _hitTestUnbounded)
+    {
+        const auto& entry = _hitTestEntries[listener];
+        if (!entry.hasBounds || entry.bounds.containsPoint(point))
+            static_cast<EventListenerTouchOneByOne*>(listener)->_hitTestStamp = _hitTestStamp;
+    }
+
+    return true;
+}
+
+bool EventDispatcher::isHitTestCandidate(EventListener* listener) const
+{
+    auto touchListener = static_cast<EventListenerTouchOneByOne*>(listener);
+    return !touchListener->_hitTestByBounds || touchListener->_hitTestStamp == _hitTestStamp;
+}
+
 void EventDispatcher::addEventListener(EventListener* listener)
 {
     if (_inDispatch == 0)
@@ -906,6 +1117,11 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
             // second, for all camera call all listeners
             // get a copy of cameras, prevent it's been modified in listener callback
             // if camera's depth is greater, process it earlier
+            // a touch beginning is only dispatched to the indexed listeners whose bounds contain it
+            const bool useHitTestIndex = _hitTestTouch && !_hitTestEntries.empty();
+            if (useHitTestIndex)
+                updateHitTestIndex();
+
             auto cameras = scene->getCameras();
             for (auto rit = cameras.rbegin(), ritRend = cameras.rend(); rit != ritRend; ++rit)
             {
@@ -917,6 +1133,7 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
 
                 Camera::_visitingCamera = camera;
                 auto cameraFlag         = (unsigned short)camera->getCameraFlag();
+                const bool hitTested    = useHitTestIndex && queryHitTestIndex(_hitTestTouch, camera);
                 for (auto&& l : sceneListeners)
                 {
                     if (nullptr == l->getAssociatedNode() ||
@@ -924,6 +1141,10 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
                     {
                         continue;
                     }
+                    if (hitTested && !isHitTestCandidate(l))
+                    {
+                        continue;
+                    }
                     if (onEvent(l))
                     {
                         shouldStopPropagation = true;
@@ -1129,7 +1350,10 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
             };
 
             //
+            auto hitTestTouch = _hitTestTouch;
+            _hitTestTouch     = event->getEventCode() == EventTouch::EventCode::BEGAN ? touches : nullptr;
             dispatchTouchEventToListeners(oneByOneListeners, onTouchEvent);
+            _hitTestTouch = hitTestTouch;
             if (event->isStopped())
             {
                 return;
@@ -36,6 +36,7 @@
 #include "base/EventListener.h"
 #include "base/Event.h"
 #include "platform/StdC.h"
+#include "math/Rect.h"
 
 /**
  * @addtogroup base
@@ -49,6 +50,8 @@ class EventTouch;
 class Node;
 class EventCustom;
 class EventListenerCustom;
+class Camera;
+class Touch;
 
 /** @class EventDispatcher
 * @brief This class manages event listener subscriptions
@@ -208,10 +211,14 @@ public:
 
 protected:
     friend class Node;
+    friend class TransformHierarchy;
 
     /** Sets the dirty flag for a node. */
     void setDirtyForNode(Node* node);
 
+    /** Marks the hit test bounds of the node's listeners as outdated, called when its transform changed. */
+    void setHitTestDirtyForNode(Node* node);
+
     /**
      *  The vector to store event listeners with scene graph based priority and fixed priority.
      */
@@ -313,6 +320,34 @@ protected:
     /** Sets the dirty flag for a specified listener ID */
     void setDirty(std::string_view listenerID, DirtyFlag flag);
 
+    /** Adds or removes a listener which hit tests by the bounds of its node to the spatial index. */
+    void addToHitTestIndex(EventListener* listener);
+    void removeFromHitTestIndex(EventListener* listener);
+
+    /** Recomputes the bounds of the listeners whose nodes moved since the last touch. */
+    void updateHitTestIndex();
+
+    /** Stamps the indexed listeners whose bounds contain the touch as seen by camera, returns false if the
+     * touch doesn't hit the screen plane. */
+    bool queryHitTestIndex(const Touch* touch, const Camera* camera);
+
+    /** Whether listener should get the touch which is hit tested currently. */
+    bool isHitTestCandidate(EventListener* listener) const;
+
+    struct HitTestEntry
+    {
+        Rect bounds;
+        int minX       = 0;
+        int minY       = 0;
+        int maxX       = -1;
+        int maxY       = -1;
+        bool hasBounds = false;  ///< false if the node has no usable 2d bounds, it gets every touch then
+        bool aside     = false;  ///< kept in _hitTestUnbounded instead of the cells
+    };
+
+    void insertHitTestCells(EventListener* listener, HitTestEntry& entry);
+    void eraseHitTestCells(EventListener* listener, HitTestEntry& entry);
+
     /** Walks though scene graph to get the draw order for each node, it's called before sorting event listener with
      * scene graph priority */
     void visitTarget(Node* node, bool isRootNode);
@@ -352,6 +387,15 @@ protected:
 
     int _nodePriorityIndex;
 
+    /** Spatial index of the listeners which hit test by the bounds of their nodes: a uniform grid of world
+     * space cells, listeners without usable bounds are kept aside and always tested */
+    std::unordered_map<EventListener*, HitTestEntry> _hitTestEntries;
+    std::unordered_map<uint64_t, std::vector<EventListener*>> _hitTestCells;
+    std::vector<EventListener*> _hitTestUnbounded;
+    std::vector<Node*> _hitTestDirtyNodes;
+    const Touch* _hitTestTouch  = nullptr;  ///< the touch beginning, while dispatching it to one by one listeners
+    std::uint32_t _hitTestStamp = 0;
+
     std::set<std::string> _internalCustomListenerIDs;
 };
 
@@ -28,6 +28,8 @@
 
 NS_AX_BEGIN
 
+AX_POOL_ALLOCATED_IMPL(EventListener)
+
 EventListener::EventListener() {}
 
 EventListener::~EventListener()
@@ -32,6 +32,7 @@
 
 #include "platform/PlatformMacros.h"
 #include "base/Ref.h"
+#include "base/PoolAllocator.h"
 
 /**
  * @addtogroup base
@@ -52,6 +53,8 @@ class Node;
 class AX_DLL EventListener : public Ref
 {
 public:
+    AX_POOL_ALLOCATED_DECL(EventListener)
+
     /** Type Event type.*/
     enum class Type
     {
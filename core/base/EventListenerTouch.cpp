@@ -67,6 +67,12 @@ bool EventListenerTouchOneByOne::isSwallowTouches()
     return _needSwallow;
 }
 
+void EventListenerTouchOneByOne::setHitTestByBounds(bool hitTestByBounds)
+{
+    AXASSERT(!isRegistered(), "Can't change the hit test mode of an added listener");
+    _hitTestByBounds = hitTestByBounds;
+}
+
 EventListenerTouchOneByOne* EventListenerTouchOneByOne::create()
 {
     auto ret = new EventListenerTouchOneByOne();
@@ -106,8 +112,9 @@ EventListenerTouchOneByOne* EventListenerTouchOneByOne::clone()
         ret->onTouchEnded     = onTouchEnded;
         ret->onTouchCancelled = onTouchCancelled;
 
-        ret->_claimedTouches = _claimedTouches;
-        ret->_needSwallow    = _needSwallow;
+        ret->_claimedTouches  = _claimedTouches;
+        ret->_needSwallow     = _needSwallow;
+        ret->_hitTestByBounds = _hitTestByBounds;
     }
     else
     {
@@ -69,6 +69,22 @@ public:
      */
     bool isSwallowTouches();
 
+    /** Only dispatch touches which begin inside the bounding box of the associated node.
+     *
+     * The EventDispatcher keeps such listeners in a spatial index and doesn't call onTouchBegan for
+     * touches elsewhere, which makes screens with many touchable nodes cheap to dispatch. The bounding box is
+     * the one the node was last drawn with, nodes without content size or rotated out of the screen plane
+     * receive all touches. Has to be set before the listener is added.
+     *
+     * @param hitTestByBounds True to hit test by the bounds of the node.
+     */
+    void setHitTestByBounds(bool hitTestByBounds);
+    /** Whether only touches inside the bounds of the associated node are dispatched.
+     *
+     * @return True if hit testing by the bounds of the node.
+     */
+    bool isHitTestByBounds() const { return _hitTestByBounds; }
+
     /// Overrides
     virtual EventListenerTouchOneByOne* clone() override;
     virtual bool checkAvailable() override;
@@ -89,6 +105,8 @@ public:
 private:
     std::vector<Touch*> _claimedTouches;
     bool _needSwallow;
+    bool _hitTestByBounds       = false;
+    std::uint32_t _hitTestStamp = 0;  ///< equals the stamp of the dispatcher when hit by the current touch
 
     friend class EventDispatcher;
 };
@@ -0,0 +1,294 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "base/FrameProfiler.h"
+#include "platform/FileUtils.h"
+#include <algorithm>
+#include <stdio.h>
+
+NS_AX_BEGIN
+
+// the buffer of a thread, handed back to the profiler when the thread exits
+struct ThreadBufferSlot
+{
+    FrameProfiler::ThreadBuffer* buffer = nullptr;
+    const char* name                    = nullptr;  // the name of the thread until its buffer is allocated
+
+    ~ThreadBufferSlot()
+    {
+        if (buffer)
+            FrameProfiler::getInstance()->releaseThreadBuffer(buffer);
+    }
+};
+
+static thread_local ThreadBufferSlot s_threadBuffer;
+
+static void appendEscaped(std::string& json, const char* text)
+{
+    for (; *text; ++text)
+    {
+        unsigned char c = static_cast<unsigned char>(*text);
+        if (c == '"' || c == '\\')
+        {
+            json += '\\';
+            json += *text;
+        }
+        else if (c < 0x20)
+        {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", c);
+            json += code;
+        }
+        else
+            json += *text;
+    }
+}
+
+FrameProfiler* FrameProfiler::getInstance()
+{
+    // Leaked on purpose, worker threads may record zones while the process exits.
+    static FrameProfiler* instance = new FrameProfiler();
+    return instance;
+}
+
+FrameProfiler::FrameProfiler() : _eventsPerThread(16384), _epoch(Clock::now()) {}
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+FrameProfiler::ThreadBuffer* FrameProfiler::getThreadBuffer()
+{
+    auto buffer = s_threadBuffer.buffer;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        if (!_freeBuffers.empty())
+        {
+            // the events of the exited thread are dropped, its id is reused
+            buffer = _freeBuffers.back();
+            _freeBuffers.pop_back();
+        }
+        else
+        {
+            buffer     = new ThreadBuffer();
+            buffer->id = static_cast<unsigned int>(_buffers.size()) + 1;
+            _buffers.push_back(buffer);
+        }
+
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.resize(std::max<size_t>(_eventsPerThread, 1));
+        buffer->written  = 0;
+        buffer->streamed = 0;
+        buffer->name     = s_threadBuffer.name;
+
+        s_threadBuffer.buffer = buffer;
+    }
+    return buffer;
+}
+
+void FrameProfiler::releaseThreadBuffer(ThreadBuffer* buffer)
+{
+    // keeps the events in the trace until a new thread takes the buffer over
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    _freeBuffers.push_back(buffer);
+}
+
+void FrameProfiler::setThreadName(const char* name)
+{
+    s_threadBuffer.name = name;
+
+    auto buffer = s_threadBuffer.buffer;
+    if (buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->name = name;
+    }
+}
+
+void FrameProfiler::addEvent(const Event& event)
+{
+    auto buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->events[buffer->written % buffer->events.size()] = event;
+    ++buffer->written;
+}
+
+void FrameProfiler::addZone(const char* name, Clock::time_point start, Clock::time_point end)
+{
+    Event event;
+    event.name     = name;
+    event.start    = std::chrono::duration_cast<std::chrono::nanoseconds>(start - _epoch).count();
+    event.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    event.type     = EventType::ZONE;
+    addEvent(event);
+}
+
+void FrameProfiler::addCounter(const char* name, double value)
+{
+    Event event;
+    event.name  = name;
+    event.start = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _epoch).count();
+    event.value = value;
+    event.type  = EventType::COUNTER;
+    addEvent(event);
+}
+
+void FrameProfiler::markFrame()
+{
+    if (!isEnabled())
+        return;
+
+    Event event;
+    event.name     = "Frame";
+    event.start    = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _epoch).count();
+    event.duration = 0;
+    event.type     = EventType::FRAME;
+    addEvent(event);
+
+    FrameListener listener;
+    {
+        std::lock_guard<std::mutex> lock(_listenerMutex);
+        listener = _frameListener;
+    }
+    if (!listener)
+        return;
+
+    _frameJson.clear();
+    _frameJson += '[';
+    bool separator = false;
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        for (auto buffer : _buffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            appendEvents(_frameJson, *buffer, buffer->streamed, separator);
+            buffer->streamed = buffer->written;
+        }
+    }
+    _frameJson += "]\n";
+
+    // called without holding a lock, the listener may stop streaming itself
+    listener(_frameJson);
+}
+
+void FrameProfiler::setFrameListener(FrameListener listener)
+{
+    if (listener)
+    {
+        // only stream the events recorded from now on
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        for (auto buffer : _buffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->streamed = buffer->written;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_listenerMutex);
+    _frameListener = std::move(listener);
+}
+
+void FrameProfiler::appendEvents(std::string& json, ThreadBuffer& buffer, uint64_t first, bool& separator)
+{
+    const uint64_t capacity = buffer.events.size();
+    if (buffer.written > capacity)
+        first = std::max(first, buffer.written - capacity);
+
+    char text[128];
+    for (uint64_t i = first; i < buffer.written; ++i)
+    {
+        const Event& event = buffer.events[i % capacity];
+        if (separator)
+            json += ",\n";
+        separator = true;
+
+        json += "{\"name\":\"";
+        appendEscaped(json, event.name);
+        switch (event.type)
+        {
+        case EventType::ZONE:
+            snprintf(text, sizeof(text), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer.id,
+                     event.start / 1000.0, event.duration / 1000.0);
+            break;
+        case EventType::COUNTER:
+            snprintf(text, sizeof(text), "\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%g}}",
+                     buffer.id, event.start / 1000.0, event.value);
+            break;
+        case EventType::FRAME:
+            snprintf(text, sizeof(text), "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", buffer.id,
+                     event.start / 1000.0);
+            break;
+        }
+        json += text;
+    }
+}
+
+std::string FrameProfiler::toChromeTrace()
+{
+    std::string json = "{\"traceEvents\":[\n";
+    bool separator   = false;
+
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto buffer : _buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        if (buffer->name)
+        {
+            if (separator)
+                json += ",\n";
+            separator = true;
+
+            char text[64];
+            snprintf(text, sizeof(text), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,", buffer->id);
+            json += text;
+            json += "\"args\":{\"name\":\"";
+            appendEscaped(json, buffer->name);
+            json += "\"}}";
+        }
+        appendEvents(json, *buffer, 0, separator);
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return json;
+}
+
+bool FrameProfiler::writeChromeTrace(std::string_view path)
+{
+    return FileUtils::getInstance()->writeStringToFile(toChromeTrace(), path);
+}
+
+void FrameProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto buffer : _buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->written  = 0;
+        buffer->streamed = 0;
+    }
+}
+
+NS_AX_END
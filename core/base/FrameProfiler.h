@@ -0,0 +1,207 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_AX_BEGIN
+
+/**
+ * @class FrameProfiler
+ * @brief Scoped zone profiler for diagnosing hitches, exported as Chrome trace JSON.
+ *
+ * Every thread records its zones and counters into its own ring buffer, so recording doesn't contend between
+ * threads and only keeps the latest events. The Director records the phases of every frame and the texture and
+ * async task workers record their jobs. Open the exported file with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Recording is disabled by default, a zone costs a relaxed atomic load then. Set AX_ENABLE_FRAME_PROFILER to 0
+ * in Config.h to compile the zones out.
+ * @js NA
+ */
+class AX_DLL FrameProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** Receives the events of every frame as a JSON array of Chrome trace events, see setFrameListener. */
+    using FrameListener = std::function<void(std::string_view)>;
+
+    static FrameProfiler* getInstance();
+
+    /** Starts or stops recording, the buffered events are kept. */
+    void setEnabled(bool enabled);
+
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    /** Sets the number of events each thread keeps, applies to the threads recording their first event afterwards.
+     */
+    void setEventsPerThread(size_t count) { _eventsPerThread = count; }
+
+    size_t getEventsPerThread() const { return _eventsPerThread; }
+
+    /**
+     * Names the calling thread in the trace. name must outlive the profiler, like a string literal.
+     * The buffer of the thread is only allocated by its first event.
+     */
+    void setThreadName(const char* name);
+
+    /** Records a zone of the calling thread. name must outlive the profiler, like a string literal. */
+    void addZone(const char* name, Clock::time_point start, Clock::time_point end);
+
+    /** Records the value of a counter. name must outlive the profiler, like a string literal. */
+    void addCounter(const char* name, double value);
+
+    /** Marks the end of a frame, passes the events recorded since the last mark to the frame listener. */
+    void markFrame();
+
+    /**
+     * Streams the events of every frame, see markFrame. The listener is called on the axmol thread,
+     * nullptr stops streaming.
+     */
+    void setFrameListener(FrameListener listener);
+
+    /** Returns the buffered events of all threads as Chrome trace JSON. */
+    std::string toChromeTrace();
+
+    /** Writes the buffered events of all threads as Chrome trace JSON to path. */
+    bool writeChromeTrace(std::string_view path);
+
+    /** Drops the buffered events. */
+    void clear();
+
+private:
+    friend struct ThreadBufferSlot;
+
+    FrameProfiler();
+
+    enum class EventType : uint8_t
+    {
+        ZONE,
+        COUNTER,
+        FRAME,
+    };
+
+    struct Event
+    {
+        const char* name;
+        int64_t start;  // ns since the epoch of the profiler
+        union
+        {
+            int64_t duration;  // ns
+            double value;
+        };
+        EventType type;
+    };
+
+    struct ThreadBuffer
+    {
+        std::mutex mutex;  // only contended while the events are read
+        std::vector<Event> events;
+        uint64_t written  = 0;  // events ever written, the ring position is written % events.size()
+        uint64_t streamed = 0;  // events passed to the frame listener
+        const char* name  = nullptr;
+        unsigned int id   = 0;
+    };
+
+    ThreadBuffer* getThreadBuffer();
+    void releaseThreadBuffer(ThreadBuffer* buffer);
+    void addEvent(const Event& event);
+    void appendEvents(std::string& json, ThreadBuffer& buffer, uint64_t first, bool& separator);
+
+    std::atomic<bool> _enabled{false};
+    size_t _eventsPerThread;
+    Clock::time_point _epoch;
+
+    std::mutex _buffersMutex;
+    std::vector<ThreadBuffer*> _buffers;      // never freed, threads may record until the process exits
+    std::vector<ThreadBuffer*> _freeBuffers;  // buffers of exited threads, taken over by new threads
+
+    std::mutex _listenerMutex;
+    FrameListener _frameListener;
+    std::string _frameJson;
+};
+
+/**
+ * Records the lifetime of the scope as a zone, see AX_PROFILE_ZONE.
+ * @js NA
+ */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name) : _name(FrameProfiler::getInstance()->isEnabled() ? name : nullptr)
+    {
+        if (_name)
+            _start = FrameProfiler::Clock::now();
+    }
+
+    ~ProfileZone()
+    {
+        if (_name)
+            FrameProfiler::getInstance()->addZone(_name, _start, FrameProfiler::Clock::now());
+    }
+
+private:
+    const char* _name;
+    FrameProfiler::Clock::time_point _start;
+};
+
+NS_AX_END
+
+#if AX_ENABLE_FRAME_PROFILER
+#    define AX_PROFILE_ZONE_CONCAT2(a, b) a##b
+#    define AX_PROFILE_ZONE_CONCAT(a, b) AX_PROFILE_ZONE_CONCAT2(a, b)
+/** Records the rest of the enclosing scope as a zone named by the string literal name. */
+#    define AX_PROFILE_ZONE(name) ax::ProfileZone AX_PROFILE_ZONE_CONCAT(_profileZone, __LINE__)(name)
+/** Records the value of a counter named by the string literal name. */
+#    define AX_PROFILE_COUNTER(name, value)                             \
+        do                                                              \
+        {                                                               \
+            auto profiler = ax::FrameProfiler::getInstance();           \
+            if (profiler->isEnabled())                                  \
+                profiler->addCounter(name, static_cast<double>(value)); \
+        } while (0)
+#    define AX_PROFILE_THREAD_NAME(name) ax::FrameProfiler::getInstance()->setThreadName(name)
+#    define AX_PROFILE_FRAME_MARK() ax::FrameProfiler::getInstance()->markFrame()
+#else
+#    define AX_PROFILE_ZONE(name)
+#    define AX_PROFILE_COUNTER(name, value)
+#    define AX_PROFILE_THREAD_NAME(name)
+#    define AX_PROFILE_FRAME_MARK()
+#endif
+
+// end of base group
+/** @} */
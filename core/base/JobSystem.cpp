@@ -0,0 +1,239 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/JobSystem.h"
+#include "base/FrameProfiler.h"
+#include "concurrentqueue/concurrentqueue.h"
+#include <algorithm>
+
+NS_AX_BEGIN
+
+class JobSystem::Job
+{
+public:
+    std::function<void()> task;
+    Priority priority = Priority::NORMAL;
+
+    // unfinished dependencies, +1 held by schedule() until all dependencies are registered
+    std::atomic<int> pendingDependencies{1};
+    std::atomic<bool> done{false};
+
+    std::mutex continuationMutex;
+    std::vector<JobHandle> continuations;
+};
+
+struct JobSystem::Worker
+{
+    moodycamel::ConcurrentQueue<JobHandle> queues[static_cast<int>(Priority::COUNT)];
+    std::thread thread;
+};
+
+// index of the worker owning the current thread, jobs scheduled by a job stay on the same worker
+static thread_local int s_workerIndex = -1;
+
+JobSystem* JobSystem::s_jobSystem = nullptr;
+
+JobSystem* JobSystem::getInstance()
+{
+    if (s_jobSystem == nullptr)
+    {
+        s_jobSystem = new JobSystem();
+    }
+    return s_jobSystem;
+}
+
+void JobSystem::destroyInstance()
+{
+    delete s_jobSystem;
+    s_jobSystem = nullptr;
+}
+
+JobSystem::JobSystem(unsigned int workerCount)
+{
+    if (workerCount == 0)
+    {
+        // leave one core to the axmol thread, keep at least the 2 threads of the old task pool
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = std::clamp(hardwareThreads > 1 ? hardwareThreads - 1 : 1u, 2u, 16u);
+    }
+
+    _workerCount = workerCount;
+    _workers.reset(new Worker[_workerCount]);
+    for (unsigned int i = 0; i < _workerCount; ++i)
+        _workers[i].thread = std::thread(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _sleepCondition.notify_all();
+
+    for (unsigned int i = 0; i < _workerCount; ++i)
+    {
+        if (_workers[i].thread.joinable())
+            _workers[i].thread.join();
+    }
+
+    // run the jobs left in the queues, their continuations are queued and run here too, so every wait returns
+    JobHandle job;
+    while (tryPop(0, job))
+    {
+        execute(job);
+        job.reset();
+    }
+}
+
+JobSystem::JobHandle JobSystem::schedule(std::function<void()> task, Priority priority)
+{
+    return schedule(std::move(task), {}, priority);
+}
+
+JobSystem::JobHandle JobSystem::schedule(std::function<void()> task,
+                                         std::initializer_list<JobHandle> dependencies,
+                                         Priority priority)
+{
+    auto job      = std::make_shared<Job>();
+    job->task     = std::move(task);
+    job->priority = priority;
+
+    for (auto&& dependency : dependencies)
+    {
+        if (!dependency)
+            continue;
+
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (dependency->done)
+            continue;
+        ++job->pendingDependencies;
+        dependency->continuations.emplace_back(job);
+    }
+
+    release(job);
+    return job;
+}
+
+void JobSystem::wait(const JobHandle& job)
+{
+    const auto index = s_workerIndex >= 0 ? static_cast<unsigned int>(s_workerIndex) : 0u;
+    JobHandle other;
+    while (!isDone(job))
+    {
+        if (tryPop(index, other))
+        {
+            execute(other);
+            other.reset();
+        }
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::isDone(const JobHandle& job)
+{
+    return !job || job->done.load(std::memory_order_acquire);
+}
+
+void JobSystem::release(const JobHandle& job)
+{
+    if (--job->pendingDependencies == 0)
+        submit(job);
+}
+
+void JobSystem::submit(const JobHandle& job)
+{
+    const auto index =
+        s_workerIndex >= 0 ? static_cast<unsigned int>(s_workerIndex) : _nextWorker++ % _workerCount;
+    _workers[index].queues[static_cast<int>(job->priority)].enqueue(job);
+
+    ++_queuedJobs;
+    {
+        // pairs with the predicate check of the sleeping workers, so the notification can't be lost
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _sleepCondition.notify_one();
+}
+
+void JobSystem::execute(const JobHandle& job)
+{
+    {
+        AX_PROFILE_ZONE("JobSystem::execute");
+        job->task();
+    }
+    job->task = nullptr;
+
+    std::vector<JobHandle> continuations;
+    {
+        std::lock_guard<std::mutex> lock(job->continuationMutex);
+        job->done.store(true, std::memory_order_release);
+        continuations.swap(job->continuations);
+    }
+
+    for (auto&& continuation : continuations)
+        release(continuation);
+}
+
+bool JobSystem::tryPop(unsigned int index, JobHandle& job)
+{
+    for (int priority = 0; priority < static_cast<int>(Priority::COUNT); ++priority)
+    {
+        // own queue first, then steal from the others
+        for (unsigned int i = 0; i < _workerCount; ++i)
+        {
+            auto& queue = _workers[(index + i) % _workerCount].queues[priority];
+            if (queue.try_dequeue(job))
+            {
+                --_queuedJobs;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(unsigned int index)
+{
+    s_workerIndex = static_cast<int>(index);
+    AX_PROFILE_THREAD_NAME("JobSystem worker");
+
+    JobHandle job;
+    for (;;)
+    {
+        if (tryPop(index, job))
+        {
+            execute(job);
+            job.reset();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepCondition.wait(lock, [this] { return _stop || _queuedJobs > 0; });
+        if (_stop)
+            return;
+    }
+}
+
+NS_AX_END
@@ -0,0 +1,144 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_AX_BEGIN
+
+/**
+ * @class JobSystem
+ * @brief Engine wide pool of worker threads sized to the hardware.
+ *
+ * Every worker owns one lock-free queue per priority, idle workers steal from the queues of the
+ * others. Jobs can depend on other jobs and only become runnable once all of them finished, which
+ * also gives continuations: `then(job, task)`.
+ * Jobs run off the axmol thread, use `Scheduler::runOnAxmolThread` to get back to it.
+ * @js NA
+ */
+class AX_DLL JobSystem
+{
+public:
+    enum class Priority
+    {
+        HIGH,
+        NORMAL,
+        LOW,
+        COUNT,
+    };
+
+    class Job;
+    using JobHandle = std::shared_ptr<Job>;
+
+    /**
+     * Returns the shared instance of the job system, the workers are started on first use.
+     */
+    static JobSystem* getInstance();
+
+    /**
+     * Destroys the job system. The jobs not started yet run on the calling thread once the workers stopped.
+     */
+    static void destroyInstance();
+
+    /**
+     * Schedule a job.
+     *
+     * @param task The work to perform off thread.
+     * @param priority Workers always pick higher priority jobs first.
+     * @return A handle to wait for the job or to schedule dependent jobs.
+     */
+    JobHandle schedule(std::function<void()> task, Priority priority = Priority::NORMAL);
+
+    /**
+     * Schedule a job which only starts after all dependencies finished.
+     * Null handles in dependencies are ignored.
+     */
+    JobHandle schedule(std::function<void()> task,
+                       std::initializer_list<JobHandle> dependencies,
+                       Priority priority = Priority::NORMAL);
+
+    /**
+     * Schedule a continuation of job.
+     */
+    JobHandle then(const JobHandle& job, std::function<void()> task, Priority priority = Priority::NORMAL)
+    {
+        return schedule(std::move(task), {job}, priority);
+    }
+
+    /**
+     * Block until job finished, the calling thread runs other queued jobs meanwhile.
+     */
+    void wait(const JobHandle& job);
+
+    /**
+     * Check whether job finished.
+     */
+    static bool isDone(const JobHandle& job);
+
+    /**
+     * Get the number of worker threads.
+     */
+    unsigned int getWorkerCount() const { return _workerCount; }
+
+    JobSystem(unsigned int workerCount = 0);
+    ~JobSystem();
+
+protected:
+    struct Worker;
+
+    void submit(const JobHandle& job);
+    void release(const JobHandle& job);
+    void execute(const JobHandle& job);
+    bool tryPop(unsigned int index, JobHandle& job);
+    void workerLoop(unsigned int index);
+
+    std::unique_ptr<Worker[]> _workers;
+    unsigned int _workerCount = 0;
+    std::atomic<unsigned int> _nextWorker{0};
+
+    // workers sleep when there's nothing to run
+    std::atomic<int> _queuedJobs{0};
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    std::atomic<bool> _stop{false};
+
+    static JobSystem* s_jobSystem;
+};
+
+NS_AX_END
+// end group
+/// @}
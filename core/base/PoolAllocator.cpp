@@ -0,0 +1,301 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "base/PoolAllocator.h"
+#include <algorithm>
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+
+NS_AX_BEGIN
+
+namespace allocator
+{
+
+static constexpr size_t PAGE_SIZE = 64 * 1024;
+
+// 16 bytes apart up to 512 bytes, 128 bytes apart up to PoolAllocator::MAX_POOLED_SIZE
+static constexpr size_t SMALL_CLASS_STEP  = 16;
+static constexpr size_t SMALL_CLASS_LIMIT = 512;
+static constexpr size_t LARGE_CLASS_STEP  = 128;
+static constexpr size_t SMALL_CLASS_COUNT = SMALL_CLASS_LIMIT / SMALL_CLASS_STEP;
+static constexpr size_t SIZE_CLASS_COUNT =
+    SMALL_CLASS_COUNT + (PoolAllocator::MAX_POOLED_SIZE - SMALL_CLASS_LIMIT) / LARGE_CLASS_STEP;
+
+// pages and blocks sizes are multiples of the alignment, so every block of an aligned page stays aligned
+static constexpr std::align_val_t POOL_ALIGNMENT{PoolAllocator::ALIGNMENT};
+static_assert(PAGE_SIZE % PoolAllocator::ALIGNMENT == 0, "pages must keep the block alignment");
+static_assert(SMALL_CLASS_STEP % PoolAllocator::ALIGNMENT == 0 && LARGE_CLASS_STEP % PoolAllocator::ALIGNMENT == 0,
+              "block sizes must be rounded up to the alignment");
+
+struct PoolAllocator::SizeClass
+{
+    std::mutex mutex;
+    void* freeList = nullptr;  // the first bytes of a free block point to the next free block
+    std::vector<char*> pages;
+    size_t blockCount     = 0;
+    size_t blocksInUse    = 0;
+    size_t peakInUse      = 0;
+    size_t requestedBytes = 0;  // bytes requested by the blocks in use, the rest of the blocks is internal waste
+};
+
+TypeStats::TypeStats(const char* typeName) : name(typeName)
+{
+    PoolAllocator::getInstance()->registerType(*this);
+}
+
+PoolAllocator* PoolAllocator::getInstance()
+{
+    // never destroyed, pooled objects may be released by static destructors
+    static PoolAllocator* instance = new PoolAllocator();
+    return instance;
+}
+
+PoolAllocator::PoolAllocator() : _sizeClasses(new SizeClass[SIZE_CLASS_COUNT]) {}
+
+size_t PoolAllocator::getSizeClassIndex(size_t size)
+{
+    if (size <= SMALL_CLASS_LIMIT)
+        return (std::max(size, size_t(1)) - 1) / SMALL_CLASS_STEP;
+    return SMALL_CLASS_COUNT + (size - SMALL_CLASS_LIMIT - 1) / LARGE_CLASS_STEP;
+}
+
+size_t PoolAllocator::getBlockSize(size_t index)
+{
+    if (index < SMALL_CLASS_COUNT)
+        return (index + 1) * SMALL_CLASS_STEP;
+    return SMALL_CLASS_LIMIT + (index - SMALL_CLASS_COUNT + 1) * LARGE_CLASS_STEP;
+}
+
+void PoolAllocator::registerType(TypeStats& stats)
+{
+    stats.next = _types.load(std::memory_order_relaxed);
+    while (!_types.compare_exchange_weak(stats.next, &stats, std::memory_order_release, std::memory_order_relaxed))
+        ;
+}
+
+void* PoolAllocator::allocate(size_t size, TypeStats& stats)
+{
+    return allocateBlock(size, stats, false);
+}
+
+void* PoolAllocator::allocate(size_t size, TypeStats& stats, const std::nothrow_t&) noexcept
+{
+    return allocateBlock(size, stats, true);
+}
+
+void* PoolAllocator::allocateBlock(size_t size, TypeStats& stats, bool nothrow)
+{
+    void* ptr = nullptr;
+    if (size > MAX_POOLED_SIZE)
+    {
+        ptr = nothrow ? ::operator new(size, POOL_ALIGNMENT, std::nothrow) : ::operator new(size, POOL_ALIGNMENT);
+    }
+    else
+    {
+        const auto index     = getSizeClassIndex(size);
+        const auto blockSize = getBlockSize(index);
+        auto& sizeClass      = _sizeClasses[index];
+
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (!sizeClass.freeList)
+        {
+            if (sizeClass.pages.size() == sizeClass.pages.capacity())
+                sizeClass.pages.reserve(std::max(sizeClass.pages.size() * 2, size_t(4)));
+
+            auto page = static_cast<char*>(nothrow ? ::operator new(PAGE_SIZE, POOL_ALIGNMENT, std::nothrow)
+                                                   : ::operator new(PAGE_SIZE, POOL_ALIGNMENT));
+            if (!page)
+                return nullptr;
+            sizeClass.pages.emplace_back(page);
+
+            // thread the blocks of the page, the first block ends up at the head
+            const auto blocksPerPage = PAGE_SIZE / blockSize;
+            for (size_t i = blocksPerPage; i-- > 0;)
+            {
+                auto block         = page + i * blockSize;
+                *(void**)block     = sizeClass.freeList;
+                sizeClass.freeList = block;
+            }
+            sizeClass.blockCount += blocksPerPage;
+        }
+
+        ptr                 = sizeClass.freeList;
+        sizeClass.freeList  = *(void**)ptr;
+        sizeClass.peakInUse = std::max(sizeClass.peakInUse, ++sizeClass.blocksInUse);
+        sizeClass.requestedBytes += size;
+    }
+
+    if (ptr)
+    {
+        ++stats.totalCount;
+        const auto live = ++stats.liveCount;
+        auto peak       = stats.peakCount.load(std::memory_order_relaxed);
+        while (peak < live && !stats.peakCount.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+    }
+    return ptr;
+}
+
+void PoolAllocator::deallocate(void* ptr, size_t size, TypeStats& stats)
+{
+    if (!ptr)
+        return;
+
+    --stats.liveCount;
+
+    if (size > MAX_POOLED_SIZE)
+    {
+        ::operator delete(ptr, POOL_ALIGNMENT);
+        return;
+    }
+
+    auto& sizeClass = _sizeClasses[getSizeClassIndex(size)];
+
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    *(void**)ptr       = sizeClass.freeList;
+    sizeClass.freeList = ptr;
+    --sizeClass.blocksInUse;
+    sizeClass.requestedBytes -= size;
+}
+
+void PoolAllocator::deallocate(void* ptr, TypeStats& stats)
+{
+    if (!ptr)
+        return;
+
+    auto address = static_cast<char*>(ptr);
+    for (size_t index = 0; index < SIZE_CLASS_COUNT; ++index)
+    {
+        auto& sizeClass = _sizeClasses[index];
+
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        auto pageIt = std::find_if(sizeClass.pages.begin(), sizeClass.pages.end(),
+                                   [address](char* page) { return address >= page && address < page + PAGE_SIZE; });
+        if (pageIt != sizeClass.pages.end())
+        {
+            --stats.liveCount;
+            *(void**)ptr       = sizeClass.freeList;
+            sizeClass.freeList = ptr;
+            --sizeClass.blocksInUse;
+            // the requested size is unknown, assume the whole block was
+            sizeClass.requestedBytes -= std::min(sizeClass.requestedBytes, getBlockSize(index));
+            return;
+        }
+    }
+
+    --stats.liveCount;
+    ::operator delete(ptr, POOL_ALIGNMENT);
+}
+
+size_t PoolAllocator::getBlocksInUse() const
+{
+    size_t count = 0;
+    for (size_t index = 0; index < SIZE_CLASS_COUNT; ++index)
+    {
+        auto& sizeClass = _sizeClasses[index];
+
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        count += sizeClass.blocksInUse;
+    }
+    return count;
+}
+
+size_t PoolAllocator::getReservedBytes() const
+{
+    size_t pages = 0;
+    for (size_t index = 0; index < SIZE_CLASS_COUNT; ++index)
+    {
+        auto& sizeClass = _sizeClasses[index];
+
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        pages += sizeClass.pages.size();
+    }
+    return pages * PAGE_SIZE;
+}
+
+std::string PoolAllocator::getInfo() const
+{
+    std::string buffer;
+    char buftmp[256];
+
+    size_t totalPages = 0;
+    size_t totalInUse = 0;
+    size_t totalWaste = 0;
+    buffer += "size class  pages    in use  capacity      peak  utilization  internal waste\n";
+    for (size_t index = 0; index < SIZE_CLASS_COUNT; ++index)
+    {
+        auto& sizeClass = _sizeClasses[index];
+
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (sizeClass.pages.empty())
+            continue;
+
+        const auto blockSize = getBlockSize(index);
+        const auto waste     = sizeClass.blocksInUse * blockSize - sizeClass.requestedBytes;
+        totalPages += sizeClass.pages.size();
+        totalInUse += sizeClass.blocksInUse * blockSize;
+        totalWaste += waste;
+
+        snprintf(buftmp, sizeof(buftmp), "%9zuB  %5zu  %8zu  %8zu  %8zu  %10.1f%%  %12zu B\n", blockSize,
+                 sizeClass.pages.size(), sizeClass.blocksInUse, sizeClass.blockCount, sizeClass.peakInUse,
+                 100.0 * sizeClass.blocksInUse / sizeClass.blockCount, waste);
+        buffer += buftmp;
+    }
+
+    // the free blocks of the pages are the external fragmentation, the rounding up to the block size the internal
+    const auto reserved = totalPages * PAGE_SIZE;
+    snprintf(buftmp, sizeof(buftmp),
+             "Pool allocator: %zu KB reserved in %zu pages, %zu KB in use (%.1f%% fragmentation), %zu KB internal "
+             "waste\n",
+             reserved / 1024, totalPages, totalInUse / 1024,
+             reserved ? 100.0 * (reserved - totalInUse) / reserved : 0.0, totalWaste / 1024);
+    buffer += buftmp;
+
+    buffer += "type                          live      peak       total\n";
+    for (auto stats = _types.load(std::memory_order_acquire); stats; stats = stats->next)
+    {
+        snprintf(buftmp, sizeof(buftmp), "%-24s  %8zu  %8zu  %10zu\n", stats->name, stats->liveCount.load(),
+                 stats->peakCount.load(), stats->totalCount.load());
+        buffer += buftmp;
+    }
+
+    return buffer;
+}
+
+AllocatorDiagnostics* AllocatorDiagnostics::instance()
+{
+    static AllocatorDiagnostics diagnostics;
+    return &diagnostics;
+}
+
+std::string AllocatorDiagnostics::diagnostics() const
+{
+    return PoolAllocator::getInstance()->getInfo();
+}
+
+}  // namespace allocator
+
+NS_AX_END
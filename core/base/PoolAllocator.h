@@ -0,0 +1,196 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_AX_BEGIN
+
+namespace allocator
+{
+
+/**
+ * Allocation statistics of a type which opted into the pool allocator, subclasses are counted with it.
+ */
+struct AX_DLL TypeStats
+{
+    explicit TypeStats(const char* typeName);
+
+    const char* name;
+    std::atomic<size_t> liveCount{0};   ///< objects alive
+    std::atomic<size_t> peakCount{0};   ///< most objects alive at once
+    std::atomic<size_t> totalCount{0};  ///< objects ever allocated
+    TypeStats* next = nullptr;
+};
+
+/**
+ * @class PoolAllocator
+ * @brief Size class pool for small engine objects which are created and destroyed a lot.
+ *
+ * Requests up to MAX_POOLED_SIZE bytes are rounded up to a size class, 16 bytes apart up to 512 bytes and
+ * 128 bytes apart above. Every size class carves its blocks from 64KB pages and keeps the freed blocks in a
+ * free list, so allocating and freeing is a pop and a push under the lock of the size class. Pages are kept
+ * for the lifetime of the process. Larger requests go to the global heap.
+ *
+ * Every block is aligned to ALIGNMENT, enough for the alignas(16) Mat4 members of the pooled types, also on the
+ * 32-bit targets whose default new alignment is 8.
+ *
+ * Types opt in with AX_POOL_ALLOCATED_DECL in their class body and AX_POOL_ALLOCATED_IMPL in their source file,
+ * the operators are inherited, so subclasses allocate from the pool as well and are counted with the type.
+ */
+class AX_DLL PoolAllocator
+{
+public:
+    static constexpr size_t MAX_POOLED_SIZE = 4096;
+    static constexpr size_t ALIGNMENT       = 16;
+
+    static PoolAllocator* getInstance();
+
+    void* allocate(size_t size, TypeStats& stats);
+    void* allocate(size_t size, TypeStats& stats, const std::nothrow_t&) noexcept;
+
+    /** size must be the one passed to allocate, like the sized operator delete gets it. */
+    void deallocate(void* ptr, size_t size, TypeStats& stats);
+
+    /** Looks up the size class of ptr in the pages, only for the rare frees without the size. */
+    void deallocate(void* ptr, TypeStats& stats);
+
+    /** Number of blocks in use, of all size classes. */
+    size_t getBlocksInUse() const;
+
+    /** Bytes reserved by the pages of all size classes. */
+    size_t getReservedBytes() const;
+
+    /** Per size class and per type statistics, as printed by the allocator console command. */
+    std::string getInfo() const;
+
+private:
+    friend struct TypeStats;
+
+    PoolAllocator();
+
+    struct SizeClass;
+
+    static size_t getSizeClassIndex(size_t size);
+    static size_t getBlockSize(size_t index);
+
+    void* allocateBlock(size_t size, TypeStats& stats, bool nothrow);
+    void registerType(TypeStats& stats);
+
+    std::unique_ptr<SizeClass[]> _sizeClasses;
+    std::atomic<TypeStats*> _types{nullptr};
+};
+
+/**
+ * @class AllocatorDiagnostics
+ * @brief Reports of the engine allocators.
+ */
+class AX_DLL AllocatorDiagnostics
+{
+public:
+    static AllocatorDiagnostics* instance();
+
+    /** Returns the statistics of all allocators. */
+    std::string diagnostics() const;
+};
+
+}  // namespace allocator
+
+NS_AX_END
+
+#if AX_USE_POOL_ALLOCATOR
+/** Declares the class level operator new and delete of TYPE, which allocate from the PoolAllocator. Put it in the
+ * public section of the class. */
+#    define AX_POOL_ALLOCATED_DECL(TYPE)                                                                  \
+        static void* operator new(std::size_t size);                                                      \
+        static void* operator new(std::size_t size, const std::nothrow_t&) noexcept;                      \
+        static void* operator new(std::size_t size, std::align_val_t);                                    \
+        static void* operator new(std::size_t size, std::align_val_t, const std::nothrow_t&) noexcept;    \
+        static void* operator new(std::size_t, void* where) noexcept { return where; }                    \
+        static void operator delete(void* ptr, std::size_t size);                                         \
+        static void operator delete(void* ptr, const std::nothrow_t&) noexcept;                           \
+        static void operator delete(void* ptr, std::size_t size, std::align_val_t);                       \
+        static void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept;         \
+        static void operator delete(void*, void*) noexcept {}                                             \
+        static ax::allocator::TypeStats& getPoolTypeStats();
+
+/** Defines the class level operator new and delete of TYPE declared by AX_POOL_ALLOCATED_DECL. */
+#    define AX_POOL_ALLOCATED_IMPL(TYPE)                                                                          \
+        static_assert(alignof(TYPE) <= ax::allocator::PoolAllocator::ALIGNMENT,                                   \
+                      #TYPE " is aligned stricter than the pool blocks");                                         \
+        ax::allocator::TypeStats& TYPE::getPoolTypeStats()                                                        \
+        {                                                                                                         \
+            static ax::allocator::TypeStats stats(#TYPE);                                                         \
+            return stats;                                                                                         \
+        }                                                                                                         \
+        void* TYPE::operator new(std::size_t size)                                                                \
+        {                                                                                                         \
+            return ax::allocator::PoolAllocator::getInstance()->allocate(size, getPoolTypeStats());               \
+        }                                                                                                         \
+        void* TYPE::operator new(std::size_t size, const std::nothrow_t&) noexcept                                \
+        {                                                                                                         \
+            return ax::allocator::PoolAllocator::getInstance()->allocate(size, getPoolTypeStats(), std::nothrow); \
+        }                                                                                                         \
+        void* TYPE::operator new(std::size_t size, std::align_val_t)                                              \
+        {                                                                                                         \
+            return ax::allocator::PoolAllocator::getInstance()->allocate(size, getPoolTypeStats());               \
+        }                                                                                                         \
+        void* TYPE::operator new(std::size_t size, std::align_val_t, const std::nothrow_t&) noexcept              \
+        {                                                                                                         \
+            return ax::allocator::PoolAllocator::getInstance()->allocate(size, getPoolTypeStats(), std::nothrow); \
+        }                                                                                                         \
+        void TYPE::operator delete(void* ptr, std::size_t size)                                                   \
+        {                                                                                                         \
+            ax::allocator::PoolAllocator::getInstance()->deallocate(ptr, size, getPoolTypeStats());               \
+        }                                                                                                         \
+        void TYPE::operator delete(void* ptr, const std::nothrow_t&) noexcept                                     \
+        {                                                                                                         \
+            ax::allocator::PoolAllocator::getInstance()->deallocate(ptr, getPoolTypeStats());                     \
+        }                                                                                                         \
+        void TYPE::operator delete(void* ptr, std::size_t size, std::align_val_t)                                 \
+        {                                                                                                         \
+            ax::allocator::PoolAllocator::getInstance()->deallocate(ptr, size, getPoolTypeStats());               \
+        }                                                                                                         \
+        void TYPE::operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept                   \
+        {                                                                                                         \
+            ax::allocator::PoolAllocator::getInstance()->deallocate(ptr, getPoolTypeStats());                     \
+        }
+#else
+#    define AX_POOL_ALLOCATED_DECL(TYPE)
+#    define AX_POOL_ALLOCATED_IMPL(TYPE)
+#endif
+
+// end of base group
+/** @} */
@@ -45,6 +45,7 @@ static void untrackRef(Ref* ref);
 
 Ref::Ref()
     : _referenceCount(1)  // when the Ref is created, the reference count of it is 1
+    , _autoreleaseIndex(0)
 #if AX_ENABLE_SCRIPT_BINDING
     , _luaID(0)
     , _scriptObject(nullptr)
@@ -81,6 +82,12 @@ Ref::~Ref()
 void Ref::retain()
 {
     AXASSERT(_referenceCount > 0, "reference count should be greater than 0");
+
+    // The only reference is the pending release of the current pool, take it over instead of
+    // paying for the release when the pool is cleared
+    if (_referenceCount == 1 && _autoreleaseIndex != 0 && PoolManager::getInstance()->getCurrentPool()->reclaim(this))
+        return;
+
     ++_referenceCount;
 }
 
@@ -135,6 +135,8 @@ public:
 protected:
     /// count of references
     unsigned int _referenceCount;
+    /// position + 1 of the latest pending release in the current autorelease pool, 0 if there is none
+    unsigned int _autoreleaseIndex;
 
     friend class AutoreleasePool;
 
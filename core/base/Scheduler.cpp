@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include "base/Macros.h"
 #include "base/Director.h"
 #include "base/ScriptSupport.h"
+#include "concurrentqueue/concurrentqueue.h"
+#include <chrono>
 
 NS_AX_BEGIN
 
@@ -214,6 +216,18 @@ const int Scheduler::PRIORITY_SYSTEM = INT_MIN;
 // Minimum priority level for user scheduling.
 const int Scheduler::PRIORITY_NON_SYSTEM_MIN = PRIORITY_SYSTEM + 1;
 
+struct Scheduler::PendingAction
+{
+    std::function<void()> action;
+    std::chrono::steady_clock::time_point posted;
+};
+
+// lock free multi producer queue, the blocks of elements are recycled, so posting doesn't allocate in the steady state
+struct Scheduler::PendingActionQueue
+{
+    moodycamel::ConcurrentQueue<PendingAction> queue;
+};
+
 Scheduler::Scheduler()
     : _timeScale(1.0f)
     , _currentTarget(nullptr)
@@ -222,14 +236,17 @@ Scheduler::Scheduler()
 #if AX_ENABLE_SCRIPT_BINDING
     , _scriptHandlerEntries(20)
 #endif
-{
-    // I don't expect to have more than 30 functions to all per frame
-    _actionsToPerform.reserve(30);
-}
+    , _pendingActions(new PendingActionQueue())
+{}
 
 Scheduler::~Scheduler()
 {
     unscheduleAll();
+
+    for (auto&& entry : _timerQueue)
+        entry.timer->release();
+    for (auto&& entry : _startingTimers)
+        entry.timer->release();
 }
 
 void Scheduler::schedule(const ccSchedulerFunc& callback,
@@ -258,14 +275,16 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
         timerIt = _timersMap.emplace(target, TimerHandle{}).first;
 
         // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        timerIt->second.paused = paused;
+        timerIt->second.paused   = paused;
+        timerIt->second.pausedAt = _timerTime;
     }
     else
     {
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused!");
     }
 
-    auto& timers = timerIt->second.timers;
+    auto& timerHandle = timerIt->second;
+    auto& timers      = timerHandle.timers;
     if (timers.empty())
     {
         timers.reserve(10);
@@ -281,6 +300,7 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
             AXLOG("Scheduler#schedule. Reiniting timer with interval %.4f, repeat %u, delay %.4f", interval, repeat,
                   delay);
             (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            queueTimer(*timerIt, target, timerHandle);
             return;
         }
     }
@@ -288,6 +308,7 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     TimerTargetCallback* timer = new TimerTargetCallback();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
     timers.pushBack(timer);
+    queueTimer(timer, target, timerHandle);
     timer->release();
 }
 
@@ -312,8 +333,10 @@ void Scheduler::unschedule(std::string_view key, void* target)
                 if (timer == timerHandle.currentTimer && (!timer->isAborted()))
                 {
                     timer->retain();
-                    timer->setAborted();
                 }
+                // the entry of the timer in the timer queue is released on the next compaction
+                timer->setAborted();
+                dropQueuedTimer(timer);
 
                 timerHandle.timers.erase(i);
 
@@ -560,6 +583,11 @@ void Scheduler::unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::i
         timerHandle.currentTimer->retain();
         timerHandle.currentTimer->setAborted();
     }
+    for (auto&& timer : timerHandle.timers)
+    {
+        timer->setAborted();
+        dropQueuedTimer(timer);
+    }
     timerHandle.timers.clear();
 
     if (_currentTarget == &timerHandle)
@@ -606,7 +634,7 @@ void Scheduler::resumeTarget(void* target)
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
-        timerIt->second.paused = false;
+        setTimersPaused(target, timerIt->second, false);
     }
 
     // update selector
@@ -625,7 +653,7 @@ void Scheduler::pauseTarget(void* target)
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
-        timerIt->second.paused = false;
+        setTimersPaused(target, timerIt->second, false);
     }
 
     // update selector
@@ -669,7 +697,7 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     // Custom Selectors
     for (auto& [target, timerHandle] : _timersMap)
     {
-        timerHandle.paused = true;
+        setTimersPaused(target, timerHandle, true);
         idsWithSelectors.insert(target);
     }
 
@@ -715,16 +743,197 @@ void Scheduler::resumeTargets(const std::set<void*>& targetsToResume)
     }
 }
 
+static bool timerQueueEntryAfter(const TimerQueueEntry& lhs, const TimerQueueEntry& rhs)
+{
+    return lhs.time > rhs.time;
+}
+
+void Scheduler::queueTimer(Timer* timer, void* target, TimerHandle& timerHandle)
+{
+    // entries queued before are stale now
+    dropQueuedTimer(timer);
+    ++timer->_queueGeneration;
+    timer->_queued = true;
+    timer->retain();
+
+    if (timer->_elapsed == -1)
+    {
+        // starts counting at the next update, like Timer::update does for its first update
+        _startingTimers.emplace_back(TimerQueueEntry{0, timer, target, timer->_queueGeneration});
+        return;
+    }
+
+    // the time the timer triggers next, if _interval == 0 it triggers every frame
+    const float period = timer->_useDelay ? timer->_delay : std::max(timer->_interval, 0.0f);
+    const double time  = timer->_queueTime + std::max(period - timer->_elapsed, 0.0f) + timerHandle.pausedTime;
+
+    _timerQueue.emplace_back(TimerQueueEntry{time, timer, target, timer->_queueGeneration});
+    std::push_heap(_timerQueue.begin(), _timerQueue.end(), timerQueueEntryAfter);
+}
+
+void Scheduler::dropQueuedTimer(Timer* timer)
+{
+    if (timer->_queued)
+    {
+        timer->_queued = false;
+        ++_staleTimerEntries;
+    }
+}
+
+void Scheduler::compactTimerQueue()
+{
+    // a timer rescheduled often or unscheduled long before its entry is due would stay retained by the queue
+    std::vector<Timer*> staleTimers;
+    auto isStale = [&staleTimers](const TimerQueueEntry& entry) {
+        if (entry.timer->_queued && entry.generation == entry.timer->_queueGeneration)
+            return false;
+        staleTimers.emplace_back(entry.timer);
+        return true;
+    };
+    _timerQueue.erase(std::remove_if(_timerQueue.begin(), _timerQueue.end(), isStale), _timerQueue.end());
+    std::make_heap(_timerQueue.begin(), _timerQueue.end(), timerQueueEntryAfter);
+    _startingTimers.erase(std::remove_if(_startingTimers.begin(), _startingTimers.end(), isStale),
+                          _startingTimers.end());
+    _staleTimerEntries = 0;
+
+    // released last, the callbacks captured by the timers may schedule again when they are destroyed
+    for (auto timer : staleTimers)
+        timer->release();
+}
+
+void Scheduler::setTimersPaused(void* target, TimerHandle& timerHandle, bool paused)
+{
+    if (timerHandle.paused == paused)
+        return;
+
+    timerHandle.paused = paused;
+    if (paused)
+    {
+        // the entries of the timers are stale, they are queued again on resume
+        timerHandle.pausedAt = _timerTime;
+        for (auto&& timer : timerHandle.timers)
+            dropQueuedTimer(timer);
+    }
+    else
+    {
+        // the time of the target doesn't advance while it's paused
+        timerHandle.pausedTime += _timerTime - timerHandle.pausedAt;
+        for (auto&& timer : timerHandle.timers)
+            queueTimer(timer, target, timerHandle);
+    }
+}
+
+void Scheduler::updateTimers(float dt)
+{
+    _timerTime += dt;
+
+    // take out all due timers first, timers triggering every frame are queued again with the current time
+    while (!_timerQueue.empty() && _timerQueue.front().time <= _timerTime)
+    {
+        std::pop_heap(_timerQueue.begin(), _timerQueue.end(), timerQueueEntryAfter);
+        _dueTimers.emplace_back(_timerQueue.back());
+        _timerQueue.pop_back();
+    }
+
+    for (auto&& entry : _dueTimers)
+    {
+        auto timer   = entry.timer;
+        auto timerIt = _timersMap.end();
+        if (entry.generation != timer->_queueGeneration || !timer->_queued)
+        {
+            // unscheduled, rescheduled or paused since it was queued
+            --_staleTimerEntries;
+            timer->release();
+            continue;
+        }
+        timer->_queued = false;
+        if (timer->isAborted() || (timerIt = _timersMap.find(entry.target)) == _timersMap.end() ||
+            timerIt->second.paused)
+        {
+            timer->release();
+            continue;
+        }
+
+        auto elt               = &timerIt->second;
+        _currentTarget         = elt;
+        _currentTargetSalvaged = false;
+        elt->currentTimer      = timer;
+
+        // catch up on the time since the last update of the timer at once
+        const double now = _timerTime - elt->pausedTime;
+        timer->update(static_cast<float>(now - timer->_queueTime));
+        timer->_queueTime = now;
+
+        if (timer->isAborted())
+        {
+            // The currentTimer told the remove itself. To prevent the timer from
+            // accidentally deallocating itself before finishing its step, we retained
+            // it. Now that step is done, it's safe to release it.
+            timer->release();
+            timer->release();
+        }
+        else
+        {
+            // a timer rescheduled by its own callback was queued again already
+            if (entry.generation == timer->_queueGeneration)
+                queueTimer(timer, entry.target, *elt);
+            timer->release();
+        }
+
+        elt->currentTimer = nullptr;
+
+        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
+        if (_currentTargetSalvaged && elt->timers.empty())
+        {
+            _timersMap.erase(timerIt);
+        }
+        _currentTarget = nullptr;
+    }
+    _dueTimers.clear();
+
+    // start counting the timers scheduled since the last update
+    for (auto&& entry : _startingTimers)
+    {
+        auto timer   = entry.timer;
+        auto timerIt = _timersMap.end();
+        if (entry.generation != timer->_queueGeneration || !timer->_queued)
+        {
+            --_staleTimerEntries;
+            timer->release();
+            continue;
+        }
+        timer->_queued = false;
+        if (timer->isAborted() || (timerIt = _timersMap.find(entry.target)) == _timersMap.end() ||
+            timerIt->second.paused)
+        {
+            timer->release();
+            continue;
+        }
+
+        timer->update(0);
+        timer->_queueTime = _timerTime - timerIt->second.pausedTime;
+        queueTimer(timer, entry.target, timerIt->second);
+        timer->release();
+    }
+    _startingTimers.clear();
+
+    // the stale entries are released once they make up a quarter of the queue, before they are due
+    if (_staleTimerEntries * 4 > _timerQueue.size())
+        compactTimerQueue();
+}
+
 void Scheduler::runOnAxmolThread(std::function<void()> action)
 {
-    std::lock_guard<std::mutex> lock(_performMutex);
-    _actionsToPerform.emplace_back(std::move(action));
+    // counted first, a consumer dequeuing the action before the increment would wrap the count around
+    _pendingActionCount.fetch_add(1, std::memory_order_relaxed);
+    _pendingActions->queue.enqueue(PendingAction{std::move(action), std::chrono::steady_clock::now()});
 }
 
 void Scheduler::removeAllPendingActions()
 {
-    std::unique_lock<std::mutex> lock(_performMutex);
-    _actionsToPerform.clear();
+    PendingAction pending;
+    while (_pendingActions->queue.try_dequeue(pending))
+        _pendingActionCount.fetch_sub(1, std::memory_order_relaxed);
 }
 
 // main loop
@@ -773,43 +982,8 @@ void Scheduler::update(float dt)
         }
     }
 
-    // Iterate over all the custom selectors
-    for (auto it = _timersMap.begin(); it != _timersMap.end();)
-    {
-        auto elt               = &it->second;
-        _currentTarget         = elt;
-        _currentTargetSalvaged = false;
-
-        if (!_currentTarget->paused)
-        {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers.size(); ++(elt->timerIndex))
-            {
-                elt->currentTimer = elt->timers[elt->timerIndex];
-                AXASSERT(!elt->currentTimer->isAborted(), "An aborted timer should not be updated");
-
-                elt->currentTimer->update(dt);
-
-                if (elt->currentTimer->isAborted())
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
-
-                elt->currentTimer = nullptr;
-            }
-        }
-
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty())
-        {
-            it = _timersMap.erase(it);
-        }
-        else
-            ++it;
-    }
+    // Iterate over the custom selectors which are due
+    updateTimers(dt);
 
     // delete all updates that are removed in update
     for (auto&& sched : _updateDeleteVector)
@@ -849,19 +1023,29 @@ void Scheduler::update(float dt)
     // Functions allocated from another thread
     //
 
-    // Testing size is faster than locking / unlocking.
+    // Testing the count is faster than touching the queue.
     // And almost never there will be functions scheduled to be called.
-    if (!_actionsToPerform.empty())
+    _pendingActionMaxLatency = 0;
+    if (auto count = _pendingActionCount.load(std::memory_order_acquire))
     {
-        _performMutex.lock();
-        // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if
-        // new functions are added in callback, it will cause thread deadlock.
-        auto temp = std::move(_actionsToPerform);
-        _performMutex.unlock();
-
-        for (const auto& function : temp)
+        // functions posted by the functions run next frame, like when the pending functions were swapped out
+        using namespace std::chrono;
+        const auto start    = steady_clock::now();
+        const auto deadline = start + duration_cast<steady_clock::duration>(duration<float>(_pendingActionsBudget));
+
+        PendingAction pending;
+        auto now = start;
+        for (; count > 0 && _pendingActions->queue.try_dequeue(pending); --count)
         {
-            function();
+            _pendingActionCount.fetch_sub(1, std::memory_order_relaxed);
+            _pendingActionMaxLatency =
+                std::max(_pendingActionMaxLatency, duration<float>(now - pending.posted).count());
+
+            pending.action();
+            pending.action = nullptr;
+
+            if (_pendingActionsBudget > 0 && (now = steady_clock::now()) >= deadline)
+                break;
         }
     }
 }
@@ -882,14 +1066,16 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
         timerIt = _timersMap.emplace(target, TimerHandle{}).first;
 
         // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        timerIt->second.paused = paused;
+        timerIt->second.paused   = paused;
+        timerIt->second.pausedAt = _timerTime;
     }
     else
     {
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused.");
     }
 
-    auto&& timers = timerIt->second.timers;
+    auto& timerHandle = timerIt->second;
+    auto& timers      = timerHandle.timers;
     if (timers.empty())
     {
         timers.reserve(10);
@@ -905,6 +1091,7 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
             AXLOG("Scheduler#schedule. Reiniting timer with interval %.4f, repeat %u, delay %.4f", interval, repeat,
                   delay);
             (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            queueTimer(*timerIt, target, timerHandle);
             return;
         }
     }
@@ -912,6 +1099,7 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
     TimerTargetSelector* timer = new TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
     timers.pushBack(timer);
+    queueTimer(timer, target, timerHandle);
     timer->release();
 }
 
@@ -963,8 +1151,10 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Ref* target)
                 if (timer == timerHandle.currentTimer && !timer->isAborted())
                 {
                     timer->retain();
-                    timer->setAborted();
                 }
+                // the entry of the timer in the timer queue is released on the next compaction
+                timer->setAborted();
+                dropQueuedTimer(timer);
 
                 timers.erase(i);
 
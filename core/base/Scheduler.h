@@ -29,7 +29,9 @@ THE SOFTWARE.
 #ifndef __CCSCHEDULER_H__
 #define __CCSCHEDULER_H__
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <set>
 #include "base/axstd.h"
@@ -63,6 +65,8 @@ public:
     void update(float dt);
 
 protected:
+    friend class Scheduler;
+
     Scheduler* _scheduler;  // weak ref
     float _elapsed;
     bool _runForever;
@@ -72,6 +76,11 @@ protected:
     float _delay;
     float _interval;
     bool _aborted;
+
+    // state of the timer queue of the scheduler
+    double _queueTime             = 0;      ///< time of the target when the timer was last updated
+    unsigned int _queueGeneration = 0;      ///< entries of older generations in the queue are stale
+    bool _queued                  = false;  ///< the entry of the current generation is in the queue
 };
 
 class AX_DLL TimerTargetSelector : public Timer
@@ -174,6 +183,17 @@ struct TimerHandle
     int timerIndex;
     Timer* currentTimer;
     bool paused;
+    double pausedAt   = 0;  ///< scheduler time when the target was paused
+    double pausedTime = 0;  ///< total time the target was paused, the time of the target lags behind by it
+};
+
+// a timer due at time, ordered by time in the timer queue of the scheduler
+struct TimerQueueEntry
+{
+    double time;
+    Timer* timer;  // retained by the queue
+    void* target;
+    unsigned int generation;
 };
 
 #if AX_ENABLE_SCRIPT_BINDING
@@ -464,13 +484,33 @@ public:
     void resumeTargets(const std::set<void*>& targetsToResume);
 
     /** Calls a function on the cocos2d thread. Useful when you need to call a cocos2d function from another thread.
-     This function is thread safe.
+     This function is thread safe and lock free, functions posted by the same thread run in posting order.
      @param function The function to be run in cocos2d thread.
      @since v3.0
      @js NA
      */
     void runOnAxmolThread(std::function<void()> action);
 
+    /** Limit the time spent per frame on the functions posted with runOnAxmolThread, the functions which
+     don't fit run next frame. At least one function runs per frame.
+     @param seconds The time budget in seconds, 0 to run all pending functions every frame (the default).
+     @js NA
+     */
+    void setPendingActionsBudget(float seconds) { _pendingActionsBudget = seconds; }
+    float getPendingActionsBudget() const { return _pendingActionsBudget; }
+
+    /** Get the number of functions posted with runOnAxmolThread which didn't run yet.
+     This function is thread safe.
+     @js NA
+     */
+    unsigned int getPendingActionCount() const { return _pendingActionCount.load(std::memory_order_relaxed); }
+
+    /** Get the longest time in seconds a function posted with runOnAxmolThread waited to run during the last
+     update.
+     @js NA
+     */
+    float getPendingActionMaxLatency() const { return _pendingActionMaxLatency; }
+
     AX_DEPRECATED_ATTRIBUTE void performFunctionInCocosThread(std::function<void()> action)
     {
         runOnAxmolThread(std::move(action));
@@ -511,6 +551,13 @@ protected:
 
     void unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt);
 
+    // timer queue
+    void queueTimer(Timer* timer, void* target, TimerHandle& timerHandle);
+    void dropQueuedTimer(Timer* timer);
+    void compactTimerQueue();
+    void setTimersPaused(void* target, TimerHandle& timerHandle, bool paused);
+    void updateTimers(float dt);
+
     float _timeScale;
 
     axstd::pod_vector<SchedHandle*> _waitList; // list wait active
@@ -529,6 +576,13 @@ protected:
 
     // Used for "selectors with interval"
     std::unordered_map<void*, TimerHandle> _timersMap;
+    // min heap of the timers by the time they trigger next, so only the triggering timers are updated per frame
+    std::vector<TimerQueueEntry> _timerQueue;
+    // timers which start counting at the next update
+    std::vector<TimerQueueEntry> _startingTimers;
+    std::vector<TimerQueueEntry> _dueTimers;
+    size_t _staleTimerEntries = 0;  ///< entries of unscheduled, rescheduled or paused timers in the queues
+    double _timerTime         = 0;  ///< sum of the scaled frame times
     struct TimerHandle* _currentTarget;
     bool _currentTargetSalvaged;
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
@@ -539,8 +593,12 @@ protected:
 #endif
 
     // Used for "perform action"
-    std::vector<std::function<void()>> _actionsToPerform;
-    std::mutex _performMutex;
+    struct PendingAction;
+    struct PendingActionQueue;
+    std::unique_ptr<PendingActionQueue> _pendingActions;
+    std::atomic<unsigned int> _pendingActionCount{0};
+    float _pendingActionsBudget    = 0;
+    float _pendingActionMaxLatency = 0;
 };
 
 // end of base group
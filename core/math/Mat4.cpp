@@ -969,6 +969,16 @@ void Mat4::transformVector(float x, float y, float z, float w, Vec3* dst) const
     MathUtil::transformVec4(m, x, y, z, w, (float*)dst);
 }
 
+void Mat4::transformPoints(Vec3* points, size_t count, size_t stride) const
+{
+    GP_ASSERT(points || count == 0);
+#ifdef AX_USE_SSE
+    MathUtil::transformVec3Array(col, (float*)points, count, stride);
+#else
+    MathUtil::transformVec3Array(m, (float*)points, count, stride);
+#endif
+}
+
 void Mat4::transformVector(Vec4* vector) const
 {
     GP_ASSERT(vector);
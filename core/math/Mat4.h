@@ -830,6 +830,18 @@ public:
         transformVector(point.x, point.y, point.z, 1.0f, dst);
     }
 
+    /**
+     * Transforms an array of points by this matrix, treating the w coordinate as 1.
+     *
+     * The results are stored directly into the points. The points don't need to be
+     * tightly packed, so the positions of interleaved vertices can be transformed in place.
+     *
+     * @param points The first point to transform.
+     * @param count The number of points to transform.
+     * @param stride The distance in bytes between two consecutive points.
+     */
+    void transformPoints(Vec3* points, size_t count, size_t stride = sizeof(Vec3)) const;
+
     /**
      * Transforms the specified vector by this matrix by
      * treating the fourth (w) coordinate as zero.
@@ -40,6 +40,8 @@ public:
     inline static void transformVec4(const float* m, float x, float y, float z, float w, float* dst);
     
     inline static void transformVec4(const float* m, const float* v, float* dst);
+
+    inline static void transformVec3Array(const float* m, float* points, size_t count, size_t stride);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
 };
@@ -204,6 +206,22 @@ inline void MathUtilC::transformVec4(const float* m, const float* v, float* dst)
     dst[3] = w;
 }
 
+inline void MathUtilC::transformVec3Array(const float* m, float* points, size_t count, size_t stride)
+{
+    auto p = reinterpret_cast<uint8_t*>(points);
+    for (size_t i = 0; i < count; ++i, p += stride)
+    {
+        float* v = reinterpret_cast<float*>(p);
+        float x  = v[0] * m[0] + v[1] * m[4] + v[2] * m[8] + m[12];
+        float y  = v[0] * m[1] + v[1] * m[5] + v[2] * m[9] + m[13];
+        float z  = v[0] * m[2] + v[1] * m[6] + v[2] * m[10] + m[14];
+
+        v[0] = x;
+        v[1] = y;
+        v[2] = z;
+    }
+}
+
 inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
 {
     float x = (v1[1] * v2[2]) - (v1[2] * v2[1]);
@@ -18,6 +18,8 @@
  This file was modified to fit the cocos2d-x project
  */
 
+#include <arm_neon.h>
+
 NS_AX_MATH_BEGIN
 
 class MathUtilNeon64
@@ -40,6 +42,8 @@ public:
     inline static void transformVec4(const float* m, float x, float y, float z, float w, float* dst);
     
     inline static void transformVec4(const float* m, const float* v, float* dst);
+
+    inline static void transformVec3Array(const float* m, float* points, size_t count, size_t stride);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
 };
@@ -223,6 +227,26 @@ inline void MathUtilNeon64::transformVec4(const float* m, const float* v, float*
     );
 }
 
+inline void MathUtilNeon64::transformVec3Array(const float* m, float* points, size_t count, size_t stride)
+{
+    float32x4_t c0 = vld1q_f32(m);      // M[m0-m3]
+    float32x4_t c1 = vld1q_f32(m + 4);  // M[m4-m7]
+    float32x4_t c2 = vld1q_f32(m + 8);  // M[m8-m11]
+    float32x4_t c3 = vld1q_f32(m + 12); // M[m12-m15]
+
+    auto p = reinterpret_cast<uint8_t*>(points);
+    for (size_t i = 0; i < count; ++i, p += stride)
+    {
+        float* v = reinterpret_cast<float*>(p);
+
+        // DST->V = M[m12-m15] + M[m0-m3] * V[x] + M[m4-m7] * V[y] + M[m8-m11] * V[z]
+        float32x4_t dst = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c3, c0, v[0]), c1, v[1]), c2, v[2]);
+
+        vst1_f32(v, vget_low_f32(dst));  // DST->V[x, y]
+        vst1q_lane_f32(v + 2, dst, 2);   // DST->V[z]
+    }
+}
+
 inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* dst)
 {
         asm volatile(
@@ -151,6 +151,32 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
                      );
 }
 
+static inline void transformVec3InPlace(const __m128 m[4], float* v)
+{
+    __m128 dst = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], _mm_set1_ps(v[0])), _mm_mul_ps(m[1], _mm_set1_ps(v[1]))),
+                            _mm_add_ps(_mm_mul_ps(m[2], _mm_set1_ps(v[2])), m[3]));
+
+    // only x, y, z are written back, the bytes after them may belong to other vertex attributes
+    _mm_storel_pi(reinterpret_cast<__m64*>(v), dst);
+    _mm_store_ss(v + 2, _mm_movehl_ps(dst, dst));
+}
+
+void MathUtil::transformVec3Array(const __m128 m[4], float* points, size_t count, size_t stride)
+{
+    auto p = reinterpret_cast<uint8_t*>(points);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4, p += stride * 4)
+    {
+        transformVec3InPlace(m, reinterpret_cast<float*>(p));
+        transformVec3InPlace(m, reinterpret_cast<float*>(p + stride));
+        transformVec3InPlace(m, reinterpret_cast<float*>(p + stride * 2));
+        transformVec3InPlace(m, reinterpret_cast<float*>(p + stride * 3));
+    }
+    for (; i < count; ++i, p += stride)
+        transformVec3InPlace(m, reinterpret_cast<float*>(p));
+}
+
 #endif
 
 
@@ -0,0 +1,70 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "platform/GLView.h"
+
+NS_AX_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * A view without window and GL context, renders with backend::DriverNull.
+ * Use it to run scenes headless, i.e. benchmarks and CI:
+ * @code
+ * director->setGLView(GLViewNull::create("bench", Rect(0, 0, 1280, 720)));
+ * @endcode
+ */
+class AX_DLL GLViewNull : public GLView
+{
+public:
+    /**
+     * Create a view of the given frame size, installs a DriverNull unless a driver is already in use.
+     */
+    static GLViewNull* create(std::string_view viewName, const Rect& rect);
+
+    void end() override;
+    bool isOpenGLReady() override { return true; }
+    void swapBuffers() override {}
+    void setIMEKeyboardState(bool /*open*/) override {}
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_WIN32)
+    HWND getWin32Window() override { return nullptr; }
+#endif /* (AX_TARGET_PLATFORM == AX_PLATFORM_WIN32) */
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_MAC)
+    void* getCocoaWindow() override { return nullptr; }
+    void* getNSGLContext() override { return nullptr; }
+#endif /* (AX_TARGET_PLATFORM == AX_PLATFORM_MAC) */
+};
+
+// end of platform group
+/// @}
+
+NS_AX_END
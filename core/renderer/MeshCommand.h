@@ -73,6 +73,13 @@ public:
 
     void init(float globalZOrder, const Mat4& transform);
 
+    /**
+    The hash of the render state blocks the pass binds before drawing, Renderer only instances
+    meshes with the same hash together.
+    */
+    uint32_t getRenderStateHash() const { return _renderStateHash; }
+    void setRenderStateHash(uint32_t hash) { _renderStateHash = hash; }
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     void listenRendererRecreated(EventCustom* event);
 #endif
@@ -81,6 +88,7 @@ protected:
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _rendererRecreatedListener;
 #endif
+    uint32_t _renderStateHash = 0;
 };
 
 NS_AX_END
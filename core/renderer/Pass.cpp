@@ -192,6 +192,10 @@ void Pass::draw(MeshCommand* meshCommand,
     meshCommand->setIndexDrawInfo(0, indexCount);
     meshCommand->getPipelineDescriptor().programState = _programState;
 
+    uint32_t stateHashes[3] = {_technique->_material->getStateBlock().getHash(),
+                               _technique->getStateBlock().getHash(), getStateBlock().getHash()};
+    meshCommand->setRenderStateHash(XXH32((const void*)stateHashes, sizeof(stateHashes), 0));
+
     auto* renderer = Director::getInstance()->getRenderer();
 
     renderer->addCommand(meshCommand);
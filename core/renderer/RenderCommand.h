@@ -27,6 +27,7 @@
 #include "platform/PlatformMacros.h"
 #include "base/Types.h"
 #include "renderer/PipelineDescriptor.h"
+#include "base/PoolAllocator.h"
 
 /**
  * @addtogroup renderer
@@ -42,6 +43,8 @@ NS_AX_BEGIN
 class AX_DLL RenderCommand
 {
 public:
+    AX_POOL_ALLOCATED_DECL(RenderCommand)
+
     /**Enum the type of render command. */
     enum class Type
     {
@@ -100,6 +103,8 @@ public:
     inline PipelineDescriptor& getPipelineDescriptor() { return _pipelineDescriptor; }
 
     const Mat4& getMV() const { return _mv; }
+    /**Set the model view matrix used when the command is drawn.*/
+    void setMV(const Mat4& mv) { _mv.set(mv); }
 
 protected:
     /**Constructor.*/
@@ -36,6 +36,7 @@
 #include "base/Director.h"
 #include "renderer/Renderer.h"
 #include "renderer/Material.h"
+#include "xxhash.h"
 
 NS_AX_BEGIN
 
@@ -345,8 +346,32 @@ bool RenderState::StateBlock::isDirty() const
 
 uint32_t RenderState::StateBlock::getHash() const
 {
-    // XXX
-    return 0x12345678;
+    struct
+    {
+        int32_t modifiedBits;
+        uint8_t cullFaceEnabled;
+        uint8_t depthTestEnabled;
+        uint8_t depthWriteEnabled;
+        uint8_t blendEnabled;
+        uint32_t depthFunction;
+        uint32_t blendSrc;
+        uint32_t blendDst;
+        uint32_t cullFaceSide;
+        uint32_t frontFace;
+    } hashMe;
+    memset(&hashMe, 0, sizeof(hashMe));
+
+    hashMe.modifiedBits      = _modifiedBits;
+    hashMe.cullFaceEnabled   = _cullFaceEnabled;
+    hashMe.depthTestEnabled  = _depthTestEnabled;
+    hashMe.depthWriteEnabled = _depthWriteEnabled;
+    hashMe.blendEnabled      = _blendEnabled;
+    hashMe.depthFunction     = static_cast<uint32_t>(_depthFunction);
+    hashMe.blendSrc          = static_cast<uint32_t>(_blendSrc);
+    hashMe.blendDst          = static_cast<uint32_t>(_blendDst);
+    hashMe.cullFaceSide      = static_cast<uint32_t>(_cullFaceSide);
+    hashMe.frontFace         = static_cast<uint32_t>(_frontFace);
+    return XXH32((const void*)&hashMe, sizeof(hashMe), 0);
 }
 
 void RenderState::StateBlock::setBlend(bool enabled)
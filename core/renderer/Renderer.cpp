@@ -26,6 +26,12 @@
 #include "renderer/Renderer.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 #include "renderer/TrianglesCommand.h"
 #include "renderer/CustomCommand.h"
@@ -62,6 +68,338 @@ static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
     return a->getDepth() > b->getDepth();
 }
 
+// sort key layout, from the most significant bit:
+// | queue group: 3 | globalZ, depth or opaque segment: 32 | depth-safety class: 1 | material ID: 28 |
+static const int SORT_KEY_GROUP_SHIFT        = 61;
+static const int SORT_KEY_ORDER_SHIFT        = 29;
+static const int SORT_KEY_CLASS_SHIFT        = 28;
+static const uint64_t SORT_KEY_MATERIAL_MASK = (1u << SORT_KEY_CLASS_SHIFT) - 1;
+// depth tested opaque commands, they can be drawn in any order
+static const uint64_t DEPTH_CLASS_FREE = 0;
+// commands which must keep their submission order
+static const uint64_t DEPTH_CLASS_ORDERED = 1;
+// how many batches a command can be moved over to join a batch of the same material
+static const int REORDER_MAX_LOOKBEHIND = 16;
+// the most meshes drawn by one automatically instanced draw call
+static const size_t INSTANCE_BATCH_SIZE = 256;
+
+static uint32_t toOrderedBits(float value)
+{
+    if (value == 0.0f)  // -0 and +0 must get the same key
+        value = 0.0f;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    // flip all bits of negative values and the sign bit of positive ones, so the unsigned order is the float order
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+static uint32_t getMeshMaterialID(RenderCommand* command)
+{
+    auto cmd = static_cast<CustomCommand*>(command);
+    struct
+    {
+        void* program;
+        void* vertexBuffer;
+    } hashMe;
+    memset(&hashMe, 0, sizeof(hashMe));
+
+    auto programState   = cmd->getPipelineDescriptor().programState;
+    hashMe.program      = programState ? programState->getProgram() : nullptr;
+    hashMe.vertexBuffer = cmd->getVertexBuffer();
+    return XXH32((const void*)&hashMe, sizeof(hashMe), 0);
+}
+
+// meshes drawn with a program which takes its model transforms from the instance buffer, without one of their own
+static bool needsInstanceTransforms(MeshCommand* command)
+{
+    auto programState = command->getPipelineDescriptor().programState;
+    return programState && command->getDrawType() == CustomCommand::DrawType::ELEMENT &&
+           command->getInstanceBuffer() == nullptr &&
+           programState->getProgram()->getAttributeLocation(backend::Attribute::INSTANCE) != -1;
+}
+
+// meshes of the builtin unlit program, batches of them are drawn with its instanced variant
+static bool isUnlitMesh(MeshCommand* command)
+{
+    auto programState = command->getPipelineDescriptor().programState;
+    return programState && command->getDrawType() == CustomCommand::DrawType::ELEMENT &&
+           command->getInstanceBuffer() == nullptr &&
+           programState->getProgram()->getProgramType() == backend::ProgramType::POSITION_TEXTURE_3D;
+}
+
+// opaque meshes which can be drawn together with others in one instanced draw call
+static bool isAutoInstanceable(MeshCommand* command)
+{
+    return (needsInstanceTransforms(command) || isUnlitMesh(command)) && command->is3D() &&
+           !command->isTransparent() && !command->isSkipBatching() &&
+           command->getPipelineDescriptor().programState->getCallbackUniforms().empty();
+}
+
+// the data of a uniform in the uniform buffer of the program state, like ProgramState::setUniform writes it
+static const char* getUniformData(backend::ProgramState* programState, const backend::UniformLocation& location)
+{
+    std::size_t size;
+    if (location.shaderStage == backend::ShaderStage::FRAGMENT)
+        return programState->getFragmentUniformBuffer(size) + location.location[0] + location.location[1];
+#if AX_GLES_PROFILE != 200
+    return programState->getVertexUniformBuffer(size) + location.location[0] + location.location[1];
+#else
+    return programState->getVertexUniformBuffer(size) + location.location[1];
+#endif
+}
+
+// whether two program states of the same program have the same uniforms, except u_MVPMatrix, it still holds the
+// last frame value of each mesh and is replaced by the view projection anyway
+static bool isSameUniforms(backend::ProgramState* a, backend::ProgramState* b)
+{
+    std::size_t vertexSize, fragmentSize;
+    auto uniformsA = a->getVertexUniformBuffer(vertexSize);
+    auto uniformsB = b->getVertexUniformBuffer(vertexSize);
+    a->getFragmentUniformBuffer(fragmentSize);
+    const std::size_t size = vertexSize + fragmentSize;
+
+    auto mvpLocation = a->getUniformLocation(backend::Uniform::MVP_MATRIX);
+    if (!mvpLocation)
+        return memcmp(uniformsA, uniformsB, size) == 0;
+
+    const std::size_t mvpBegin = getUniformData(a, mvpLocation) - uniformsA;
+    const std::size_t mvpEnd   = (std::min)(mvpBegin + sizeof(Mat4), size);
+    return memcmp(uniformsA, uniformsB, mvpBegin) == 0 &&
+           memcmp(uniformsA + mvpEnd, uniformsB + mvpEnd, size - mvpEnd) == 0;
+}
+
+static bool isSameTextures(const std::unordered_map<int, backend::TextureInfo>& a,
+                           const std::unordered_map<int, backend::TextureInfo>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (auto&& entry : a)
+    {
+        auto it = b.find(entry.first);
+        if (it == b.end() || it->second.slots != entry.second.slots || it->second.textures != entry.second.textures)
+            return false;
+    }
+    return true;
+}
+
+// whether two instanceable meshes draw the same geometry with the same states, textures and uniforms
+static bool canShareInstancedDraw(MeshCommand* a, MeshCommand* b)
+{
+    auto stateA = a->getPipelineDescriptor().programState;
+    auto stateB = b->getPipelineDescriptor().programState;
+    if (stateA->getProgram() != stateB->getProgram() || a->getVertexBuffer() != b->getVertexBuffer() ||
+        a->getIndexBuffer() != b->getIndexBuffer() || a->getIndexFormat() != b->getIndexFormat() ||
+        a->getPrimitiveType() != b->getPrimitiveType() || a->getIndexDrawOffset() != b->getIndexDrawOffset() ||
+        a->getIndexDrawCount() != b->getIndexDrawCount() || a->isWireframe() != b->isWireframe() ||
+        a->getRenderStateHash() != b->getRenderStateHash())
+        return false;
+
+    if (stateA == stateB)
+        return true;
+
+    if (stateA->getVertexLayout()->getHash() != stateB->getVertexLayout()->getHash() ||
+        !isSameTextures(stateA->getVertexTextureInfos(), stateB->getVertexTextureInfos()) ||
+        !isSameTextures(stateA->getFragmentTextureInfos(), stateB->getFragmentTextureInfos()))
+        return false;
+
+    return isSameUniforms(stateA, stateB);
+}
+
+// segment is the index of the run of MeshCommands in the opaque queue, the other commands are barriers
+static uint64_t makeSortKey(RenderQueue::QUEUE_GROUP group, RenderCommand* command, uint32_t segment)
+{
+    uint32_t order      = 0;
+    uint64_t depthClass = DEPTH_CLASS_ORDERED;
+    uint32_t materialID = 0;
+    switch (group)
+    {
+    case RenderQueue::QUEUE_GROUP::OPAQUE_3D:
+        // group the opaque meshes of a run by program and geometry, the depth test makes their order irrelevant
+        order = segment;
+        if (command->getType() == RenderCommand::Type::MESH_COMMAND)
+        {
+            depthClass = DEPTH_CLASS_FREE;
+            materialID = getMeshMaterialID(command);
+        }
+        break;
+    case RenderQueue::QUEUE_GROUP::TRANSPARENT_3D:
+        // back to front
+        order = ~toOrderedBits(command->getDepth());
+        break;
+    default:
+        order = toOrderedBits(command->getGlobalOrder());
+        break;
+    }
+    return (static_cast<uint64_t>(group) << SORT_KEY_GROUP_SHIFT) |
+           (static_cast<uint64_t>(order) << SORT_KEY_ORDER_SHIFT) | (depthClass << SORT_KEY_CLASS_SHIFT) |
+           (materialID & SORT_KEY_MATERIAL_MASK);
+}
+
+// LSD radix sort, stable, the bytes which are the same for every key are skipped
+static void radixSort(std::vector<RenderQueueSortContext::Entry>& entries,
+                      std::vector<RenderQueueSortContext::Entry>& scratch)
+{
+    const size_t count = entries.size();
+    scratch.resize(count);
+
+    uint32_t histograms[8][256] = {};
+    for (auto&& entry : entries)
+    {
+        for (int byte = 0; byte < 8; ++byte)
+            ++histograms[byte][(entry.key >> (byte * 8)) & 0xff];
+    }
+
+    auto src = entries.data();
+    auto dst = scratch.data();
+    for (int byte = 0; byte < 8; ++byte)
+    {
+        const int shift = byte * 8;
+        auto& histogram = histograms[byte];
+        if (histogram[(src[0].key >> shift) & 0xff] == count)
+            continue;
+
+        uint32_t offsets[256];
+        uint32_t offset = 0;
+        for (int i = 0; i < 256; ++i)
+        {
+            offsets[i] = offset;
+            offset += histogram[i];
+        }
+        for (size_t i = 0; i < count; ++i)
+            dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != entries.data())
+        memcpy(entries.data(), src, sizeof(entries[0]) * count);
+}
+
+// the bounds of the command in view space
+static void computeBatchBounds(const TrianglesCommand* cmd, RenderQueueSortContext::Batch& bounds)
+{
+    bounds.minX = bounds.minY = std::numeric_limits<float>::max();
+    bounds.maxX = bounds.maxY = std::numeric_limits<float>::lowest();
+    bounds.flat = true;
+    bounds.z    = 0;
+
+    const float* m   = cmd->getModelView().m;
+    auto verts       = cmd->getVertices();
+    const auto count = cmd->getVertexCount();
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& p = verts[i].vertices;
+        float x = p.x * m[0] + p.y * m[4] + p.z * m[8] + m[12];
+        float y = p.x * m[1] + p.y * m[5] + p.z * m[9] + m[13];
+        float z = p.x * m[2] + p.y * m[6] + p.z * m[10] + m[14];
+
+        bounds.minX = (std::min)(bounds.minX, x);
+        bounds.maxX = (std::max)(bounds.maxX, x);
+        bounds.minY = (std::min)(bounds.minY, y);
+        bounds.maxY = (std::max)(bounds.maxY, y);
+        if (i == 0)
+            bounds.z = z;
+        else if (z != bounds.z)
+            bounds.flat = false;
+    }
+}
+
+static bool isBatchBoundsOverlap(const RenderQueueSortContext::Batch& a, const RenderQueueSortContext::Batch& b)
+{
+    if (a.minX > a.maxX || b.minX > b.maxX)
+        return false;
+    // not on the same plane, the projection could make them overlap
+    if (!a.flat || !b.flat || a.z != b.z)
+        return true;
+    return a.minX < b.maxX && b.minX < a.maxX && a.minY < b.maxY && b.minY < a.maxY;
+}
+
+// reorder a run of 2D TrianglesCommands with the same globalZ, returns the number of draw calls saved
+static size_t mergeBatches(RenderCommand** run, int count, RenderQueueSortContext& context)
+{
+    auto& batches = context.batches;
+    auto& next    = context.next;
+    batches.clear();
+    next.assign(count, -1);
+
+    size_t originalBatches  = 0;
+    uint32_t prevMaterialID = 0;
+    bool prevBatchable      = false;
+    for (int i = 0; i < count; ++i)
+    {
+        auto cmd                  = static_cast<TrianglesCommand*>(run[i]);
+        const bool batchable      = !cmd->isSkipBatching();
+        const uint32_t materialID = cmd->getMaterialID();
+        if (!batchable || !prevBatchable || materialID != prevMaterialID)
+            ++originalBatches;
+        prevBatchable  = batchable;
+        prevMaterialID = materialID;
+
+        RenderQueueSortContext::Batch bounds;
+        computeBatchBounds(cmd, bounds);
+
+        // search backwards for a batch of the same material, the command can't be moved over one it overlaps
+        int target = -1;
+        if (batchable)
+        {
+            const int stop = (std::max)(static_cast<int>(batches.size()) - REORDER_MAX_LOOKBEHIND, 0);
+            for (int b = static_cast<int>(batches.size()) - 1; b >= stop; --b)
+            {
+                auto& batch = batches[b];
+                if (batch.batchable && batch.materialID == materialID)
+                {
+                    target = b;
+                    break;
+                }
+                if (isBatchBoundsOverlap(batch, bounds))
+                    break;
+            }
+        }
+
+        if (target >= 0)
+        {
+            auto& batch = batches[target];
+            next[batch.last] = i;
+            batch.last       = i;
+            if (bounds.minX <= bounds.maxX)
+            {
+                batch.flat = batch.flat && bounds.flat && (batch.minX > batch.maxX || batch.z == bounds.z);
+                if (batch.minX > batch.maxX)
+                    batch.z = bounds.z;
+                batch.minX = (std::min)(batch.minX, bounds.minX);
+                batch.minY = (std::min)(batch.minY, bounds.minY);
+                batch.maxX = (std::max)(batch.maxX, bounds.maxX);
+                batch.maxY = (std::max)(batch.maxY, bounds.maxY);
+            }
+        }
+        else
+        {
+            bounds.materialID = materialID;
+            bounds.batchable  = batchable;
+            bounds.first = bounds.last = i;
+            batches.emplace_back(bounds);
+        }
+    }
+
+    if (batches.size() == static_cast<size_t>(count))
+        return 0;
+
+    auto& commands = context.commands;
+    commands.clear();
+    for (auto&& batch : batches)
+    {
+        for (int i = batch.first; i != -1; i = next[i])
+            commands.emplace_back(run[i]);
+    }
+    std::copy(commands.begin(), commands.end(), run);
+
+    return originalBatches > batches.size() ? originalBatches - batches.size() : 0;
+}
+
+static bool isReorderable(RenderCommand* command)
+{
+    return command->getType() == RenderCommand::Type::TRIANGLES_COMMAND && !command->is3D();
+}
+
 // queue
 RenderQueue::RenderQueue() {}
 
@@ -118,6 +456,57 @@ void RenderQueue::sort()
                      compareRenderCommand);
 }
 
+void RenderQueue::sortByKey(RenderQueueSortContext& context)
+{
+    auto& entries = context.entries;
+    for (int group = 0; group < QUEUE_GROUP::QUEUE_COUNT; ++group)
+    {
+        auto& commands = _commands[group];
+        if (commands.size() < 2)
+            continue;
+
+        // callbacks, custom and group commands may change the states or the render target, the meshes
+        // are only reordered inside of the runs between them
+        entries.clear();
+        uint32_t segment = 0;
+        for (auto&& command : commands)
+        {
+            const bool barrier = command->getType() != RenderCommand::Type::MESH_COMMAND;
+            if (barrier)
+                ++segment;
+            entries.push_back({makeSortKey(static_cast<QUEUE_GROUP>(group), command, segment), command});
+            if (barrier)
+                ++segment;
+        }
+        radixSort(entries, context.scratch);
+        for (size_t i = 0, count = entries.size(); i < count; ++i)
+            commands[i] = entries[i].command;
+
+        if (group == QUEUE_GROUP::OPAQUE_3D || group == QUEUE_GROUP::TRANSPARENT_3D)
+            continue;
+
+        // merge the batches inside of each run of 2D TrianglesCommands with the same globalZ
+        const int count = static_cast<int>(commands.size());
+        int begin       = 0;
+        while (begin < count)
+        {
+            if (!isReorderable(commands[begin]))
+            {
+                ++begin;
+                continue;
+            }
+
+            const float globalOrder = commands[begin]->getGlobalOrder();
+            int end                 = begin + 1;
+            while (end < count && isReorderable(commands[end]) && commands[end]->getGlobalOrder() == globalOrder)
+                ++end;
+            if (end - begin > 2)
+                context.savedBatches += mergeBatches(&commands[begin], end - begin, context);
+            begin = end;
+        }
+    }
+}
+
 RenderCommand* RenderQueue::operator[](ssize_t index) const
 {
     for (int queIndex = 0; queIndex < QUEUE_GROUP::QUEUE_COUNT; ++queIndex)
@@ -151,6 +540,105 @@ void RenderQueue::realloc(size_t reserveSize)
     }
 }
 
+//
+// Renderer::TrianglesFillWorkers
+//
+/**
+ * A small set of persistent threads which help the render thread to fill the batched triangles.
+ * The render thread always takes part in the work, run() returns once every item has been processed.
+ */
+class Renderer::TrianglesFillWorkers
+{
+public:
+    using Job = std::function<void(size_t first, size_t last)>;
+
+    explicit TrianglesFillWorkers(int threadCount)
+    {
+        for (int i = 0; i < threadCount; ++i)
+            _threads.emplace_back(&TrianglesFillWorkers::threadFunc, this);
+    }
+
+    ~TrianglesFillWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lck(_mutex);
+            _stop = true;
+        }
+        _workCondition.notify_all();
+        for (auto&& t : _threads)
+            t.join();
+    }
+
+    void run(size_t count, const Job& job)
+    {
+        {
+            std::lock_guard<std::mutex> lck(_mutex);
+            _job   = &job;
+            _count = count;
+            _next.store(0, std::memory_order_relaxed);
+            // several chunks per thread, the commands don't have the same size
+            _grain   = (std::max)(count / ((_threads.size() + 1) * 4), static_cast<size_t>(1));
+            _pending = static_cast<int>(_threads.size());
+            ++_generation;
+        }
+        _workCondition.notify_all();
+
+        consume(job);
+
+        std::unique_lock<std::mutex> lck(_mutex);
+        _doneCondition.wait(lck, [this] { return _pending == 0; });
+        _job = nullptr;
+    }
+
+private:
+    void consume(const Job& job)
+    {
+        for (;;)
+        {
+            size_t first = _next.fetch_add(_grain, std::memory_order_relaxed);
+            if (first >= _count)
+                break;
+            job(first, (std::min)(first + _grain, _count));
+        }
+    }
+
+    void threadFunc()
+    {
+        unsigned int generation = 0;
+        for (;;)
+        {
+            const Job* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lck(_mutex);
+                _workCondition.wait(lck, [this, generation] { return _stop || _generation != generation; });
+                if (_stop)
+                    break;
+                generation = _generation;
+                job        = _job;
+            }
+
+            consume(*job);
+
+            std::lock_guard<std::mutex> lck(_mutex);
+            if (--_pending == 0)
+                _doneCondition.notify_one();
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _workCondition;
+    std::condition_variable _doneCondition;
+
+    const Job* _job = nullptr;
+    size_t _count   = 0;
+    size_t _grain   = 1;
+    std::atomic<size_t> _next{0};
+    int _pending             = 0;
+    unsigned int _generation = 0;
+    bool _stop               = false;
+};
+
 //
 //
 //
@@ -167,6 +655,7 @@ Renderer::Renderer()
 
     _renderGroups.emplace_back();
     _queuedTriangleCommands.reserve(BATCH_TRIAGCOMMAND_RESERVED_SIZE);
+    _trianglesFillOffsets.reserve(BATCH_TRIAGCOMMAND_RESERVED_SIZE);
 
     // for the batched TriangleCommand
     _triBatchesToDraw = (TriBatchToDraw*)malloc(sizeof(_triBatchesToDraw[0]) * _triBatchesToDrawCapacity);
@@ -188,6 +677,16 @@ Renderer::~Renderer()
 
     free(_triBatchesToDraw);
 
+    delete _trianglesFillWorkers;
+
+    for (auto&& buffer : _instanceBuffers)
+        buffer->release();
+    _instanceBuffers.clear();
+
+    for (auto&& programState : _instanceProgramStates)
+        programState->release();
+    _instanceProgramStates.clear();
+
     AX_SAFE_RELEASE(_depthStencilState);
     AX_SAFE_RELEASE(_commandBuffer);
     AX_SAFE_RELEASE(_renderPipeline);
@@ -214,6 +713,8 @@ void Renderer::init()
 
     _depthStencilState = driver->newDepthStencilState();
     _commandBuffer->setDepthStencilState(_depthStencilState);
+
+    _instancingSupported = driver->checkForFeatureSupported(backend::FeatureType::INSTANCING);
 }
 
 backend::RenderTarget* Renderer::getOffscreenRenderTarget() {
@@ -221,6 +722,25 @@ backend::RenderTarget* Renderer::getOffscreenRenderTarget() {
     return (_offscreenRT = backend::DriverBase::getInstance()->newRenderTarget(TargetBufferFlags::COLOR | TargetBufferFlags::DEPTH_AND_STENCIL));
 }
 
+void Renderer::setParallelTrianglesFill(bool enabled)
+{
+    AXASSERT(!_isRendering, "Cannot change the triangles fill mode while rendering");
+    if (enabled == isParallelTrianglesFill())
+        return;
+
+    if (enabled)
+    {
+        // the render thread fills a share too, the fill is memory bound so few workers are enough
+        int threadCount       = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+        _trianglesFillWorkers = new TrianglesFillWorkers(std::clamp(threadCount, 1, 7));
+    }
+    else
+    {
+        delete _trianglesFillWorkers;
+        _trianglesFillWorkers = nullptr;
+    }
+}
+
 void Renderer::addCallbackCommand(std::function<void()> func, float globalZOrder)
 {
     auto cmd = nextCallbackCommand();
@@ -409,7 +929,10 @@ void Renderer::render()
         // 1. Sort render commands based on ID
         for (auto&& renderqueue : _renderGroups)
         {
-            renderqueue.sort();
+            if (_commandReorderEnabled)
+                renderqueue.sortByKey(_sortContext);
+            else
+                renderqueue.sort();
         }
         visitRenderQueue(_renderGroups[0]);
     }
@@ -431,8 +954,10 @@ void Renderer::endFrame()
     _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
     _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
 #endif
-    _queuedTotalIndexCount  = 0;
-    _queuedTotalVertexCount = 0;
+    _queuedTotalIndexCount     = 0;
+    _queuedTotalVertexCount    = 0;
+    _usedInstanceBuffers       = 0;
+    _usedInstanceProgramStates = 0;
 }
 
 void Renderer::clean()
@@ -452,6 +977,20 @@ void Renderer::clean()
     _queuedTriangleCommands.clear();
 }
 
+std::size_t Renderer::getElidedCalls() const
+{
+    return _commandBuffer->getElidedCalls();
+}
+
+void Renderer::clearDrawStats()
+{
+    _drawnBatches = _drawnVertices = 0;
+    _drawnMeshes = _culledMeshes   = 0;
+    _instancedMeshes               = 0;
+    _sortContext.savedBatches      = 0;
+    _commandBuffer->resetElidedCalls();
+}
+
 void Renderer::setDepthTest(bool value)
 {
     if (value)
@@ -597,28 +1136,25 @@ void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
     _viewport.height = h;
 }
 
-void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset)
+void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd,
+                                      unsigned int vertexBufferOffset,
+                                      unsigned int filledVertex,
+                                      unsigned int filledIndex)
 {
     size_t vertexCount = cmd->getVertexCount();
-    memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * vertexCount);
+    memcpy(&_verts[filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * vertexCount);
 
     // fill vertex, and convert them to world coordinates
-    const Mat4& modelView = cmd->getModelView();
-    for (size_t i = 0; i < vertexCount; ++i)
-    {
-        modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
-    }
+    cmd->getModelView().transformPoints(&_verts[filledVertex].vertices, vertexCount, sizeof(_verts[0]));
 
     // fill index
     const unsigned short* indices = cmd->getIndices();
     size_t indexCount             = cmd->getIndexCount();
+    const unsigned int base       = vertexBufferOffset + filledVertex;
     for (size_t i = 0; i < indexCount; ++i)
     {
-        _indices[_filledIndex + i] = vertexBufferOffset + _filledVertex + indices[i];
+        _indices[filledIndex + i] = base + indices[i];
     }
-
-    _filledVertex += vertexCount;
-    _filledIndex += indexCount;
 }
 
 void Renderer::drawBatchedTriangles()
@@ -635,7 +1171,7 @@ void Renderer::drawBatchedTriangles()
     unsigned int indexBufferFillOffset  = 0;
 #endif
 
-    _triBatchesToDraw[0].offset        = indexBufferFillOffset;
+    _triBatchesToDraw[0].offset        = 0;
     _triBatchesToDraw[0].indicesToDraw = 0;
     _triBatchesToDraw[0].cmd           = nullptr;
 
@@ -645,13 +1181,17 @@ void Renderer::drawBatchedTriangles()
 
     _filledVertex = 0;
     _filledIndex  = 0;
+    _trianglesFillOffsets.clear();
 
     for (const auto& cmd : _queuedTriangleCommands)
     {
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable   = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd, vertexBufferFillOffset);
+        // prefix sum of the vertices and indices, every command owns a disjoint range
+        _trianglesFillOffsets.push_back({_filledVertex, _filledIndex});
+        _filledVertex += static_cast<unsigned int>(cmd->getVertexCount());
+        _filledIndex += static_cast<unsigned int>(cmd->getIndexCount());
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -691,13 +1231,37 @@ void Renderer::drawBatchedTriangles()
         firstCommand   = false;
     }
     batchesTotal++;
+
+#ifndef AX_USE_METAL
+    // the data goes to the next free ranges of the stream buffers, the indices must point into that vertex range
+    vertexBufferFillOffset = static_cast<unsigned int>(
+        _vertexBuffer->getNextStreamOffset(_filledVertex * sizeof(_verts[0]), sizeof(_verts[0])) / sizeof(_verts[0]));
+    indexBufferFillOffset = static_cast<unsigned int>(
+        _indexBuffer->getNextStreamOffset(_filledIndex * sizeof(_indices[0]), sizeof(_indices[0])) /
+        sizeof(_indices[0]));
+#endif
+    for (int i = 0; i < batchesTotal; ++i)
+        _triBatchesToDraw[i].offset += indexBufferFillOffset;
+
+    auto fillRange = [this, vertexBufferFillOffset](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+        {
+            auto& offset = _trianglesFillOffsets[i];
+            fillVerticesAndIndices(_queuedTriangleCommands[i], vertexBufferFillOffset, offset.vertex, offset.index);
+        }
+    };
+    if (_trianglesFillWorkers && _filledVertex >= _parallelFillThreshold)
+        _trianglesFillWorkers->run(_queuedTriangleCommands.size(), fillRange);
+    else
+        fillRange(0, _queuedTriangleCommands.size());
+
 #ifdef AX_USE_METAL
     _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]), _filledVertex * sizeof(_verts[0]));
     _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
                                 _filledIndex * sizeof(_indices[0]));
 #else
-    _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
+    _vertexBuffer->streamData(_verts, _filledVertex * sizeof(_verts[0]), sizeof(_verts[0]));
+    _indexBuffer->streamData(_indices, _filledIndex * sizeof(_indices[0]), sizeof(_indices[0]));
 #endif
 
     /************** 2: Draw *************/
@@ -774,6 +1338,26 @@ void Renderer::drawCustomCommand(RenderCommand* command)
 
 void Renderer::drawMeshCommand(RenderCommand* command)
 {
+    auto cmd = static_cast<MeshCommand*>(command);
+    if (_autoInstancingEnabled && _instancingSupported && isAutoInstanceable(cmd))
+    {
+        // queue it, the batch is drawn when a mesh which can't join it comes
+        if (!_queuedMeshCommands.empty() && (_queuedMeshCommands.size() >= INSTANCE_BATCH_SIZE ||
+                                             !canShareInstancedDraw(_queuedMeshCommands.front(), cmd)))
+            flush3D();
+        _queuedMeshCommands.emplace_back(cmd);
+        return;
+    }
+
+    flush3D();
+    if (needsInstanceTransforms(cmd))
+    {
+        // drawn alone, its model view still comes from the instance buffer
+        _queuedMeshCommands.emplace_back(cmd);
+        flush3D();
+        return;
+    }
+
     // MeshCommand and CustomCommand are identical while rendering.
     drawCustomCommand(command);
 }
@@ -791,8 +1375,79 @@ void Renderer::flush2D()
 
 void Renderer::flush3D()
 {
-    // TODO 3d instanced rendering
-    // https://learnopengl.com/Advanced-OpenGL/Instancing
+    const auto count = _queuedMeshCommands.size();
+    if (count == 0)
+        return;
+
+    // a single mesh of the unlit program is drawn as it is, the instanced programs read its model view from a_instance
+    auto leader = _queuedMeshCommands.front();
+    if (count == 1 && !needsInstanceTransforms(leader))
+    {
+        _queuedMeshCommands.clear();
+        drawCustomCommand(leader);
+        return;
+    }
+    _instanceTransforms.clear();
+    for (auto&& cmd : _queuedMeshCommands)
+        _instanceTransforms.emplace_back(cmd->getMV());
+    _queuedMeshCommands.clear();
+
+    // the instance buffers are reused in the next frame, each batch of this frame gets its own
+    if (_usedInstanceBuffers == _instanceBuffers.size())
+        _instanceBuffers.emplace_back(backend::DriverBase::getInstance()->newBuffer(
+            INSTANCE_BATCH_SIZE * sizeof(Mat4), backend::BufferType::VERTEX, backend::BufferUsage::DYNAMIC));
+    auto instanceBuffer = _instanceBuffers[_usedInstanceBuffers++];
+    instanceBuffer->updateData(_instanceTransforms.data(), count * sizeof(Mat4));
+
+    // the leader binds the states of the whole batch, with an identity model view its pass sets
+    // u_MVPMatrix to the view projection
+    const Mat4 modelView     = leader->getMV();
+    auto& pipelineDescriptor = leader->getPipelineDescriptor();
+    auto programState        = pipelineDescriptor.programState;
+    if (!needsInstanceTransforms(leader))
+        pipelineDescriptor.programState = getInstanceProgramState(programState);
+    leader->setMV(Mat4::IDENTITY);
+    leader->setDrawType(CustomCommand::DrawType::ELEMENT_INSTANCE);
+    leader->setInstanceBuffer(instanceBuffer, static_cast<int>(count));
+    drawCustomCommand(leader);
+    leader->setInstanceBuffer(nullptr, 0);
+    leader->setDrawType(CustomCommand::DrawType::ELEMENT);
+    leader->setMV(modelView);
+    pipelineDescriptor.programState = programState;
+
+    _instancedMeshes += count;
+}
+
+backend::ProgramState* Renderer::getInstanceProgramState(backend::ProgramState* unlitProgramState)
+{
+    // like the instance buffers, each batch of this frame gets its own
+    if (_usedInstanceProgramStates == _instanceProgramStates.size())
+        _instanceProgramStates.emplace_back(new backend::ProgramState(
+            backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_3D_INSTANCE)));
+    auto programState = _instanceProgramStates[_usedInstanceProgramStates++];
+
+    // both programs read the same vertices and share the fragment shader
+    programState->setSharedVertexLayout(const_cast<backend::VertexLayout*>(unlitProgramState->getVertexLayout()));
+
+    auto colorLocation = unlitProgramState->getUniformLocation("u_color"sv);
+    if (colorLocation)
+        programState->setUniform(programState->getUniformLocation("u_color"sv),
+                                 getUniformData(unlitProgramState, colorLocation), sizeof(Vec4));
+
+    auto textureLocation = unlitProgramState->getUniformLocation(backend::Uniform::TEXTURE);
+    auto& textureInfos   = textureLocation.shaderStage == backend::ShaderStage::VERTEX
+                               ? unlitProgramState->getVertexTextureInfos()
+                               : unlitProgramState->getFragmentTextureInfos();
+    auto textureIt       = textureInfos.find(textureLocation.location[0]);
+    if (textureIt != textureInfos.end() && !textureIt->second.textures.empty())
+        programState->setTexture(programState->getUniformLocation(backend::Uniform::TEXTURE),
+                                 textureIt->second.slots[0], textureIt->second.textures[0]);
+
+    // the pass of the leader sets u_MVPMatrix of its own program state, the model views are in the instance buffer
+    auto& projection = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    programState->setUniform(programState->getUniformLocation(backend::Uniform::MVP_MATRIX), projection.m,
+                             sizeof(projection.m));
+    return programState;
 }
 
 void Renderer::flushTriangles()
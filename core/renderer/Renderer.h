@@ -63,6 +63,7 @@ class MeshCommand;
 class GroupCommand;
 class CallbackCommand;
 struct PipelineDescriptor;
+struct RenderQueueSortContext;
 class Texture2D;
 
 /** Class that knows how to sort `RenderCommand` objects.
@@ -100,6 +101,12 @@ public:
     ssize_t size() const;
     /**Sort the render commands.*/
     void sort();
+    /**
+     Sort the render commands by packed 64-bit keys (queue group, globalZ, depth-safety class, material ID)
+     with a radix sort, then move batchable commands next to an earlier command of the same material
+     when they don't overlap any command they are moved over.
+     */
+    void sortByKey(RenderQueueSortContext& context);
     /**Treat sorted commands as an array, access them one by one.*/
     RenderCommand* operator[](ssize_t index) const;
     /**Clear all rendered commands.*/
@@ -123,6 +130,40 @@ protected:
     bool _isDepthWrite;
 };
 
+/**
+ Scratch buffers of the sort-key based render queue ordering, see `Renderer::setCommandReorderEnabled`.
+ They are kept between frames to avoid allocations.
+ */
+struct RenderQueueSortContext
+{
+    struct Entry
+    {
+        uint64_t key;
+        RenderCommand* command;
+    };
+
+    /** A run of batchable commands sharing a material, with the union of their bounds. */
+    struct Batch
+    {
+        uint32_t materialID;
+        bool batchable;
+        bool flat;
+        float z;
+        float minX, minY, maxX, maxY;
+        int first;
+        int last;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<Entry> scratch;
+    std::vector<Batch> batches;
+    std::vector<int> next;
+    std::vector<RenderCommand*> commands;
+
+    /** The number of draw calls saved by the reordering since the stats were cleared. */
+    size_t savedBatches = 0;
+};
+
 class GroupCommandManager;
 
 /* Class responsible for the rendering in.
@@ -182,8 +223,67 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /* returns the number of 3D meshes drawn in the last frame */
+    ssize_t getDrawnMeshes() const { return _drawnMeshes; }
+    /* MeshRenderer updates this value for the meshes inside the frustum of the visiting camera */
+    void addDrawnMeshes(ssize_t number) { _drawnMeshes += number; };
+    /* returns the number of 3D meshes skipped by frustum culling in the last frame */
+    ssize_t getCulledMeshes() const { return _culledMeshes; }
+    /* MeshRenderer updates this value for the meshes outside the frustum of the visiting camera */
+    void addCulledMeshes(ssize_t number) { _culledMeshes += number; };
+    /* returns the number of 3D meshes merged into instanced draws by automatic instancing in the last frame */
+    ssize_t getInstancedMeshes() const { return _instancedMeshes; }
+    /* returns the number of draw calls saved by reordering the render commands in the last frame */
+    ssize_t getReorderSavedBatches() const { return _sortContext.savedBatches; }
+    /* returns the number of backend calls skipped because the state was already applied in the last frame */
+    std::size_t getElidedCalls() const;
     /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    void clearDrawStats();
+
+    /**
+     * Enable/disable the sort-key based render queue ordering.
+     * Every command gets a packed 64-bit sort key and the queues are radix sorted by it: opaque 3D meshes are
+     * grouped by material, and batchable TrianglesCommands with the same globalZ are reordered when they don't
+     * overlap, so interleaved atlases no longer break the batches. Disabled by default.
+     */
+    void setCommandReorderEnabled(bool enabled) { _commandReorderEnabled = enabled; }
+
+    /** Whether the sort-key based render queue ordering is enabled. */
+    bool isCommandReorderEnabled() const { return _commandReorderEnabled; }
+
+    /**
+     * Enable/disable the automatic instancing of opaque 3D meshes.
+     * Consecutive opaque MeshCommands whose program has the `a_instance` attribute and which share the geometry,
+     * render states, textures and uniforms are drawn with one instanced draw call: the model transform of each
+     * mesh goes to the instance buffer and u_MVPMatrix only holds the view projection. The sort-key based
+     * ordering keeps such meshes adjacent, see `setCommandReorderEnabled`. Enabled by default.
+     * Meshes of the builtin unlit material are batched with its instanced variant, a mesh left alone keeps its
+     * program. Nothing is batched when the device doesn't support instancing.
+     */
+    void setAutoInstancingEnabled(bool enabled) { _autoInstancingEnabled = enabled; }
+
+    /** Whether opaque 3D meshes are instanced automatically. */
+    bool isAutoInstancingEnabled() const { return _autoInstancingEnabled; }
+
+    /**
+     * Enable/disable filling the vertices and indices of batched triangles on worker threads.
+     * The queued TrianglesCommands are split across the workers, each command is written to its own
+     * prefix-summed range of the vertex and index arrays, so the result is identical to a serial fill.
+     * @param enabled true to create the worker threads, false to destroy them and fill on the render thread.
+     */
+    void setParallelTrianglesFill(bool enabled);
+
+    /** Whether batched triangles are filled on worker threads. */
+    bool isParallelTrianglesFill() const { return _trianglesFillWorkers != nullptr; }
+
+    /**
+     * Set the minimum number of vertices a batch must have to be filled on worker threads,
+     * smaller batches are cheaper to fill on the render thread.
+     */
+    void setParallelTrianglesFillThreshold(unsigned int vertexCount) { _parallelFillThreshold = vertexCount; }
+
+    /** Get the minimum number of vertices a batch must have to be filled on worker threads. */
+    unsigned int getParallelTrianglesFillThreshold() const { return _parallelFillThreshold; }
 
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
@@ -482,6 +582,7 @@ protected:
     void flush2D();
 
     void flush3D();
+    backend::ProgramState* getInstanceProgramState(backend::ProgramState* unlitProgramState);
 
     void flushTriangles();
 
@@ -490,7 +591,10 @@ protected:
     void visitRenderQueue(RenderQueue& queue);
     void doVisitRenderQueue(const std::vector<RenderCommand*>&);
 
-    void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
+    void fillVerticesAndIndices(const TrianglesCommand* cmd,
+                                unsigned int vertexBufferOffset,
+                                unsigned int filledVertex,
+                                unsigned int filledIndex);
 
     void pushStateBlock();
 
@@ -520,6 +624,16 @@ protected:
     backend::Buffer* _indexBuffer  = nullptr;
     TriangleCommandBufferManager _triangleCommandBufferManager;
 
+    // for the automatic instancing of MeshCommands
+    std::vector<MeshCommand*> _queuedMeshCommands;
+    std::vector<Mat4> _instanceTransforms;
+    std::vector<backend::Buffer*> _instanceBuffers;
+    size_t _usedInstanceBuffers = 0;
+    // the instanced unlit program states drawing the batches of the builtin unlit material
+    std::vector<backend::ProgramState*> _instanceProgramStates;
+    size_t _usedInstanceProgramStates = 0;
+    bool _instancingSupported         = false;
+
     backend::CommandBuffer* _commandBuffer = nullptr;
     backend::RenderPassDescriptor _renderPassDesc;
 
@@ -545,9 +659,28 @@ protected:
     unsigned int _filledIndex            = 0;
     unsigned int _filledVertex           = 0;
 
+    // the offsets in _verts and _indices of each queued TrianglesCommand
+    struct TrianglesFillOffset
+    {
+        unsigned int vertex = 0;
+        unsigned int index  = 0;
+    };
+    std::vector<TrianglesFillOffset> _trianglesFillOffsets;
+
+    class TrianglesFillWorkers;
+    TrianglesFillWorkers* _trianglesFillWorkers = nullptr;
+    unsigned int _parallelFillThreshold         = 4096;
+
     // stats
-    size_t _drawnBatches  = 0;
-    size_t _drawnVertices = 0;
+    size_t _drawnBatches    = 0;
+    size_t _drawnVertices   = 0;
+    size_t _drawnMeshes     = 0;
+    size_t _culledMeshes    = 0;
+    size_t _instancedMeshes = 0;
+
+    bool _commandReorderEnabled = false;
+    bool _autoInstancingEnabled = true;
+    RenderQueueSortContext _sortContext;
     // the flag for checking whether renderer is rendering
     bool _isRendering      = false;
     bool _isDepthTestFor2D = false;
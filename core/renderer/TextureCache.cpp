@@ -33,12 +33,15 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <algorithm>
+#include <chrono>
 
 #include "renderer/Texture2D.h"
 #include "base/Macros.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/FrameProfiler.h"
 #include "platform/FileUtils.h"
 #include "base/Utils.h"
 #include "base/NinePatchImageParser.h"
@@ -62,17 +65,7 @@ std::string TextureCache::getETC1AlphaFileSuffix()
     return s_etc1AlphaFileSuffix;
 }
 
-TextureCache::TextureCache() : _loadingThread(nullptr), _needQuit(false), _asyncRefCount(0) {}
-
-TextureCache::~TextureCache()
-{
-    AXLOGINFO("deallocing TextureCache: %p", this);
-
-    for (auto&& texture : _textures)
-        texture.second->release();
-
-    AX_SAFE_DELETE(_loadingThread);
-}
+TextureCache::TextureCache() : _needQuit(false), _asyncRefCount(0), _asyncUploadBudget(0.0f) {}
 
 std::string TextureCache::getDescription() const
 {
@@ -88,6 +81,7 @@ public:
         , callbackKey(key)
         , pixelFormat(Texture2D::getDefaultAlphaPixelFormat())
         , loadSuccess(false)
+        , cancelled(false)
     {}
 
     std::string filename;
@@ -97,26 +91,40 @@ public:
     Image imageAlpha;
     backend::PixelFormat pixelFormat;
     bool loadSuccess;
+    std::atomic<bool> cancelled;
+    JobSystem::JobHandle job;
 };
 
+TextureCache::~TextureCache()
+{
+    AXLOGINFO("deallocing TextureCache: %p", this);
+
+    for (auto&& texture : _textures)
+        texture.second->release();
+
+    // the decode jobs finished in waitForQuit
+    for (auto&& asyncStruct : _asyncStructQueue)
+        delete asyncStruct;
+}
+
 /**
  The addImageAsync logic follow the steps:
- - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to
- _responseQueue (Load thread)
+ - find the image has been add or not, if not schedule a decode job for a new AsyncStruct  (GL thread)
+ - the job loads res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (JobSystem
+ workers, several images are decoded in parallel, higher priority requests first)
  - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL
- thread)
+ thread), until the upload budget of the frame is spent
 
  the Critical Area include these members:
- - _requestQueue: locked by _requestMutex
  - _responseQueue: locked by _responseMutex
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
+ - image data: new in a worker thread, delete in GL thread(by Image instance)
 
  Note:
- - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+ - all AsyncStruct referenced in _asyncStructQueue, for unbind/cancel function use.
+ - the decode jobs complete in any order, so _responseQueue order differs from _asyncStructQueue order.
 
  How to deal add image many times?
  - At first, this situation is abnormal, we only ensure the logic is correct.
@@ -125,46 +133,18 @@ public:
  - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
 
  Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
+ - Creating a big texture can take several milliseconds, set an upload budget with setAsyncUploadBudget
+ to spread the uploads over several frames.
 
  Call unbindImageAsync(path) to prevent the call to the callback when the
- texture is loaded.
+ texture is loaded, cancelImageAsync(path) to drop the request entirely.
  */
 void TextureCache::addImageAsync(std::string_view path, const std::function<void(Texture2D*)>& callback)
 {
-    addImageAsync(path, callback, path);
+    addImageAsync(path, callback, path, JobSystem::Priority::NORMAL);
 }
 
 /**
- The addImageAsync logic follow the steps:
- - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to
- _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL
- thread)
-
- the Critical Area include these members:
- - _requestQueue: locked by _requestMutex
- - _responseQueue: locked by _responseMutex
-
- the object's life time:
- - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
-
- Note:
- - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
-
- How to deal add image many times?
- - At first, this situation is abnormal, we only ensure the logic is correct.
- - If the image has been loaded, the after load image call will return immediately.
- - If the image request is in queue already, there will be more than one request in queue,
- - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
-
- Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
-
  The callbackKey allows to unbind the callback in cases where the loading of
  path is requested by several sources simultaneously. Each source can then
  unbind the callback independently as needed whilst a call to
@@ -173,6 +153,14 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 void TextureCache::addImageAsync(std::string_view path,
                                  const std::function<void(Texture2D*)>& callback,
                                  std::string_view callbackKey)
+{
+    addImageAsync(path, callback, callbackKey, JobSystem::Priority::NORMAL);
+}
+
+void TextureCache::addImageAsync(std::string_view path,
+                                 const std::function<void(Texture2D*)>& callback,
+                                 std::string_view callbackKey,
+                                 JobSystem::Priority priority)
 {
     Texture2D* texture = nullptr;
 
@@ -197,13 +185,7 @@ void TextureCache::addImageAsync(std::string_view path,
         return;
     }
 
-    // lazy init
-    if (_loadingThread == nullptr)
-    {
-        // create a new thread to load images
-        _needQuit      = false;
-        _loadingThread = new std::thread(&TextureCache::loadImage, this);
-    }
+    _needQuit = false;
 
     if (0 == _asyncRefCount)
     {
@@ -218,9 +200,7 @@ void TextureCache::addImageAsync(std::string_view path,
 
     // add async struct into queue
     _asyncStructQueue.emplace_back(data);
-    std::unique_lock<std::mutex> ul(_requestMutex);
-    _requestQueue.emplace_back(data);
-    _sleepCondition.notify_one();
+    data->job = JobSystem::getInstance()->schedule([this, data] { loadImage(data); }, priority);
 }
 
 void TextureCache::unbindImageAsync(std::string_view callbackKey)
@@ -251,34 +231,34 @@ void TextureCache::unbindAllImageAsync()
     }
 }
 
-void TextureCache::loadImage()
+void TextureCache::cancelImageAsync(std::string_view callbackKey)
 {
-    AsyncStruct* asyncStruct = nullptr;
-    while (!_needQuit)
+    for (auto&& asyncStruct : _asyncStructQueue)
     {
-        std::unique_lock<std::mutex> ul(_requestMutex);
-        // pop an AsyncStruct from request queue
-        if (_requestQueue.empty())
-        {
-            asyncStruct = nullptr;
-        }
-        else
+        if (asyncStruct->callbackKey == callbackKey)
         {
-            asyncStruct = _requestQueue.front();
-            _requestQueue.pop_front();
+            asyncStruct->callback  = nullptr;
+            asyncStruct->cancelled = true;
         }
+    }
+}
 
-        if (nullptr == asyncStruct)
-        {
-            if (_needQuit)
-            {
-                break;
-            }
-            _sleepCondition.wait(ul);
-            continue;
-        }
-        ul.unlock();
+void TextureCache::cancelAllImageAsync()
+{
+    for (auto&& asyncStruct : _asyncStructQueue)
+    {
+        asyncStruct->callback  = nullptr;
+        asyncStruct->cancelled = true;
+    }
+}
+
+void TextureCache::loadImage(AsyncStruct* asyncStruct)
+{
+    AX_PROFILE_ZONE("TextureCache::loadImage");
 
+    // cancelled requests still go through the response queue, they are released in GL thread
+    if (!asyncStruct->cancelled && !_needQuit)
+    {
         // load image
         asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
 
@@ -290,17 +270,22 @@ void TextureCache::loadImage()
             if (FileUtils::getInstance()->isFileExist(alphaFile))
                 asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
         }
-        // push the asyncStruct to response queue
-        _responseMutex.lock();
-        _responseQueue.emplace_back(asyncStruct);
-        _responseMutex.unlock();
     }
+
+    // push the asyncStruct to response queue
+    _responseMutex.lock();
+    _responseQueue.emplace_back(asyncStruct);
+    _responseMutex.unlock();
 }
 
 void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
+    AX_PROFILE_ZONE("TextureCache::addImageAsyncCallBack");
+
     Texture2D* texture       = nullptr;
     AsyncStruct* asyncStruct = nullptr;
+
+    const auto startTime = std::chrono::steady_clock::now();
     while (true)
     {
         // pop an AsyncStruct from response queue
@@ -313,10 +298,6 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         {
             asyncStruct = _responseQueue.front();
             _responseQueue.pop_front();
-
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            AX_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
         }
         _responseMutex.unlock();
 
@@ -325,6 +306,15 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             break;
         }
 
+        _asyncStructQueue.erase(std::find(_asyncStructQueue.begin(), _asyncStructQueue.end(), asyncStruct));
+
+        if (asyncStruct->cancelled)
+        {
+            delete asyncStruct;
+            --_asyncRefCount;
+            continue;
+        }
+
         // check the image has been convert to texture or not
         auto it = _textures.find(asyncStruct->filename);
         if (it != _textures.end())
@@ -374,6 +364,13 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         // release the asyncStruct
         delete asyncStruct;
         --_asyncRefCount;
+
+        // leave the remaining uploads to the next frames
+        if (_asyncUploadBudget > 0.0f &&
+            std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count() >= _asyncUploadBudget)
+        {
+            break;
+        }
     }
 
     if (0 == _asyncRefCount)
@@ -437,6 +434,8 @@ Texture2D* TextureCache::addImage(std::string_view path)
 
 Texture2D* TextureCache::addImage(std::string_view path, PixelFormat format)
 {
+    AX_PROFILE_ZONE("TextureCache::addImage");
+
     Texture2D* texture = nullptr;
     Image* image       = nullptr;
     // Split up directory and filename
@@ -690,13 +689,10 @@ std::string TextureCache::getTextureFilePath(ax::Texture2D* texture) const
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
-    std::unique_lock<std::mutex> ul(_requestMutex);
+    // the pending decode jobs skip the decoding, wait for them since they reference this
     _needQuit = true;
-    _sleepCondition.notify_one();
-    ul.unlock();
-    if (_loadingThread)
-        _loadingThread->join();
+    for (auto&& asyncStruct : _asyncStructQueue)
+        JobSystem::getInstance()->wait(asyncStruct->job);
 }
 
 std::string TextureCache::getCachedTextureInfo() const
@@ -30,9 +30,8 @@ THE SOFTWARE.
 #ifndef __CCTEXTURE_CACHE_H__
 #define __CCTEXTURE_CACHE_H__
 
+#include <atomic>
 #include <mutex>
-#include <thread>
-#include <condition_variable>
 #include <queue>
 #include <string>
 #include <unordered_map>
@@ -41,6 +40,7 @@ THE SOFTWARE.
 #include "base/Ref.h"
 #include "renderer/Texture2D.h"
 #include "platform/Image.h"
+#include "base/JobSystem.h"
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
 #    include <list>
@@ -123,6 +123,32 @@ public:
                        const std::function<void(Texture2D*)>& callback,
                        std::string_view callbackKey);
 
+    /** Same as addImageAsync, with a decode priority.
+     * The images are decoded in parallel by the JobSystem workers, requests with a higher priority are decoded first.
+     * @param priority Decode priority of this request, e.g. HIGH for the atlases of the next scene, LOW for prefetch.
+     */
+    void addImageAsync(std::string_view path,
+                       const std::function<void(Texture2D*)>& callback,
+                       std::string_view callbackKey,
+                       JobSystem::Priority priority);
+
+    /** Cancel the asynchronous loads bound to callbackKey.
+     * Unlike unbindImageAsync, the image is neither decoded, if the decode hasn't started yet, nor uploaded to a
+     * texture, and the callback is never invoked.
+     * @param callbackKey The key passed to addImageAsync, the file path by default.
+     */
+    void cancelImageAsync(std::string_view callbackKey);
+
+    /** Cancel all asynchronous loads which are not completed yet. */
+    void cancelAllImageAsync();
+
+    /** Sets the time the axmol thread may spend per frame creating textures from the decoded images.
+     * At least one texture is created each frame, the remaining ones are deferred to the next frames.
+     * @param seconds The budget, 0 to create all the decoded textures in the same frame (default).
+     */
+    void setAsyncUploadBudget(float seconds) { _asyncUploadBudget = seconds; }
+    float getAsyncUploadBudget() const { return _asyncUploadBudget; }
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is
      * invoked, the object always need to unbind this callback manually.
@@ -216,28 +242,25 @@ public:
 
 private:
     void addImageAsyncCallBack(float dt);
-    void loadImage();
     void parseNinePatchImage(Image* image, Texture2D* texture, std::string_view path);
 
 public:
 protected:
     struct AsyncStruct;
 
-    std::thread* _loadingThread;
+    void loadImage(AsyncStruct* asyncStruct);
 
     std::deque<AsyncStruct*> _asyncStructQueue;
-    std::deque<AsyncStruct*> _requestQueue;
     std::deque<AsyncStruct*> _responseQueue;
 
-    std::mutex _requestMutex;
     std::mutex _responseMutex;
 
-    std::condition_variable _sleepCondition;
-
-    bool _needQuit;
+    std::atomic<bool> _needQuit;
 
     int _asyncRefCount;
 
+    float _asyncUploadBudget;
+
     hlookup::string_map<Texture2D*> _textures;
 
     static std::string s_etc1AlphaFileSuffix;
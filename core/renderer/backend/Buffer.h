@@ -65,6 +65,35 @@ public:
      */
     virtual void updateSubData(const void* data, std::size_t offset, std::size_t size) = 0;
 
+    /**
+     * @brief Stream data into the next free sub-range of the buffer
+     * The buffer is used as a ring: every call writes after the range of the previous one, so the ranges
+     * handed out before stay untouched for the draws which still read them. When the end of the buffer is
+     * reached the ring wraps around, backends make sure the GPU doesn't read the overwritten data any more.
+     * @param data Specifies a pointer to the data that will be copied into the data store.
+     * @param size Specifies the size in bytes of the data, must not exceed the buffer size.
+     * @param alignment Specifies the alignment in bytes of the range offset, e.g. the vertex stride.
+     * @return The offset in bytes of the range the data was written to.
+     * @see `getNextStreamOffset(std::size_t size, std::size_t alignment)`
+     */
+    virtual std::size_t streamData(const void* data, std::size_t size, std::size_t alignment = 4)
+    {
+        bool wrapped = false;
+        auto offset  = allocateStreamRange(size, alignment, wrapped);
+        updateSubData(data, offset, size);
+        return offset;
+    }
+
+    /**
+     * Get the offset the next `streamData` call with the same size and alignment will write to.
+     * Useful when the data refers to its own location, e.g. indices to vertices streamed into the same frame.
+     */
+    std::size_t getNextStreamOffset(std::size_t size, std::size_t alignment = 4) const
+    {
+        auto offset = (_streamOffset + alignment - 1) / alignment * alignment;
+        return offset + size > _size ? 0 : offset;
+    }
+
     /**
      * By default, static buffer data will automatically stored when it comes to foreground.
      * This function is used to indicate whether external data needs to be used to update the buffer instead of using
@@ -91,9 +120,23 @@ protected:
 
     virtual ~Buffer() = default;
 
-    BufferUsage _usage = BufferUsage::DYNAMIC;  ///< Buffer usage.
-    BufferType _type   = BufferType::VERTEX;    ///< Buffer type.
-    std::size_t _size  = 0;                     ///< buffer size in bytes.
+    /**
+     * Allocate the next range of the stream ring.
+     * @param wrapped Set to true when the ring wrapped around to the beginning of the buffer.
+     * @return The offset in bytes of the range.
+     */
+    std::size_t allocateStreamRange(std::size_t size, std::size_t alignment, bool& wrapped)
+    {
+        auto offset   = getNextStreamOffset(size, alignment);
+        wrapped       = offset == 0 && _streamOffset != 0;
+        _streamOffset = offset + size;
+        return offset;
+    }
+
+    BufferUsage _usage        = BufferUsage::DYNAMIC;  ///< Buffer usage.
+    BufferType _type          = BufferType::VERTEX;    ///< Buffer type.
+    std::size_t _size         = 0;                     ///< buffer size in bytes.
+    std::size_t _streamOffset = 0;                     ///< offset of the next stream range in bytes.
 };
 
 // end of _backend group
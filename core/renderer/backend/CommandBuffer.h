@@ -220,6 +220,17 @@ public:
      */
     virtual void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) = 0;
 
+    /**
+     * Get the number of backend calls skipped because the state they would set was already applied,
+     * e.g. unchanged uniforms and texture bindings.
+     */
+    virtual std::size_t getElidedCalls() const { return 0; }
+
+    /**
+     * Reset the elided calls counter, the renderer does it at the beginning of each frame.
+     */
+    virtual void resetElidedCalls() {}
+
     /**
      * Update both front and back stencil reference value.
      * @param value Specifies stencil reference value.
@@ -24,9 +24,16 @@
  ****************************************************************************/
 
 #include "DriverBase.h"
+#include "base/Macros.h"
 
 NS_AX_BACKEND_BEGIN
 
 DriverBase* DriverBase::_instance = nullptr;
 
+void DriverBase::setInstance(DriverBase* driver)
+{
+    AXASSERT(_instance == nullptr, "The driver is already in use");
+    _instance = driver;
+}
+
 NS_AX_BACKEND_END
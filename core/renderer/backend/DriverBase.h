@@ -61,7 +61,8 @@ enum class FeatureType : uint32_t
     VAO,
     MAPBUFFER,
     DEPTH24,
-    ASTC
+    ASTC,
+    INSTANCING
 };
 
 /**
@@ -83,6 +84,17 @@ public:
      */
     static DriverBase* getInstance();
 
+    /**
+     * Use driver as the shared instance instead of the one of the platform backend, e.g. a DriverNull
+     * to run without GPU. Must be called before anything uses the driver.
+     */
+    static void setInstance(DriverBase* driver);
+
+    /**
+     * Check whether the shared instance was already created or set.
+     */
+    static bool hasInstance() { return _instance != nullptr; }
+
     virtual ~DriverBase() = default;
 
     /**
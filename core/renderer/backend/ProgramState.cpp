@@ -31,6 +31,7 @@
 #include "base/EventType.h"
 #include "base/Director.h"
 #include <algorithm>
+#include <atomic>
 #include "xxhash/xxhash.h"
 
 #include "glslcc/sgs-spec.h"
@@ -40,6 +41,9 @@ NS_AX_BACKEND_BEGIN
 // static field
 std::vector<ProgramState::AutoBindingResolver*> ProgramState::_customAutoBindingResolvers;
 
+// shared by all program states, so (program state, revision) identifies uniform data uniquely
+static std::atomic<uint64_t> s_uniformRevision{0};
+
 TextureInfo::TextureInfo(std::vector<int>&& _slots, std::vector<backend::TextureBackend*>&& _textures)
     : TextureInfo(std::move(_slots), std::vector<int>(_slots.size(), 0), std::move(_textures))
 {}
@@ -147,6 +151,9 @@ bool ProgramState::init(Program* program)
 #endif
 
     _uniformBuffers.resize((std::max)(_vertexUniformBufferSize + _fragmentUniformBufferSize, (size_t)1), 0);
+    _uniformDirtyBegin = 0;
+    _uniformDirtyEnd   = _uniformBuffers.size();
+    _uniformRevision   = ++s_uniformRevision;
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     _backToForegroundListener =
@@ -205,6 +212,8 @@ ProgramState* ProgramState::clone() const
     cp->_vertexTextureInfos   = _vertexTextureInfos;
     cp->_fragmentTextureInfos = _fragmentTextureInfos;
     cp->_uniformBuffers       = _uniformBuffers;
+    cp->_uniformDirtyBegin    = 0;
+    cp->_uniformDirtyEnd      = cp->_uniformBuffers.size();
 
     cp->_ownVertexLayout = _ownVertexLayout;
     cp->_vertexLayout    = !_ownVertexLayout ? _vertexLayout : new VertexLayout(*_vertexLayout);
@@ -248,10 +257,10 @@ void ProgramState::setVertexUniform(int location, const void* data, std::size_t
         return;
 #if AX_GLES_PROFILE != 200
     assert(location + offset + size <= _vertexUniformBufferSize);
-    memcpy(_uniformBuffers.data() + location + offset, data, size);
+    updateUniformBuffer(location + offset, data, size);
 #else
     assert(offset + size <= _vertexUniformBufferSize);
-    memcpy(_uniformBuffers.data() + offset, data, size);
+    updateUniformBuffer(offset, data, size);
 #endif
 }
 
@@ -261,12 +270,33 @@ void ProgramState::setFragmentUniform(int location, const void* data, std::size_
         return;
 
 #ifdef AX_USE_METAL
-    memcpy(_uniformBuffers.data() + _vertexUniformBufferSize + location + offset, data, size);
+    updateUniformBuffer(_vertexUniformBufferSize + location + offset, data, size);
 #else
     assert(false);
 #endif
 }
 
+void ProgramState::updateUniformBuffer(std::size_t offset, const void* data, std::size_t size)
+{
+    auto dst = _uniformBuffers.data() + offset;
+    if (memcmp(dst, data, size) == 0)
+        return;
+
+    memcpy(dst, data, size);
+
+    if (_uniformDirtyBegin < _uniformDirtyEnd)
+    {
+        _uniformDirtyBegin = (std::min)(_uniformDirtyBegin, offset);
+        _uniformDirtyEnd   = (std::max)(_uniformDirtyEnd, offset + size);
+    }
+    else
+    {
+        _uniformDirtyBegin = offset;
+        _uniformDirtyEnd   = offset + size;
+    }
+    _uniformRevision = ++s_uniformRevision;
+}
+
 void ProgramState::setVertexAttrib(std::string_view name,
                                    std::size_t index,
                                    VertexFormat format,
@@ -226,6 +226,28 @@ public:
      */
     const char* getFragmentUniformBuffer(std::size_t& size) const;
 
+    /**
+     * Get the revision of the uniform data, a new value is assigned whenever the content of the
+     * uniform buffer changes. Setting a uniform to the value it already has keeps the revision.
+     */
+    uint64_t getUniformRevision() const { return _uniformRevision; }
+
+    /**
+     * Get the byte range of the uniform buffer that changed since the backend last applied it.
+     * @param[out] begin The first changed byte.
+     * @param[out] end One past the last changed byte.
+     * @return false if nothing changed.
+     */
+    bool getUniformDirtyRange(std::size_t& begin, std::size_t& end) const
+    {
+        begin = _uniformDirtyBegin;
+        end   = _uniformDirtyEnd;
+        return begin < end;
+    }
+
+    /** Called by the backend once the uniform buffer was applied. */
+    void markUniformsApplied() { _uniformDirtyBegin = _uniformDirtyEnd = 0; }
+
     /**
      * An abstract base class that can be extended to support custom material auto bindings.
      *
@@ -381,11 +403,17 @@ protected:
      */
     void applyAutoBinding(std::string_view, std::string_view);
 
+    /// Copy data into the uniform buffer, extending the dirty range when the content changes.
+    void updateUniformBuffer(std::size_t offset, const void* data, std::size_t size);
+
     backend::Program* _program = nullptr;
     std::unordered_map<UniformLocation, UniformCallback, UniformLocation> _callbackUniforms;
     yasio::sbyte_buffer _uniformBuffers;
     std::size_t _vertexUniformBufferSize   = 0;
     std::size_t _fragmentUniformBufferSize = 0;
+    std::size_t _uniformDirtyBegin         = 0;
+    std::size_t _uniformDirtyEnd           = 0;
+    uint64_t _uniformRevision              = 0;
 
     std::unordered_map<int, TextureInfo> _vertexTextureInfos;
     std::unordered_map<int, TextureInfo> _fragmentTextureInfos;
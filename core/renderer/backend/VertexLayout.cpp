@@ -24,6 +24,7 @@
 
 #include "VertexLayout.h"
 #include "base/Macros.h"
+#include "xxhash.h"
 #include <cassert>
 
 NS_AX_BACKEND_BEGIN
@@ -45,11 +46,34 @@ void VertexLayout::setAttrib(std::string_view name,
         _attributes, name,
         Attribute{name, index, format, offset,
                   needToBeNormallized});  // _attributes[name] = {name, index, format, offset, needToBeNormallized};
+    _hash = 0;
 }
 
 void VertexLayout::setStride(std::size_t stride)
 {
     _stride = stride;
+    _hash   = 0;
+}
+
+uint32_t VertexLayout::getHash() const
+{
+    if (_hash)
+        return _hash;
+
+    const uint32_t stride = static_cast<uint32_t>(_stride);
+    uint32_t hash         = XXH32(&stride, sizeof(stride), 0);
+    for (const auto& iter : _attributes)
+    {
+        const auto& attribute   = iter.second;
+        const uint32_t hashMe[] = {static_cast<uint32_t>(attribute.index), static_cast<uint32_t>(attribute.format),
+                                   static_cast<uint32_t>(attribute.offset),
+                                   static_cast<uint32_t>(attribute.needToBeNormallized)};
+        hash                    = XXH32(hashMe, sizeof(hashMe), hash);
+    }
+
+    // keep 0 for 'not computed'
+    _hash = hash ? hash : 1;
+    return _hash;
 }
 
 NS_AX_BACKEND_END
@@ -120,9 +120,16 @@ public:
      */
     inline bool isValid() const { return _stride != 0; }
 
+    /**
+     * Get the hash of the attributes and stride, layouts with the same hash set up the vertex
+     * attributes identically.
+     */
+    uint32_t getHash() const;
+
 private:
     hlookup::string_map<Attribute> _attributes;
     std::size_t _stride      = 0;
+    mutable uint32_t _hash   = 0;  // 0: not computed yet
     VertexStepMode _stepMode = VertexStepMode::VERTEX;
 };
 
@@ -562,6 +562,9 @@ bool DriverMTL::checkForFeatureSupported(FeatureType feature)
     case FeatureType::ASTC:
         featureSupported = supportASTC(_featureSet);
         break;
+    case FeatureType::INSTANCING:
+        featureSupported = true;
+        break;
     default:
         break;
     }
@@ -0,0 +1,260 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "CommandBufferNull.h"
+#include "DriverNull.h"
+#include "RenderPipelineNull.h"
+#include "../Buffer.h"
+#include "../RenderTarget.h"
+
+NS_AX_BACKEND_BEGIN
+
+CommandBufferNull::CommandBufferNull(NullDriverStats& stats) : _stats(stats) {}
+
+CommandBufferNull::~CommandBufferNull()
+{
+    AX_SAFE_RELEASE_NULL(_programState);
+    endRenderPass();
+}
+
+void CommandBufferNull::beginRenderPass(const RenderTarget* /*renderTarget*/, const RenderPassDescriptor& /*descriptor*/)
+{
+    ++_stats.renderPasses;
+}
+
+void CommandBufferNull::setDepthStencilState(DepthStencilState* depthStencilState)
+{
+    _depthStencilState = depthStencilState;
+}
+
+void CommandBufferNull::setRenderPipeline(RenderPipeline* renderPipeline)
+{
+    _renderPipeline = static_cast<RenderPipelineNull*>(renderPipeline);
+}
+
+void CommandBufferNull::updateDepthStencilState(const DepthStencilDescriptor& descriptor)
+{
+    const auto& current = _depthStencilState->getDepthStencilInfo();
+    if (current.flags != descriptor.flags || current.depthCompareFunction != descriptor.depthCompareFunction ||
+        !(current.frontFaceStencil == descriptor.frontFaceStencil) ||
+        !(current.backFaceStencil == descriptor.backFaceStencil))
+        ++_stats.stateChanges;
+    _depthStencilState->update(descriptor);
+}
+
+void CommandBufferNull::updatePipelineState(const RenderTarget* rt, const PipelineDescriptor& descriptor)
+{
+    _renderPipeline->update(rt, descriptor);
+}
+
+void CommandBufferNull::setViewport(int x, int y, unsigned int w, unsigned int h)
+{
+    const int viewport[4] = {x, y, static_cast<int>(w), static_cast<int>(h)};
+    if (memcmp(_viewport, viewport, sizeof(viewport)) != 0)
+    {
+        memcpy(_viewport, viewport, sizeof(viewport));
+        ++_stats.stateChanges;
+    }
+}
+
+void CommandBufferNull::setCullMode(CullMode mode)
+{
+    if (_cullMode != mode)
+    {
+        _cullMode = mode;
+        ++_stats.stateChanges;
+    }
+}
+
+void CommandBufferNull::setWinding(Winding winding)
+{
+    if (_winding != winding)
+    {
+        _winding = winding;
+        ++_stats.stateChanges;
+    }
+}
+
+bool CommandBufferNull::setBuffer(Buffer*& current, Buffer* buffer)
+{
+    assert(buffer != nullptr);
+    if (buffer == nullptr || current == buffer)
+        return false;
+
+    buffer->retain();
+    AX_SAFE_RELEASE(current);
+    current = buffer;
+    ++_stats.stateChanges;
+    return true;
+}
+
+void CommandBufferNull::setVertexBuffer(Buffer* buffer)
+{
+    setBuffer(_vertexBuffer, buffer);
+}
+
+void CommandBufferNull::setIndexBuffer(Buffer* buffer)
+{
+    setBuffer(_indexBuffer, buffer);
+}
+
+void CommandBufferNull::setInstanceBuffer(Buffer* buffer)
+{
+    setBuffer(_instanceBuffer, buffer);
+}
+
+void CommandBufferNull::setProgramState(ProgramState* programState)
+{
+    AX_SAFE_RETAIN(programState);
+    AX_SAFE_RELEASE(_programState);
+    _programState = programState;
+}
+
+void CommandBufferNull::drawArrays(PrimitiveType /*primitiveType*/,
+                                   std::size_t /*start*/,
+                                   std::size_t count,
+                                   bool /*wireframe*/)
+{
+    draw(count);
+}
+
+void CommandBufferNull::drawElements(PrimitiveType /*primitiveType*/,
+                                     IndexFormat /*indexType*/,
+                                     std::size_t count,
+                                     std::size_t /*offset*/,
+                                     bool /*wireframe*/)
+{
+    draw(count);
+}
+
+void CommandBufferNull::drawElementsInstanced(PrimitiveType /*primitiveType*/,
+                                              IndexFormat /*indexType*/,
+                                              std::size_t count,
+                                              std::size_t /*offset*/,
+                                              int instanceCount,
+                                              bool /*wireframe*/)
+{
+    draw(count * instanceCount);
+}
+
+void CommandBufferNull::draw(std::size_t vertexCount)
+{
+    prepareDrawing();
+
+    ++_stats.drawCalls;
+    _stats.vertices += vertexCount;
+
+    AX_SAFE_RELEASE_NULL(_programState);
+}
+
+void CommandBufferNull::prepareDrawing()
+{
+    if (!_programState)
+        return;
+
+    auto& callbacks = _programState->getCallbackUniforms();
+    for (auto&& cb : callbacks)
+        cb.second(_programState, cb.first);
+
+    // count the uniform bytes the GL backend would upload
+    std::size_t bufferSize = 0, dirtyBegin = 0, dirtyEnd = 0;
+    _programState->getVertexUniformBuffer(bufferSize);
+    _programState->getUniformDirtyRange(dirtyBegin, dirtyEnd);
+
+    const auto program = _programState->getProgram();
+    if (program != _appliedProgram || _programState != _appliedOwner)
+        _stats.uniformBytes += bufferSize;
+    else if (_programState->getUniformRevision() != _appliedRevision)
+        _stats.uniformBytes += dirtyEnd - dirtyBegin;
+
+    _appliedProgram  = program;
+    _appliedOwner    = _programState;
+    _appliedRevision = _programState->getUniformRevision();
+    _programState->markUniformsApplied();
+
+    for (const auto& iter : _programState->getVertexTextureInfos())
+    {
+        auto& textures = iter.second.textures;
+        auto& slots    = iter.second.slots;
+        for (size_t i = 0; i < textures.size() && i < slots.size(); ++i)
+        {
+            auto slot = slots[i];
+            if (slot >= 0 && slot < MAX_TEXTURE_UNITS && _textures[slot] != textures[i])
+            {
+                _textures[slot] = textures[i];
+                ++_stats.textureBinds;
+            }
+        }
+    }
+}
+
+void CommandBufferNull::endRenderPass()
+{
+    AX_SAFE_RELEASE_NULL(_indexBuffer);
+    AX_SAFE_RELEASE_NULL(_vertexBuffer);
+    AX_SAFE_RELEASE_NULL(_instanceBuffer);
+}
+
+void CommandBufferNull::endFrame()
+{
+    ++_stats.frames;
+}
+
+void CommandBufferNull::setScissorRect(bool isEnabled, float x, float y, float width, float height)
+{
+    const float scissor[4] = {x, y, width, height};
+    if (isEnabled != _scissorEnabled || (isEnabled && memcmp(_scissor, scissor, sizeof(scissor)) != 0))
+    {
+        _scissorEnabled = isEnabled;
+        memcpy(_scissor, scissor, sizeof(scissor));
+        ++_stats.stateChanges;
+    }
+}
+
+void CommandBufferNull::readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
+{
+    // blank pixels of the expected size, e.g. for captureScreen
+    PixelBufferDescriptor pbd;
+    if (rt->isDefaultRenderTarget())
+    {
+        pbd._width  = _viewport[2];
+        pbd._height = _viewport[3];
+    }
+    else if (auto colorAttachment = rt->_color[0].texture)
+    {
+        pbd._width  = colorAttachment->getWidth();
+        pbd._height = colorAttachment->getHeight();
+    }
+
+    const auto bufferSize = static_cast<ssize_t>(pbd._width) * pbd._height * 4;
+    if (bufferSize > 0)
+    {
+        auto buffer = static_cast<uint8_t*>(calloc(bufferSize, 1));
+        pbd._data.fastSet(buffer, bufferSize);
+    }
+    callback(pbd);
+}
+
+NS_AX_BACKEND_END
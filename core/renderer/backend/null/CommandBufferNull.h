@@ -0,0 +1,113 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "../CommandBuffer.h"
+#include "../DepthStencilState.h"
+
+NS_AX_BACKEND_BEGIN
+
+struct NullDriverStats;
+class RenderPipelineNull;
+
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * Runs the CPU side of the commands, i.e. uniform callbacks and state tracking, then drops them.
+ */
+class CommandBufferNull : public CommandBuffer
+{
+public:
+    explicit CommandBufferNull(NullDriverStats& stats);
+    ~CommandBufferNull();
+
+    virtual bool beginFrame() override { return true; }
+    virtual void beginRenderPass(const RenderTarget* renderTarget, const RenderPassDescriptor& descriptor) override;
+    virtual void setDepthStencilState(DepthStencilState* depthStencilState) override;
+    virtual void setRenderPipeline(RenderPipeline* renderPipeline) override;
+    virtual void updateDepthStencilState(const DepthStencilDescriptor& descriptor) override;
+    virtual void updatePipelineState(const RenderTarget* rt, const PipelineDescriptor& descriptor) override;
+    virtual void setViewport(int x, int y, unsigned int w, unsigned int h) override;
+    virtual void setCullMode(CullMode mode) override;
+    virtual void setWinding(Winding winding) override;
+    virtual void setVertexBuffer(Buffer* buffer) override;
+    virtual void setProgramState(ProgramState* programState) override;
+    virtual void setIndexBuffer(Buffer* buffer) override;
+    virtual void setInstanceBuffer(Buffer* buffer) override;
+    virtual void drawArrays(PrimitiveType primitiveType,
+                            std::size_t start,
+                            std::size_t count,
+                            bool wireframe = false) override;
+    virtual void drawElements(PrimitiveType primitiveType,
+                              IndexFormat indexType,
+                              std::size_t count,
+                              std::size_t offset,
+                              bool wireframe = false) override;
+    virtual void drawElementsInstanced(PrimitiveType primitiveType,
+                                       IndexFormat indexType,
+                                       std::size_t count,
+                                       std::size_t offset,
+                                       int instanceCount,
+                                       bool wireframe = false) override;
+    virtual void endRenderPass() override;
+    virtual void endFrame() override;
+    virtual void setScissorRect(bool isEnabled, float x, float y, float width, float height) override;
+    virtual void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) override;
+
+private:
+    void prepareDrawing();
+    void draw(std::size_t vertexCount);
+    bool setBuffer(Buffer*& current, Buffer* buffer);
+
+    static constexpr int MAX_TEXTURE_UNITS = 16;
+
+    NullDriverStats& _stats;
+
+    RenderPipelineNull* _renderPipeline          = nullptr;
+    DepthStencilState* _depthStencilState        = nullptr;
+    ProgramState* _programState                  = nullptr;
+    Buffer* _vertexBuffer                        = nullptr;
+    Buffer* _indexBuffer                         = nullptr;
+    Buffer* _instanceBuffer                      = nullptr;
+    TextureBackend* _textures[MAX_TEXTURE_UNITS] = {};
+
+    // last applied uniform data, like the GL backend only changed uniforms are counted
+    const void* _appliedOwner      = nullptr;
+    const Program* _appliedProgram = nullptr;
+    uint64_t _appliedRevision      = 0;
+
+    int _viewport[4]     = {};
+    float _scissor[4]    = {};
+    bool _scissorEnabled = false;
+    CullMode _cullMode   = CullMode::NONE;
+    Winding _winding     = Winding::COUNTER_CLOCK_WISE;
+};
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
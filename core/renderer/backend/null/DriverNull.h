@@ -0,0 +1,106 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "../DriverBase.h"
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * The work the null driver was asked to do, e.g. to compare the CPU side rendering cost of two builds.
+ */
+struct NullDriverStats
+{
+    uint64_t frames        = 0;  ///< endFrame calls.
+    uint64_t renderPasses  = 0;  ///< beginRenderPass calls.
+    uint64_t drawCalls     = 0;  ///< drawArrays, drawElements and drawElementsInstanced calls.
+    uint64_t vertices      = 0;  ///< vertices and indices submitted by the draw calls, times the instance count.
+    uint64_t stateChanges  = 0;  ///< pipeline, depth stencil, viewport, cull, winding, scissor and buffer changes.
+    uint64_t textureBinds  = 0;  ///< texture bindings which differ from the one already bound to the slot.
+    uint64_t bufferBytes   = 0;  ///< bytes uploaded to vertex, index and instance buffers.
+    uint64_t textureBytes  = 0;  ///< bytes uploaded to textures.
+    uint64_t uniformBytes  = 0;  ///< uniform bytes which changed since the program state was applied last.
+    uint64_t buffers       = 0;  ///< buffers created.
+    uint64_t textures      = 0;  ///< textures created.
+    uint64_t programs      = 0;  ///< programs created.
+};
+
+/**
+ * A driver without GPU, accepts all resources and commands and only counts them.
+ * Install it before anything uses the driver to run the engine headless, i.e. benchmarks and CI:
+ * @code
+ * backend::DriverBase::setInstance(new backend::DriverNull());
+ * director->setGLView(GLViewNull::create("bench", Rect(0, 0, 1280, 720)));
+ * @endcode
+ * The programs reflect their uniforms and attributes from the GLSL sources, so program states hold
+ * the same uniform data as with the GL backend.
+ */
+class AX_DLL DriverNull : public DriverBase
+{
+public:
+    DriverNull();
+
+    CommandBuffer* newCommandBuffer() override;
+    Buffer* newBuffer(size_t size, BufferType type, BufferUsage usage) override;
+    TextureBackend* newTexture(const TextureDescriptor& descriptor) override;
+    RenderTarget* newDefaultRenderTarget(TargetBufferFlags rtf) override;
+    RenderTarget* newRenderTarget(TargetBufferFlags rtf,
+                                  TextureBackend* colorAttachment,
+                                  TextureBackend* depthAttachment,
+                                  TextureBackend* stencilAttachhment) override;
+    DepthStencilState* newDepthStencilState() override;
+    RenderPipeline* newRenderPipeline() override;
+    void setFrameBufferOnly(bool /*frameBufferOnly*/) override {}
+    Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
+
+    const char* getVendor() const override { return "axmol"; }
+    const char* getRenderer() const override { return "null"; }
+    const char* getVersion() const override { return "1.0"; }
+
+    bool checkForFeatureSupported(FeatureType feature) override;
+
+    /**
+     * Get the counters accumulated since the last resetStats call.
+     */
+    const NullDriverStats& getStats() const { return _stats; }
+
+    /**
+     * Reset all counters.
+     */
+    void resetStats() { _stats = NullDriverStats{}; }
+
+protected:
+    ShaderModule* newShaderModule(ShaderStage stage, std::string_view source) override;
+
+    NullDriverStats _stats;
+};
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
@@ -0,0 +1,431 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "ProgramNull.h"
+#include "base/Macros.h"
+
+#include <ctype.h>
+#include <algorithm>
+#include <vector>
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+struct TypeInfo
+{
+    unsigned int size      = 0;  // element size, as reported by GL
+    unsigned int align     = 0;  // std140 base alignment
+    unsigned int footprint = 0;  // std140 size of one element
+    bool sampler           = false;
+};
+
+bool getTypeInfo(std::string_view type, TypeInfo& info)
+{
+    if (type.find("sampler") != std::string_view::npos)
+    {
+        info         = TypeInfo{};
+        info.sampler = true;
+        return true;
+    }
+
+    // ivec3, uvec3 and bvec3 have the same layout as vec3
+    if (type.size() > 3 && (type[0] == 'i' || type[0] == 'u' || type[0] == 'b') && type.substr(1, 3) == "vec")
+        type.remove_prefix(1);
+
+    if (type == "float" || type == "int" || type == "uint" || type == "bool")
+        info = TypeInfo{4, 4, 4, false};
+    else if (type == "vec2")
+        info = TypeInfo{8, 8, 8, false};
+    else if (type == "vec3")
+        info = TypeInfo{12, 16, 12, false};
+    else if (type == "vec4")
+        info = TypeInfo{16, 16, 16, false};
+    else if (type == "mat2")
+        info = TypeInfo{16, 16, 32, false};
+    else if (type == "mat3")
+        info = TypeInfo{36, 16, 48, false};
+    else if (type == "mat4")
+        info = TypeInfo{64, 16, 64, false};
+    else
+        return false;
+    return true;
+}
+
+bool isIdentifierChar(char c)
+{
+    return isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// split GLSL into identifiers and single punctuation characters, without comments and preprocessor lines
+void tokenize(std::string_view source, std::vector<std::string_view>& tokens)
+{
+    bool lineStart = true;
+    size_t i = 0, n = source.size();
+    while (i < n)
+    {
+        const char c = source[i];
+        if (c == '\n')
+        {
+            lineStart = true;
+            ++i;
+        }
+        else if (isspace(static_cast<unsigned char>(c)))
+            ++i;
+        else if (c == '#' && lineStart)
+        {
+            while (i < n && source[i] != '\n')
+                ++i;
+        }
+        else if (c == '/' && i + 1 < n && source[i + 1] == '/')
+        {
+            while (i < n && source[i] != '\n')
+                ++i;
+        }
+        else if (c == '/' && i + 1 < n && source[i + 1] == '*')
+        {
+            auto end = source.find("*/", i + 2);
+            i        = end == std::string_view::npos ? n : end + 2;
+        }
+        else
+        {
+            lineStart  = false;
+            size_t end = i + 1;
+            if (isIdentifierChar(c))
+            {
+                while (end < n && isIdentifierChar(source[end]))
+                    ++end;
+            }
+            tokens.emplace_back(source.substr(i, end - i));
+            i = end;
+        }
+    }
+}
+
+bool isQualifier(std::string_view token)
+{
+    return token == "highp" || token == "mediump" || token == "lowp" || token == "flat" || token == "smooth" ||
+           token == "noperspective" || token == "centroid" || token == "const" || token == "invariant";
+}
+
+struct Declaration
+{
+    std::string_view type;
+    std::string_view name;
+    int count;
+};
+
+// parse 'type name[N], name2;' from tokens[i], i ends after the ';'
+void parseDeclarations(const std::vector<std::string_view>& tokens, size_t& i, std::vector<Declaration>& out)
+{
+    const auto n = tokens.size();
+    while (i < n && (isQualifier(tokens[i]) || tokens[i] == "layout"))
+    {
+        if (tokens[i] == "layout")
+        {
+            while (i < n && tokens[i] != ")")
+                ++i;
+        }
+        ++i;
+    }
+    if (i >= n)
+        return;
+
+    const auto type = tokens[i++];
+    while (i < n && tokens[i] != ";")
+    {
+        if (tokens[i] == ")" || tokens[i] == "{" || tokens[i] == "}")
+            return;
+        if (tokens[i] == ",")
+        {
+            ++i;
+            continue;
+        }
+        Declaration declaration{type, tokens[i++], 1};
+        if (i + 2 < n && tokens[i] == "[")
+        {
+            declaration.count = (std::max)(atoi(std::string{tokens[i + 1]}.c_str()), 1);
+            while (i < n && tokens[i] != "]")
+                ++i;
+            ++i;
+        }
+        out.emplace_back(declaration);
+    }
+    ++i;
+}
+
+size_t alignTo(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+ProgramNull::ProgramNull(std::string_view vertexShader, std::string_view fragmentShader)
+    : Program(vertexShader, fragmentShader)
+{
+    reflect(_vertexShader, ShaderStage::VERTEX);
+    reflect(_fragmentShader, ShaderStage::FRAGMENT);
+    setBuiltinLocations();
+}
+
+void ProgramNull::reflect(std::string_view source, ShaderStage stage)
+{
+    std::vector<std::string_view> tokens;
+    tokenize(source, tokens);
+
+    std::unordered_map<std::string_view, std::vector<Declaration>> structs;
+    std::vector<Declaration> declarations;
+
+    // declarations are only looked for at the start of a statement, 'in' also qualifies function parameters
+    bool statementStart = true;
+    int layoutLocation  = -1;
+    const auto n        = tokens.size();
+    for (size_t i = 0; i < n;)
+    {
+        const auto token = tokens[i];
+        if (!statementStart && token != ";" && token != "{")
+        {
+            ++i;
+            continue;
+        }
+
+        if (isQualifier(token))
+            ++i;
+        else if (token == "layout")
+        {
+            for (; i < n && tokens[i] != ")"; ++i)
+            {
+                if (tokens[i] == "location" && i + 2 < n && tokens[i + 1] == "=")
+                    layoutLocation = atoi(std::string{tokens[i + 2]}.c_str());
+            }
+            ++i;
+        }
+        else if (token == "struct" && i + 2 < n && tokens[i + 2] == "{")
+        {
+            auto& members = structs[tokens[i + 1]];
+            for (i += 3; i < n && tokens[i] != "}";)
+            {
+                const auto start = i;
+                parseDeclarations(tokens, i, members);
+                i += (i == start);
+            }
+            // the declarators after the struct body are ignored
+            while (i < n && tokens[i] != ";")
+                ++i;
+            ++i;
+        }
+        else if (token == "uniform")
+        {
+            ++i;
+            while (i < n && isQualifier(tokens[i]))
+                ++i;
+
+            if (i + 1 < n && tokens[i + 1] == "{")
+            {
+                // uniform block, std140
+                _blockOffset = alignTo(_totalBufferSize, 16);
+                for (i += 2; i < n && tokens[i] != "}";)
+                {
+                    const auto start = i;
+                    declarations.clear();
+                    parseDeclarations(tokens, i, declarations);
+                    i += (i == start);
+                    for (auto&& declaration : declarations)
+                        addUniform(declaration.name, declaration.type, declaration.count, true);
+                }
+                _totalBufferSize = alignTo(_blockOffset, 16);
+                while (i < n && tokens[i] != ";")
+                    ++i;
+                ++i;
+            }
+            else
+            {
+                declarations.clear();
+                parseDeclarations(tokens, i, declarations);
+                for (auto&& declaration : declarations)
+                {
+                    auto it = structs.find(declaration.type);
+                    if (it == structs.end())
+                        addUniform(declaration.name, declaration.type, declaration.count, false);
+                    else
+                    {
+                        for (auto&& member : it->second)
+                            addUniform(member.name, member.type, member.count, false);
+                    }
+                }
+            }
+            layoutLocation = -1;
+        }
+        else if (stage == ShaderStage::VERTEX && (token == "in" || token == "attribute"))
+        {
+            ++i;
+            declarations.clear();
+            parseDeclarations(tokens, i, declarations);
+            for (auto&& declaration : declarations)
+            {
+                TypeInfo typeInfo;
+                getTypeInfo(declaration.type, typeInfo);
+
+                AttributeBindInfo info;
+                info.location = layoutLocation;
+                if (info.location < 0)
+                {
+                    info.location = 0;
+                    for (auto&& attrib : _activeAttribs)
+                        info.location = (std::max)(info.location, attrib.second.location + 1);
+                }
+                info.size                        = static_cast<int>(typeInfo.size) * declaration.count;
+                _activeAttribs[declaration.name] = info;
+            }
+            layoutLocation = -1;
+        }
+        else if (token == "{")
+        {
+            // function body
+            int depth = 0;
+            for (; i < n; ++i)
+            {
+                if (tokens[i] == "{")
+                    ++depth;
+                else if (tokens[i] == "}" && --depth == 0)
+                    break;
+            }
+            ++i;
+            statementStart = true;
+            layoutLocation = -1;
+        }
+        else
+        {
+            statementStart = token == ";";
+            if (statementStart)
+                layoutLocation = -1;
+            ++i;
+        }
+    }
+}
+
+void ProgramNull::addUniform(std::string_view name, std::string_view type, int count, bool inBlock)
+{
+    TypeInfo typeInfo;
+    if (!getTypeInfo(type, typeInfo))
+    {
+        AXLOG("axmol: ProgramNull: unknown type '%.*s' of uniform '%.*s'", static_cast<int>(type.size()), type.data(),
+              static_cast<int>(name.size()), name.data());
+        return;
+    }
+
+    UniformInfo uniform;
+    uniform.count = count;
+    uniform.size  = typeInfo.size;
+    if (typeInfo.sampler)
+    {
+        uniform.location     = _samplerCount++;
+        uniform.bufferOffset = -1;
+        _maxLocation         = (std::max)(_maxLocation, uniform.location + 1);
+    }
+    else if (inBlock)
+    {
+        // the location of the uniforms is 0, their offset is the one in the whole uniform buffer
+        const auto align     = count > 1 ? 16u : typeInfo.align;
+        const auto footprint = count > 1 ? alignTo(typeInfo.footprint, 16) * count : typeInfo.footprint;
+        _blockOffset         = alignTo(_blockOffset, align);
+        uniform.location     = 0;
+        uniform.bufferOffset = static_cast<unsigned int>(_blockOffset);
+        _blockOffset += footprint;
+    }
+    else
+    {
+        // like GLSL100 uniforms with the GL backend
+        uniform.location     = 0;
+        uniform.bufferOffset = static_cast<unsigned int>(_totalBufferSize);
+        _totalBufferSize += typeInfo.size * count;
+    }
+
+    // a uniform declared by both stages is one uniform
+    if (_activeUniformInfos.find(name) != _activeUniformInfos.end())
+        return;
+    _activeUniformInfos[name] = uniform;
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    _uniformLocations[std::string{name}] = uniform.location;
+#endif
+}
+
+void ProgramNull::setBuiltinLocations()
+{
+    _builtinAttributeLocation[Attribute::POSITION]  = getAttributeLocation(ATTRIBUTE_NAME_POSITION);
+    _builtinAttributeLocation[Attribute::COLOR]     = getAttributeLocation(ATTRIBUTE_NAME_COLOR);
+    _builtinAttributeLocation[Attribute::TEXCOORD]  = getAttributeLocation(ATTRIBUTE_NAME_TEXCOORD);
+    _builtinAttributeLocation[Attribute::TEXCOORD1] = getAttributeLocation(ATTRIBUTE_NAME_TEXCOORD1);
+    _builtinAttributeLocation[Attribute::TEXCOORD2] = getAttributeLocation(ATTRIBUTE_NAME_TEXCOORD2);
+    _builtinAttributeLocation[Attribute::TEXCOORD3] = getAttributeLocation(ATTRIBUTE_NAME_TEXCOORD3);
+    _builtinAttributeLocation[Attribute::NORMAL]    = getAttributeLocation(ATTRIBUTE_NAME_NORMAL);
+    _builtinAttributeLocation[Attribute::INSTANCE]  = getAttributeLocation(ATTRIBUTE_NAME_INSTANCE);
+
+    _builtinUniformLocation[Uniform::MVP_MATRIX]   = getUniformLocation(UNIFORM_NAME_MVP_MATRIX);
+    _builtinUniformLocation[Uniform::TEXTURE]      = getUniformLocation(UNIFORM_NAME_TEXTURE);
+    _builtinUniformLocation[Uniform::TEXTURE1]     = getUniformLocation(UNIFORM_NAME_TEXTURE1);
+    _builtinUniformLocation[Uniform::TEXTURE2]     = getUniformLocation(UNIFORM_NAME_TEXTURE2);
+    _builtinUniformLocation[Uniform::TEXTURE3]     = getUniformLocation(UNIFORM_NAME_TEXTURE3);
+    _builtinUniformLocation[Uniform::TEXT_COLOR]   = getUniformLocation(UNIFORM_NAME_TEXT_COLOR);
+    _builtinUniformLocation[Uniform::EFFECT_COLOR] = getUniformLocation(UNIFORM_NAME_EFFECT_COLOR);
+    _builtinUniformLocation[Uniform::EFFECT_TYPE]  = getUniformLocation(UNIFORM_NAME_EFFECT_TYPE);
+}
+
+UniformLocation ProgramNull::getUniformLocation(std::string_view uniform) const
+{
+    UniformLocation uniformLocation;
+    auto iter = _activeUniformInfos.find(uniform);
+    if (iter != _activeUniformInfos.end())
+    {
+        uniformLocation.shaderStage = ShaderStage::VERTEX;
+        uniformLocation.location[0] = iter->second.location;
+        uniformLocation.location[1] = iter->second.bufferOffset;
+    }
+    return uniformLocation;
+}
+
+UniformLocation ProgramNull::getUniformLocation(backend::Uniform name) const
+{
+    return _builtinUniformLocation[name];
+}
+
+int ProgramNull::getAttributeLocation(std::string_view name) const
+{
+    auto iter = _activeAttribs.find(name);
+    return iter != _activeAttribs.end() ? iter->second.location : -1;
+}
+
+int ProgramNull::getAttributeLocation(Attribute name) const
+{
+    return _builtinAttributeLocation[name];
+}
+
+std::size_t ProgramNull::getUniformBufferSize(ShaderStage stage) const
+{
+    // a single buffer for both stages, like the GL backend
+    return stage == ShaderStage::FRAGMENT ? 0 : _totalBufferSize;
+}
+
+NS_AX_BACKEND_END
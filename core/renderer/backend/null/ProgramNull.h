@@ -0,0 +1,94 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "../Program.h"
+
+#include <string>
+#include <unordered_map>
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * A program which is never compiled.
+ * The uniforms and attributes are reflected from the GLSL declarations of the sources, uniform blocks
+ * use the std140 layout, so program states allocate and update the same uniform data as with a GPU.
+ */
+class ProgramNull : public Program
+{
+public:
+    ProgramNull(std::string_view vertexShader, std::string_view fragmentShader);
+
+    virtual UniformLocation getUniformLocation(std::string_view uniform) const override;
+    virtual UniformLocation getUniformLocation(backend::Uniform name) const override;
+    virtual int getAttributeLocation(std::string_view name) const override;
+    virtual int getAttributeLocation(Attribute name) const override;
+    virtual int getMaxVertexLocation() const override { return _maxLocation; }
+    virtual int getMaxFragmentLocation() const override { return _maxLocation; }
+    virtual const hlookup::string_map<AttributeBindInfo>& getActiveAttributes() const override
+    {
+        return _activeAttribs;
+    }
+    virtual std::size_t getUniformBufferSize(ShaderStage stage) const override;
+    virtual const hlookup::string_map<UniformInfo>& getAllActiveUniformInfo(ShaderStage stage) const override
+    {
+        return _activeUniformInfos;
+    }
+
+private:
+    void reflect(std::string_view source, ShaderStage stage);
+    void addUniform(std::string_view name, std::string_view type, int count, bool inBlock);
+    void setBuiltinLocations();
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    virtual int getMappedLocation(int location) const override { return location; }
+    virtual int getOriginalLocation(int location) const override { return location; }
+    virtual const std::unordered_map<std::string, int> getAllUniformsLocation() const override
+    {
+        return _uniformLocations;
+    }
+
+    std::unordered_map<std::string, int> _uniformLocations;
+#endif
+
+    hlookup::string_map<UniformInfo> _activeUniformInfos;
+    hlookup::string_map<AttributeBindInfo> _activeAttribs;
+
+    std::size_t _totalBufferSize = 0;  // total uniform buffer size, blocks and plain uniforms
+    std::size_t _blockOffset     = 0;  // std140 offset in the block being reflected
+    int _samplerCount            = 0;
+    int _maxLocation             = -1;
+
+    UniformLocation _builtinUniformLocation[UNIFORM_MAX];
+    int _builtinAttributeLocation[Attribute::ATTRIBUTE_MAX];
+};
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
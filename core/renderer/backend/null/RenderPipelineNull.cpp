@@ -0,0 +1,63 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "RenderPipelineNull.h"
+#include "DriverNull.h"
+#include "../Program.h"
+#include "../ProgramState.h"
+
+NS_AX_BACKEND_BEGIN
+
+RenderPipelineNull::~RenderPipelineNull()
+{
+    AX_SAFE_RELEASE(_program);
+}
+
+void RenderPipelineNull::update(const RenderTarget*, const PipelineDescriptor& pipelineDescirptor)
+{
+    auto program = pipelineDescirptor.programState->getProgram();
+    if (_program != program)
+    {
+        AX_SAFE_RETAIN(program);
+        AX_SAFE_RELEASE(_program);
+        _program = program;
+        ++_stats.stateChanges;
+    }
+
+    const auto& blend = pipelineDescirptor.blendDescriptor;
+    if (blend.writeMask != _blendDescriptor.writeMask || blend.blendEnabled != _blendDescriptor.blendEnabled ||
+        blend.rgbBlendOperation != _blendDescriptor.rgbBlendOperation ||
+        blend.alphaBlendOperation != _blendDescriptor.alphaBlendOperation ||
+        blend.sourceRGBBlendFactor != _blendDescriptor.sourceRGBBlendFactor ||
+        blend.destinationRGBBlendFactor != _blendDescriptor.destinationRGBBlendFactor ||
+        blend.sourceAlphaBlendFactor != _blendDescriptor.sourceAlphaBlendFactor ||
+        blend.destinationAlphaBlendFactor != _blendDescriptor.destinationAlphaBlendFactor)
+    {
+        _blendDescriptor = blend;
+        ++_stats.stateChanges;
+    }
+}
+
+NS_AX_BACKEND_END
@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "../RenderPipeline.h"
+#include "../DepthStencilState.h"
+#include "../ShaderModule.h"
+
+NS_AX_BACKEND_BEGIN
+
+struct NullDriverStats;
+
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * Keeps the program and blend state, counts their changes.
+ */
+class RenderPipelineNull : public RenderPipeline
+{
+public:
+    explicit RenderPipelineNull(NullDriverStats& stats) : _stats(stats) {}
+    ~RenderPipelineNull();
+
+    virtual void update(const RenderTarget*, const PipelineDescriptor& pipelineDescirptor) override;
+
+    Program* getProgram() const { return _program; }
+
+private:
+    NullDriverStats& _stats;
+    Program* _program = nullptr;
+    BlendDescriptor _blendDescriptor;
+};
+
+class DepthStencilStateNull : public DepthStencilState
+{
+public:
+    DepthStencilStateNull() = default;
+};
+
+class ShaderModuleNull : public ShaderModule
+{
+public:
+    explicit ShaderModuleNull(ShaderStage stage) : ShaderModule(stage) {}
+};
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
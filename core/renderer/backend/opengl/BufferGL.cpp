@@ -23,6 +23,7 @@
  ****************************************************************************/
 
 #include "BufferGL.h"
+#include <algorithm>
 #include <cassert>
 #include "base/Director.h"
 #include "base/EventType.h"
@@ -30,6 +31,13 @@
 #include "renderer/backend/opengl/MacrosGL.h"
 #include "OpenGLState.h"
 
+// persistent mapping is only reachable through the glad loader, it needs GL4.4 or a buffer storage extension
+#if defined(glBufferStorage) && defined(glBufferStorageEXT) && AX_GLES_PROFILE != 200
+#    define AX_GL_HAVE_BUFFER_STORAGE 1
+#else
+#    define AX_GL_HAVE_BUFFER_STORAGE 0
+#endif
+
 NS_AX_BACKEND_BEGIN
 
 namespace
@@ -61,6 +69,7 @@ BufferGL::BufferGL(std::size_t size, BufferType type, BufferUsage usage) : Buffe
 
 BufferGL::~BufferGL()
 {
+    resetStream(true);
     if (_buffer)
         __gl->deleteBuffer(_type, _buffer);
 #if AX_ENABLE_CACHE_TEXTURE_DATA
@@ -79,6 +88,8 @@ void BufferGL::usingDefaultStoredData(bool needDefaultStoredData)
 #if AX_ENABLE_CACHE_TEXTURE_DATA
 void BufferGL::reloadBuffer()
 {
+    // the mapping and fences died with the old context
+    resetStream(false);
     glGenBuffers(1, &_buffer);
 
     if (!_needDefaultStoredData)
@@ -106,6 +117,13 @@ void BufferGL::updateData(const void* data, std::size_t size)
 {
     assert(size && size <= _size);
 
+    if (_mappedData)
+    {
+        // the storage of a persistently mapped buffer is immutable
+        memcpy(_mappedData, data, size);
+        return;
+    }
+
     if (_buffer)
     {
         glBufferData(__gl->bindBuffer(_type, _buffer), size, data, toGLUsage(_usage));
@@ -125,6 +143,12 @@ void BufferGL::updateSubData(const void* data, std::size_t offset, std::size_t s
     AXASSERT(_bufferAllocated != 0, "updateData should be invoke before updateSubData");
     AXASSERT(offset + size <= _bufferAllocated, "buffer size overflow");
 
+    if (_mappedData)
+    {
+        memcpy(_mappedData + offset, data, size);
+        return;
+    }
+
     if (_buffer)
     {
         CHECK_GL_ERROR_DEBUG();
@@ -138,4 +162,163 @@ void BufferGL::updateSubData(const void* data, std::size_t offset, std::size_t s
     }
 }
 
+std::size_t BufferGL::streamData(const void* data, std::size_t size, std::size_t alignment)
+{
+    AXASSERT(size && size <= _size, "buffer size overflow");
+
+    if (!_buffer)
+        return 0;
+
+    if (_streamMode == StreamMode::NONE)
+        initStream();
+
+    bool wrapped = false;
+    auto offset  = allocateStreamRange(size, alignment, wrapped);
+
+    switch (_streamMode)
+    {
+    case StreamMode::PERSISTENT:
+    {
+        const auto segmentSize = _size / STREAM_SEGMENT_COUNT + 1;
+        const int first        = static_cast<int>(offset / segmentSize);
+        const int last         = static_cast<int>((offset + size - 1) / segmentSize);
+        if (wrapped || first != _streamSegmentLast)
+        {
+            // the segments written so far are done, the draws issued until now are the last ones reading them
+            fenceStreamSegments(_streamSegmentFirst, _streamSegmentLast);
+            _streamSegmentFirst = first;
+            waitStreamSegment(first);
+        }
+        for (int segment = first + 1; segment <= last; ++segment)
+            waitStreamSegment(segment);
+        _streamSegmentLast = last;
+
+        memcpy(_mappedData + offset, data, size);
+        break;
+    }
+#if AX_GLES_PROFILE != 200
+    case StreamMode::MAP_RANGE:
+    {
+        if (wrapped)
+            orphanStream();
+        auto target = __gl->bindBuffer(_type, _buffer);
+        auto ptr    = glMapBufferRange(target, offset, size,
+                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (ptr)
+        {
+            memcpy(ptr, data, size);
+            glUnmapBuffer(target);
+        }
+        else
+            glBufferSubData(target, offset, size, data);
+        break;
+    }
+#endif
+    default:
+        if (wrapped)
+            orphanStream();
+        glBufferSubData(__gl->bindBuffer(_type, _buffer), offset, size, data);
+        break;
+    }
+    CHECK_GL_ERROR_DEBUG();
+
+    return offset;
+}
+
+void BufferGL::initStream()
+{
+    auto target = __gl->bindBuffer(_type, _buffer);
+#if AX_GL_HAVE_BUFFER_STORAGE
+    auto bufferStorage = glBufferStorage ? glBufferStorage : glBufferStorageEXT;
+    if (bufferStorage)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        bufferStorage(target, _size, nullptr, flags);
+        _mappedData = static_cast<uint8_t*>(glMapBufferRange(target, 0, _size, flags));
+        if (_mappedData)
+        {
+            _streamMode      = StreamMode::PERSISTENT;
+            _bufferAllocated = _size;
+            return;
+        }
+
+        // the storage is immutable now, start over with a new buffer object
+        __gl->deleteBuffer(_type, _buffer);
+        glGenBuffers(1, &_buffer);
+        target = __gl->bindBuffer(_type, _buffer);
+    }
+#endif
+
+#if AX_GLES_PROFILE != 200
+    _streamMode = StreamMode::MAP_RANGE;
+#else
+    _streamMode = StreamMode::ORPHAN;
+#endif
+    glBufferData(target, _size, nullptr, GL_STREAM_DRAW);
+    _bufferAllocated = _size;
+    _streamOffset    = 0;
+}
+
+void BufferGL::resetStream(bool deleteFences)
+{
+#if AX_GLES_PROFILE != 200
+    if (deleteFences)
+    {
+        for (auto fence : _streamFences)
+        {
+            if (fence)
+            {
+                std::replace(std::begin(_streamFences), std::end(_streamFences), fence, static_cast<GLsync>(nullptr));
+                glDeleteSync(fence);
+            }
+        }
+        if (_mappedData && _buffer)
+            glUnmapBuffer(__gl->bindBuffer(_type, _buffer));
+    }
+#endif
+    std::fill(std::begin(_streamFences), std::end(_streamFences), nullptr);
+    _mappedData         = nullptr;
+    _streamMode         = StreamMode::NONE;
+    _streamOffset       = 0;
+    _streamSegmentFirst = _streamSegmentLast = 0;
+}
+
+void BufferGL::orphanStream()
+{
+    // give the old storage to the driver, the draws in flight keep using it
+    glBufferData(__gl->bindBuffer(_type, _buffer), _size, nullptr, GL_STREAM_DRAW);
+}
+
+void BufferGL::fenceStreamSegments(int first, int last)
+{
+#if AX_GLES_PROFILE != 200
+    auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    for (int segment = first; segment <= last; ++segment)
+    {
+        // the older fence of a segment is covered by the new one
+        auto old               = _streamFences[segment];
+        _streamFences[segment] = fence;
+        if (old && std::find(std::begin(_streamFences), std::end(_streamFences), old) == std::end(_streamFences))
+            glDeleteSync(old);
+    }
+#endif
+}
+
+void BufferGL::waitStreamSegment(int segment)
+{
+#if AX_GLES_PROFILE != 200
+    auto fence = _streamFences[segment];
+    if (!fence)
+        return;
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);  // 1ms
+
+    // segments fenced together share the fence
+    std::replace(std::begin(_streamFences), std::end(_streamFences), fence, static_cast<GLsync>(nullptr));
+    glDeleteSync(fence);
+#endif
+}
+
 NS_AX_BACKEND_END
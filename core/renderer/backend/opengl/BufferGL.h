@@ -70,6 +70,15 @@ public:
      */
     virtual void updateSubData(const void* data, std::size_t offset, std::size_t size) override;
 
+    /**
+     * @brief Stream data into the next free sub-range of the buffer
+     * Uses a persistently mapped buffer when GL_ARB_buffer_storage/GL_EXT_buffer_storage is available, with fences
+     * guarding the parts of the ring which are reused. Otherwise the ranges are written with unsynchronized
+     * glMapBufferRange, or glBufferSubData on GLES2, and the buffer is orphaned each time the ring wraps around.
+     * @see `Buffer::streamData(const void* data, std::size_t size, std::size_t alignment)`
+     */
+    virtual std::size_t streamData(const void* data, std::size_t size, std::size_t alignment = 4) override;
+
     /**
      * Static buffer data will automatically stored when it comes to foreground.
      * This interface is used to indicate whether external data needs to be used to update the buffer(false) instead of
@@ -85,6 +94,20 @@ public:
     inline GLuint getHandler() const { return _buffer; }
 
 private:
+    enum class StreamMode
+    {
+        NONE,
+        PERSISTENT,
+        MAP_RANGE,
+        ORPHAN,
+    };
+
+    void initStream();
+    void resetStream(bool deleteFences);
+    void orphanStream();
+    void fenceStreamSegments(int first, int last);
+    void waitStreamSegment(int segment);
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     void reloadBuffer();
     void fillBuffer(const void* data, std::size_t offset, std::size_t size);
@@ -96,6 +119,15 @@ private:
     std::size_t _bufferAllocated = 0;
     char* _data                  = nullptr;
     bool _needDefaultStoredData  = true;
+
+    // the stream ring is split into segments, each one guarded by the fence of the draws which read it last
+    static constexpr int STREAM_SEGMENT_COUNT = 4;
+
+    StreamMode _streamMode                     = StreamMode::NONE;
+    uint8_t* _mappedData                       = nullptr;
+    GLsync _streamFences[STREAM_SEGMENT_COUNT] = {};
+    int _streamSegmentFirst                    = 0;
+    int _streamSegmentLast                     = 0;
 };
 // end of _opengl group
 ///> @}
@@ -303,11 +303,16 @@ void CommandBufferGL::prepareDrawing() const
     const auto& program = _renderPipeline->getProgram();
     __gl->useProgram(program->getHandler());
 
-    uint32_t usedBits{0};
+    if (_useVertexArrayCache)
+        bindVertexArray(program);
+    else
+    {
+        uint32_t usedBits{0};
 
-    bindVertexBuffer(usedBits);
-    bindInstanceBuffer(program, usedBits);
-    __gl->disableUnusedVertexAttribs(usedBits);
+        bindVertexBuffer(usedBits);
+        bindInstanceBuffer(program, usedBits);
+        __gl->disableUnusedVertexAttribs(usedBits);
+    }
 
     bindUniforms(program);
 
@@ -324,6 +329,59 @@ void CommandBufferGL::prepareDrawing() const
         __gl->disableCullFace();
 }
 
+void CommandBufferGL::bindVertexArray(ProgramGL* program) const
+{
+    auto vertexLayout = _programState->getVertexLayout();
+
+    VertexArrayKey key;
+    key.layoutHash   = vertexLayout->getHash();
+    key.vertexBuffer = _vertexBuffer->getHandler();
+    if (_instanceTransformBuffer)
+    {
+        key.instanceLocation = program->getAttributeLocation(Attribute::INSTANCE);
+        if (key.instanceLocation != -1)
+            key.instanceBuffer = _instanceTransformBuffer->getHandler();
+    }
+    if (_indexBuffer)
+        key.indexBuffer = _indexBuffer->getHandler();
+
+    if (!__gl->bindVertexArray(key))
+        return;
+
+    // First use of this layout and buffers combination, record the attributes into the new VAO.
+    // A new VAO starts with every attribute disabled and all divisors 0, so the tracked bits of
+    // the default VAO in __gl are not involved here.
+    if (vertexLayout->isValid())
+    {
+        __gl->bindBuffer(BufferType::ARRAY_BUFFER, key.vertexBuffer);
+        for (const auto& attributeInfo : vertexLayout->getAttributes())
+        {
+            const auto& attribute = attributeInfo.second;
+            glEnableVertexAttribArray(attribute.index);
+            glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
+                                  UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
+                                  vertexLayout->getStride(), (GLvoid*)attribute.offset);
+        }
+    }
+
+    if (key.instanceBuffer)
+    {
+        __gl->bindBuffer(BufferType::ARRAY_BUFFER, key.instanceBuffer);
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto elementLoc = key.instanceLocation + i;
+            glEnableVertexAttribArray(elementLoc);
+            glVertexAttribPointer(elementLoc, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16,
+                                  (void*)(sizeof(float) * 4 * i));
+            glVertexAttribDivisor(elementLoc, 1);
+        }
+    }
+
+    if (key.indexBuffer)
+        __gl->bindBuffer(BufferType::ELEMENT_ARRAY_BUFFER, key.indexBuffer);
+    CHECK_GL_ERROR_DEBUG();
+}
+
 void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
 {
     // Bind vertex buffers and set the attributes.
@@ -333,8 +391,7 @@ void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
     if (!vertexLayout->isValid())
         return;
 
-    // Bind VAO, engine share 1 VAO for all vertexLayouts aka vfmts
-    // optimize proposal: create VAO per vertexLayout, just need bind VAO
+    // Fallback without VAOs: engine share 1 VAO for all vertexLayouts aka vfmts, see bindVertexArray
     __gl->bindBuffer(BufferType::ARRAY_BUFFER, _vertexBuffer->getHandler());
 
     for (const auto& attributeInfo : attributes)
@@ -385,9 +442,12 @@ void CommandBufferGL::bindUniforms(ProgramGL* program) const
 
         auto& uniformInfos = program->getAllActiveUniformInfo(ShaderStage::VERTEX);
 
-        std::size_t bufferSize = 0;
+        std::size_t bufferSize = 0, dirtyBegin = 0, dirtyEnd = 0;
         auto buffer            = _programState->getVertexUniformBuffer(bufferSize);
-        program->bindUniformBuffers(buffer, bufferSize);
+        _programState->getUniformDirtyRange(dirtyBegin, dirtyEnd);
+        __gl->addElidedCalls(program->bindUniformBuffers(buffer, bufferSize, _programState,
+                                                         _programState->getUniformRevision(), dirtyBegin, dirtyEnd));
+        _programState->markUniformsApplied();
 
         const auto& textureInfo = _programState->getVertexTextureInfos();
         for (const auto& iter : textureInfo)
@@ -414,7 +474,10 @@ void CommandBufferGL::bindUniforms(ProgramGL* program) const
 
             auto arrayCount = slots.size();
             if (arrayCount == 1)  // Most of the time， not use sampler2DArray, should be 1
-                glUniform1i(location, slots[0]);
+            {
+                if (!program->setSamplerSlot(location, slots[0]))
+                    __gl->addElidedCalls(1);
+            }
             else
                 glUniform1iv(location, static_cast<GLsizei>(arrayCount), static_cast<const GLint*>(slots.data()));
         }
@@ -426,6 +489,16 @@ void CommandBufferGL::cleanResources()
     AX_SAFE_RELEASE_NULL(_programState);
 }
 
+std::size_t CommandBufferGL::getElidedCalls() const
+{
+    return __gl->getElidedCalls();
+}
+
+void CommandBufferGL::resetElidedCalls()
+{
+    __gl->resetElidedCalls();
+}
+
 void CommandBufferGL::setScissorRect(bool isEnabled, float x, float y, float width, float height)
 {
     if (isEnabled)
@@ -204,6 +204,9 @@ public:
      */
     void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) override;
 
+    std::size_t getElidedCalls() const override;
+    void resetElidedCalls() override;
+
 protected:
     void readPixels(RenderTarget* rt,
                     int x,
@@ -216,6 +219,7 @@ protected:
 protected:
 
     void prepareDrawing() const;
+    void bindVertexArray(ProgramGL* program) const;
     void bindVertexBuffer(uint32_t& usedBits) const;
     virtual void bindInstanceBuffer(ProgramGL* program, uint32_t& usedBits) const;
     void bindUniforms(ProgramGL* program) const;
@@ -228,6 +232,10 @@ protected:
     RenderPipelineGL* _renderPipeline         = nullptr;
     CullMode _cullMode                        = CullMode::NONE;
     DepthStencilStateGL* _depthStencilStateGL = nullptr;
+
+    // Use one cached VAO per vertex layout and buffers instead of respecifying the attributes
+    // of the shared default VAO for every draw, disabled for GLES2 contexts.
+    bool _useVertexArrayCache = AX_GLES_PROFILE != 200;
     Viewport _viewPort;
     GLboolean _alphaTestEnabled               = false;
 
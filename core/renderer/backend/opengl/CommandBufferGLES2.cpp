@@ -8,6 +8,9 @@ NS_AX_BACKEND_BEGIN
 
 CommandBufferGLES2::CommandBufferGLES2()
 {
+    // GLES2 contexts may not expose VAOs, keep specifying the attributes per draw
+    _useVertexArrayCache = false;
+
     if (glDrawElementsInstancedEXT)
         glDrawElementsInstanced = glDrawElementsInstancedEXT;
     else if (glDrawElementsInstancedANGLE)
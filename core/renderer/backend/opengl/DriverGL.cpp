@@ -538,6 +538,10 @@ bool DriverGL::checkForFeatureSupported(FeatureType feature)
     case FeatureType::ASTC:
         featureSupported = checkASTCRenderability();
         break;
+    case FeatureType::INSTANCING:
+        featureSupported = !isGLES2Only() || hasExtension("GL_EXT_instanced_arrays"sv) ||
+                           hasExtension("GL_ANGLE_instanced_arrays"sv);
+        break;
     default:
         break;
     }
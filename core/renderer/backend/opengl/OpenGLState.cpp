@@ -1,4 +1,5 @@
 #include "OpenGLState.h"
+#include "xxhash.h"
 
 NS_AX_BACKEND_BEGIN
 
@@ -15,4 +16,81 @@ void OpenGLState::reset()
     __gl = g_defaultOpenGLState.get();
 }
 
+std::size_t VertexArrayKeyHash::operator()(const VertexArrayKey& key) const
+{
+    const uint32_t hashMe[] = {key.layoutHash, key.vertexBuffer, key.instanceBuffer,
+                               static_cast<uint32_t>(key.instanceLocation), key.indexBuffer};
+    return XXH32(hashMe, sizeof(hashMe), 0);
+}
+
+bool OpenGLState::bindVertexArray(const VertexArrayKey& key)
+{
+#if AX_GLES_PROFILE != 200
+    if (!_vertexArrayBind)
+    {
+        // remember the VAO set up by the driver, index buffer uploads go through it
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, reinterpret_cast<GLint*>(&_defaultVertexArray));
+        _vertexArrayBind = _defaultVertexArray;
+    }
+
+    bool created = false;
+    auto it      = _vertexArrays.find(key);
+    if (it == _vertexArrays.end())
+    {
+        GLuint vao = 0;
+        glGenVertexArrays(1, &vao);
+        it      = _vertexArrays.emplace(key, vao).first;
+        created = true;
+    }
+
+    if (_vertexArrayBind != it->second)
+    {
+        glBindVertexArray(it->second);
+        _vertexArrayBind        = it->second;
+        _cachedVertexArrayBound = true;
+        _cachedVertexArrayIndex = key.indexBuffer;
+
+        // the element array binding is part of the VAO state
+        _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)] = created ? 0 : key.indexBuffer;
+    }
+    return created;
+#else
+    AXASSERT(false, "VAOs are not available with the GLES2 profile");
+    return false;
+#endif
+}
+
+void OpenGLState::unbindVertexArray()
+{
+#if AX_GLES_PROFILE != 200
+    if (!_cachedVertexArrayBound)
+        return;
+
+    glBindVertexArray(_defaultVertexArray);
+    _vertexArrayBind        = _defaultVertexArray;
+    _cachedVertexArrayBound = false;
+    _cachedVertexArrayIndex = 0;
+    _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)].reset();
+#endif
+}
+
+void OpenGLState::deleteVertexArrays(GLuint buffer)
+{
+#if AX_GLES_PROFILE != 200
+    for (auto it = _vertexArrays.begin(); it != _vertexArrays.end();)
+    {
+        const auto& key = it->first;
+        if (key.vertexBuffer == buffer || key.instanceBuffer == buffer || key.indexBuffer == buffer)
+        {
+            if (_vertexArrayBind == it->second)
+                unbindVertexArray();
+            glDeleteVertexArrays(1, &it->second);
+            it = _vertexArrays.erase(it);
+        }
+        else
+            ++it;
+    }
+#endif
+}
+
 NS_AX_BACKEND_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <unordered_map>
 
 #include "base/Types.h"
 #include "platform/GL.h"
@@ -107,6 +108,31 @@ struct UniformBufferBaseBindState
     GLuint handle;
 };
 
+/**
+ * Everything a cached VAO captures: the attribute setup (via the vertex layout hash and the
+ * instance attribute location) and the buffers it points at.
+ */
+struct VertexArrayKey
+{
+    uint32_t layoutHash{0};
+    GLuint vertexBuffer{0};
+    GLuint instanceBuffer{0};
+    GLint instanceLocation{-1};
+    GLuint indexBuffer{0};
+
+    inline bool operator==(const VertexArrayKey& rhs) const
+    {
+        return this->layoutHash == rhs.layoutHash && this->vertexBuffer == rhs.vertexBuffer &&
+               this->instanceBuffer == rhs.instanceBuffer && this->instanceLocation == rhs.instanceLocation &&
+               this->indexBuffer == rhs.indexBuffer;
+    }
+};
+
+struct VertexArrayKeyHash
+{
+    std::size_t operator()(const VertexArrayKey& key) const;
+};
+
 struct OpenGLState
 {
     constexpr static GLenum BufferTargets[] = {
@@ -117,74 +143,75 @@ struct OpenGLState
     };
 
     constexpr static int MAX_VERTEX_ATTRIBS = 16;
+    constexpr static int MAX_TEXTURE_UNITS  = 16;
 
     template <typename _Left>
-    static inline void try_enable(GLenum target, _Left& opt)
+    inline void try_enable(GLenum target, _Left& opt)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt.has_value() && opt.value())
-            return;
+            return (void)++_elidedCalls;
         opt = true;
 #endif
         glEnable(target);
     }
     template <typename _Left>
-    static inline void try_disable(GLenum target, _Left& opt)
+    inline void try_disable(GLenum target, _Left& opt)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (!opt.has_value() || !opt.value())
-            return;
+            return (void)++_elidedCalls;
         opt = false;
 #endif
         glDisable(target);
     }
     template <typename _Func, typename _Left, typename _Right>
-    static inline void try_call(_Func&& func, _Left& opt, _Right&& v)
+    inline void try_call(_Func&& func, _Left& opt, _Right&& v)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return (void)++_elidedCalls;
         opt = v;
 #endif
         func(v);
     }
     template <typename _Func, typename _Left, typename _Right, typename... _Args>
-    static inline void try_callf(_Func&& func, _Left& opt, _Right&& v, _Args&&... args)
+    inline void try_callf(_Func&& func, _Left& opt, _Right&& v, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return (void)++_elidedCalls;
         opt = v;
 #endif
         func(args...);
     }
     template <typename _Func, typename _Left, typename _Right>
-    static inline void try_callu(_Func&& func, GLenum target, _Left& opt, _Right&& v)
+    inline void try_callu(_Func&& func, GLenum target, _Left& opt, _Right&& v)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return (void)++_elidedCalls;
         opt = v;
 #endif
         func(target, v);
     }
     template <typename _Func, typename _Left, typename... _Args>
-    static inline void try_callx(_Func&& func, _Left& opt, _Args&&... args)
+    inline void try_callx(_Func&& func, _Left& opt, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt && (*opt).equals(args...))
-            return;
+            return (void)++_elidedCalls;
         opt.emplace(args...);
 #endif
         func(args...);
     }
 
     template <typename _Func, typename _Left, typename... _Args>
-    static inline void try_callxu(_Func&& func, GLenum upvalue, _Left& opt, _Args&&... args)
+    inline void try_callxu(_Func&& func, GLenum upvalue, _Left& opt, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt && (*opt).equals(args...))
-            return;
+            return (void)++_elidedCalls;
         opt.emplace(args...);
 #endif
         func(upvalue, args...);
@@ -259,15 +286,30 @@ struct OpenGLState
     void stencilMaskFront(GLuint v) { try_callu(glStencilMaskSeparate, GL_FRONT, _stencilMaskFront, v); }
     void stencilMaskBack(GLuint v) { try_callu(glStencilMaskSeparate, GL_BACK, _stencilMaskBack, v); }
     void activeTexture(GLenum v) { try_call(glActiveTexture, _activeTexture, v); }
-    void bindTexture(GLenum target, GLuint handle) { try_callx(glBindTexture, _textureBinding, target, handle); }
+    // texture bindings are tracked per texture unit, the default active unit is GL_TEXTURE0
+    void bindTexture(GLenum target, GLuint handle)
+    {
+        const auto unit = static_cast<int>(_activeTexture.value_or(GL_TEXTURE0) - GL_TEXTURE0);
+        if (unit < MAX_TEXTURE_UNITS)
+            try_callx(glBindTexture, _textureBindings[unit], target, handle);
+        else
+            glBindTexture(target, handle);
+    }
     void deleteTexture(GLenum target, GLuint handle)
     {
         glDeleteTextures(1, &handle);
-        if (_textureBinding.has_value() && _textureBinding->handle == handle)
-            _textureBinding.reset();
+        for (auto& binding : _textureBindings)
+        {
+            if (binding.has_value() && binding->handle == handle)
+                binding.reset();
+        }
     }
     GLenum bindBuffer(BufferType type, GLuint buffer)
     {
+        // the element array binding is VAO state, binding another index buffer (e.g. to upload data)
+        // must not modify a cached VAO
+        if (type == BufferType::ELEMENT_ARRAY_BUFFER && _cachedVertexArrayBound && buffer != _cachedVertexArrayIndex)
+            unbindVertexArray();
         auto target = BufferTargets[static_cast<int>(type)];
         try_callu(glBindBuffer, target, _bufferBindings[static_cast<int>(type)], buffer);
         return target;
@@ -277,7 +319,28 @@ struct OpenGLState
         glDeleteBuffers(1, &buffer);
         if (_bufferBindings[static_cast<int>(type)] == buffer)
             _bufferBindings[static_cast<int>(type)].reset();
+        // the name may be reused by the next glGenBuffers, so VAOs pointing at it must go
+        if (!_vertexArrays.empty())
+            deleteVertexArrays(buffer);
     }
+
+    /** The number of GL calls skipped because the state was already set, since the last reset. */
+    std::size_t getElidedCalls() const { return _elidedCalls; }
+    void addElidedCalls(std::size_t count) { _elidedCalls += count; }
+    void resetElidedCalls() { _elidedCalls = 0; }
+
+    /**
+     * Bind the VAO cached for key, creating it on first use.
+     * @return true if the VAO was just created, the caller must specify its attributes and
+     * bind its index buffer.
+     */
+    bool bindVertexArray(const VertexArrayKey& key);
+
+    /** Switch from a cached VAO back to the one bound before the first bindVertexArray call. */
+    void unbindVertexArray();
+
+    /** Delete every cached VAO which references buffer. */
+    void deleteVertexArrays(GLuint buffer);
     void bindUniformBufferBase(GLuint index, GLuint handle)
     {
         try_callxu(glBindBufferBase, GL_UNIFORM_BUFFER, _uniformBufferState, index, handle);
@@ -291,6 +354,8 @@ struct OpenGLState
     {
         _bufferBindings[static_cast<int>(BufferType::ARRAY_BUFFER)].reset();
         _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)].reset();
+        _vertexArrayBind.reset();
+        _cachedVertexArrayBound = false;
     }
 
     void enableVertexAttribArray(GLuint index)
@@ -385,10 +450,19 @@ struct OpenGLState
     }
 
 private:
+    std::size_t _elidedCalls{0};
     uint32_t _attribBits{0}; // vertexAttribArray bitset
     uint32_t _divisorBits{0}; // divisor bitset
     std::optional<GLuint> _bufferBindings[(int)BufferType::COUNT];
 
+    // not deleted on destruction: reset() is used after the context was lost, and the old
+    // names might already belong to objects of the new context
+    std::unordered_map<VertexArrayKey, GLuint, VertexArrayKeyHash> _vertexArrays;
+    std::optional<GLuint> _vertexArrayBind;
+    GLuint _defaultVertexArray{0};
+    GLuint _cachedVertexArrayIndex{0};
+    bool _cachedVertexArrayBound{false};
+
     std::optional<Viewport> _viewPort;
     std::optional<Winding> _winding;
     std::optional<bool> _depthTest;
@@ -416,7 +490,7 @@ private:
     std::optional<GLuint> _stencilMaskFront;
     std::optional<GLuint> _stencilMaskBack;
     std::optional<GLenum> _activeTexture;
-    std::optional<CommonBindState> _textureBinding;
+    std::optional<CommonBindState> _textureBindings[MAX_TEXTURE_UNITS];
     std::optional<UniformBufferBaseBindState> _uniformBufferState;
 };
 
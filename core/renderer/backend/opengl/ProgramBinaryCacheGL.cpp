@@ -0,0 +1,231 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "ProgramBinaryCacheGL.h"
+#include "DriverGL.h"
+#include "base/JobSystem.h"
+#include "base/Data.h"
+#include "platform/FileUtils.h"
+#include "xxhash/xxhash.h"
+
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+struct ProgramBinaryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+constexpr uint32_t PROGRAM_BINARY_MAGIC   = 0x42505841;  // 'AXPB'
+constexpr uint32_t PROGRAM_BINARY_VERSION = 1;
+
+// the jobs writing the binaries, they use FileUtils
+std::mutex s_saveJobsMutex;
+std::vector<JobSystem::JobHandle> s_saveJobs;
+}  // namespace
+
+bool ProgramBinaryCacheGL::isSupported()
+{
+#if AX_GLES_PROFILE == 200 || AX_TARGET_PLATFORM == AX_PLATFORM_WASM
+    return false;
+#else
+    static int supported = -1;
+    if (supported < 0)
+    {
+        supported = 0;
+        if (static_cast<DriverGL*>(DriverBase::getInstance())->isGLES2Only())
+            return false;
+#    if defined(glProgramBinary)
+        // loaded function pointers, null when neither GL 4.1/GLES 3.0 nor ARB_get_program_binary is available
+        if (!glProgramBinary || !glGetProgramBinary || !glProgramParameteri)
+            return false;
+#    endif
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported = formats > 0 ? 1 : 0;
+    }
+    return supported != 0;
+#endif
+}
+
+uint64_t ProgramBinaryCacheGL::getProgramKey(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    if (!isSupported())
+        return 0;
+
+    static uint64_t driverHash = 0;
+    if (driverHash == 0)
+    {
+        auto driver = DriverBase::getInstance();
+        std::string identity{driver->getVendor()};
+        identity.append("|").append(driver->getRenderer()).append("|").append(driver->getVersion());
+        driverHash = XXH64(identity.data(), identity.size(), 0);
+    }
+
+    auto key = XXH64(vertexShader.data(), vertexShader.size(), driverHash);
+    key      = XXH64(fragmentShader.data(), fragmentShader.size(), key);
+    return key != 0 ? key : 1;
+}
+
+GLuint ProgramBinaryCacheGL::loadProgram(uint64_t key)
+{
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+    if (key == 0)
+        return 0;
+
+    auto fileUtils = FileUtils::getInstance();
+    auto path      = getCachePath(key);
+    if (!fileUtils->isFileExist(path))
+        return 0;
+
+    auto data = fileUtils->getDataFromFile(path);
+    ProgramBinaryHeader header;
+    if (static_cast<size_t>(data.getSize()) < sizeof(header))
+    {
+        fileUtils->removeFile(path);
+        return 0;
+    }
+    memcpy(&header, data.getBytes(), sizeof(header));
+    if (header.magic != PROGRAM_BINARY_MAGIC || header.version != PROGRAM_BINARY_VERSION || header.key != key ||
+        header.length != data.getSize() - sizeof(header))
+    {
+        fileUtils->removeFile(path);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    if (!program)
+        return 0;
+
+    glProgramBinary(program, header.format, data.getBytes() + sizeof(header), header.length);
+
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (GL_FALSE == status)
+    {
+        // driver update or unknown format, consume the error and compile from source again
+        glGetError();
+        glDeleteProgram(program);
+        fileUtils->removeFile(path);
+        return 0;
+    }
+    return program;
+#else
+    return 0;
+#endif
+}
+
+void ProgramBinaryCacheGL::prepareProgram(GLuint program)
+{
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+    if (isSupported())
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+}
+
+void ProgramBinaryCacheGL::saveProgram(GLuint program, uint64_t key)
+{
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+    if (key == 0 || !program)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<uint8_t> buffer(sizeof(ProgramBinaryHeader) + length);
+    GLsizei written = 0;
+    GLenum format   = 0;
+    glGetProgramBinary(program, length, &written, &format, buffer.data() + sizeof(ProgramBinaryHeader));
+    if (written <= 0)
+        return;
+
+    ProgramBinaryHeader header{PROGRAM_BINARY_MAGIC, PROGRAM_BINARY_VERSION, key, static_cast<uint32_t>(format),
+                               static_cast<uint32_t>(written)};
+    memcpy(buffer.data(), &header, sizeof(header));
+    buffer.resize(sizeof(header) + written);
+
+    static bool directoryCreated = false;
+    if (!directoryCreated)
+        directoryCreated = FileUtils::getInstance()->createDirectory(getCacheDirectory());
+
+    // write to a temporary file first, an interrupted write must never leave a truncated binary behind
+    auto job = JobSystem::getInstance()->schedule(
+        [path = getCachePath(key), buffer = std::move(buffer)] {
+            auto tempPath = path + ".tmp";
+            if (FileUtils::writeBinaryToFile(buffer.data(), buffer.size(), tempPath))
+                FileUtils::getInstance()->renameFile(tempPath, path);
+        },
+        JobSystem::Priority::LOW);
+
+    std::lock_guard<std::mutex> lock(s_saveJobsMutex);
+    s_saveJobs.erase(std::remove_if(s_saveJobs.begin(), s_saveJobs.end(), &JobSystem::isDone), s_saveJobs.end());
+    s_saveJobs.emplace_back(std::move(job));
+#endif
+}
+
+void ProgramBinaryCacheGL::waitForSaves()
+{
+    std::vector<JobSystem::JobHandle> jobs;
+    {
+        std::lock_guard<std::mutex> lock(s_saveJobsMutex);
+        jobs.swap(s_saveJobs);
+    }
+
+    // a job system destroyed meanwhile ran them already, don't start a new one
+    for (auto&& job : jobs)
+    {
+        if (!JobSystem::isDone(job))
+            JobSystem::getInstance()->wait(job);
+    }
+}
+
+void ProgramBinaryCacheGL::clear()
+{
+    FileUtils::getInstance()->removeDirectory(getCacheDirectory());
+}
+
+std::string ProgramBinaryCacheGL::getCacheDirectory()
+{
+    return FileUtils::getInstance()->getWritablePath() + "shader-cache/";
+}
+
+std::string ProgramBinaryCacheGL::getCachePath(uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return getCacheDirectory() + name;
+}
+
+NS_AX_BACKEND_END
@@ -0,0 +1,87 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "../Macros.h"
+#include "platform/GL.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+/**
+ * Persists linked programs to the writable path with glGetProgramBinary, so later runs and
+ * context recreations can skip compiling and linking the shaders.
+ * The binaries are keyed by the shader sources and the GL vendor, renderer and version, a binary
+ * rejected by the driver is deleted and the program is compiled from source again.
+ */
+struct ProgramBinaryCacheGL
+{
+    /**
+     * Compute the cache key of a program.
+     * @return 0 if the driver can't load program binaries.
+     */
+    static uint64_t getProgramKey(std::string_view vertexShader, std::string_view fragmentShader);
+
+    /**
+     * Create a program from its cached binary.
+     * @param key The cache key of the program, see getProgramKey.
+     * @return A linked program, 0 if there is no usable binary.
+     */
+    static GLuint loadProgram(uint64_t key);
+
+    /**
+     * Ask the driver to keep the binary of program retrievable, call before linking it.
+     */
+    static void prepareProgram(GLuint program);
+
+    /**
+     * Store the binary of a linked program, the file is written off the axmol thread.
+     */
+    static void saveProgram(GLuint program, uint64_t key);
+
+    /**
+     * Block until the binaries being saved are written, call before FileUtils is destroyed.
+     */
+    static void waitForSaves();
+
+    /**
+     * Delete all cached binaries.
+     */
+    static void clear();
+
+private:
+    static bool isSupported();
+    static std::string getCacheDirectory();
+    static std::string getCachePath(uint64_t key);
+};
+// end of _opengl group
+/// @}
+NS_AX_BACKEND_END
@@ -25,6 +25,7 @@
 
 #include "ProgramGL.h"
 #include "ShaderModuleGL.h"
+#include "ProgramBinaryCacheGL.h"
 #include "renderer/backend/Types.h"
 #include "renderer/backend/opengl/MacrosGL.h"
 #include "base/Director.h"
@@ -165,9 +166,16 @@ void ProgramGL::reloadProgram()
     _activeUniformInfos.clear();
     _mapToCurrentActiveLocation.clear();
     _mapToOriginalLocation.clear();
-    static_cast<ShaderModuleGL*>(_vertexShaderModule)->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
-    static_cast<ShaderModuleGL*>(_fragmentShaderModule)->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
-    compileProgram();
+
+    const auto binaryKey = ProgramBinaryCacheGL::getProgramKey(_vertexShader, _fragmentShader);
+    _program             = ProgramBinaryCacheGL::loadProgram(binaryKey);
+    if (!_program)
+    {
+        static_cast<ShaderModuleGL*>(_vertexShaderModule)->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
+        static_cast<ShaderModuleGL*>(_fragmentShaderModule)
+            ->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
+        linkProgram(binaryKey);
+    }
     computeUniformInfos();
 
     for (const auto& uniform : _activeUniformInfos)
@@ -184,6 +192,14 @@ void ProgramGL::compileProgram()
     if (_vertexShaderModule == nullptr || _fragmentShaderModule == nullptr)
         return;
 
+    const auto binaryKey = ProgramBinaryCacheGL::getProgramKey(_vertexShader, _fragmentShader);
+    _program             = ProgramBinaryCacheGL::loadProgram(binaryKey);
+    if (!_program)
+        linkProgram(binaryKey);
+}
+
+void ProgramGL::linkProgram(uint64_t binaryKey)
+{
     auto vertShader = _vertexShaderModule->getShader();
     auto fragShader = _fragmentShaderModule->getShader();
 
@@ -195,6 +211,7 @@ void ProgramGL::compileProgram()
     if (!_program)
         return;
 
+    ProgramBinaryCacheGL::prepareProgram(_program);
     glAttachShader(_program, vertShader);
     glAttachShader(_program, fragShader);
 
@@ -217,6 +234,8 @@ void ProgramGL::compileProgram()
         glDeleteProgram(_program);
         _program = 0;
     }
+    else
+        ProgramBinaryCacheGL::saveProgram(_program, binaryKey);
 }
 
 void ProgramGL::setBuiltinLocations()
@@ -306,6 +325,10 @@ void ProgramGL::computeUniformInfos()
     _maxLocation     = -1;
     _activeUniformInfos.clear();
 
+    _appliedOwner    = nullptr;
+    _appliedRevision = 0;
+    _samplerSlots.clear();
+
     yasio::basic_byte_buffer<GLchar> buffer;  // buffer for name
 
     // OpenGL UBO: uloc[0]: block_offset, uloc[1]: offset in block
@@ -415,6 +438,11 @@ void ProgramGL::computeUniformInfos()
 
 void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
 {
+    // unknown owner, the next tracked apply must upload everything
+    _appliedOwner    = nullptr;
+    _appliedRevision = 0;
+    _samplerSlots.clear();
+
 #if AX_GLES_PROFILE != 200
     for (GLuint blockIdx = 0; blockIdx < static_cast<GLuint>(_uniformBuffers.size()); ++blockIdx)
     {
@@ -438,6 +466,84 @@ void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
     CHECK_GL_ERROR_DEBUG();
 }
 
+std::size_t ProgramGL::bindUniformBuffers(const char* buffer,
+                                          size_t bufferSize,
+                                          const void* owner,
+                                          uint64_t revision,
+                                          size_t dirtyBegin,
+                                          size_t dirtyEnd)
+{
+    std::size_t elided   = 0;
+    const bool sameOwner = owner == _appliedOwner;
+    if (sameOwner && revision == _appliedRevision)
+        dirtyBegin = dirtyEnd = 0;
+    else if (!sameOwner)
+    {
+        dirtyBegin = 0;
+        dirtyEnd   = bufferSize;
+    }
+
+    _appliedOwner    = owner;
+    _appliedRevision = revision;
+
+#if AX_GLES_PROFILE != 200
+    for (GLuint blockIdx = 0; blockIdx < static_cast<GLuint>(_uniformBuffers.size()); ++blockIdx)
+    {
+        auto& desc            = _uniformBuffers[blockIdx];
+        const size_t blockEnd = desc._location + desc._size;
+        const size_t first    = (std::max)(dirtyBegin, static_cast<size_t>(desc._location));
+        const size_t last     = (std::min)(dirtyEnd, blockEnd);
+        if (first < last)
+        {
+            if (first == static_cast<size_t>(desc._location) && last == blockEnd)
+                desc._ubo->updateData(buffer + desc._location, desc._size);
+            else
+                desc._ubo->updateSubData(buffer + first, first - desc._location, last - first);
+        }
+        else
+            ++elided;
+        __gl->bindUniformBufferBase(blockIdx, desc._ubo->getHandler());
+    }
+#else
+    for (auto&& iter : _activeUniformInfos)
+    {
+        auto& uniformInfo = iter.second;
+        if (uniformInfo.size <= 0)
+            continue;
+
+        // samplers are not stored in the buffer, see setSamplerSlot
+        if (uniformInfo.bufferOffset == static_cast<unsigned int>(-1))
+            continue;
+
+        const size_t first = uniformInfo.bufferOffset;
+        const size_t last  = first + uniformInfo.size * uniformInfo.count;
+        if (last <= dirtyBegin || first >= dirtyEnd)
+        {
+            ++elided;
+            continue;
+        }
+
+        int elementCount = uniformInfo.count;
+        setUniform(uniformInfo.count > 1, uniformInfo.location, elementCount, uniformInfo.type,
+                   (void*)(buffer + uniformInfo.bufferOffset));
+    }
+#endif
+
+    CHECK_GL_ERROR_DEBUG();
+    return elided;
+}
+
+bool ProgramGL::setSamplerSlot(GLint location, GLint slot)
+{
+    auto it = _samplerSlots.find(location);
+    if (it != _samplerSlots.end() && it->second == slot)
+        return false;
+
+    _samplerSlots[location] = slot;
+    glUniform1i(location, slot);
+    return true;
+}
+
 void ProgramGL::clearUniformBuffers()
 {
     if (_uniformBuffers.empty())
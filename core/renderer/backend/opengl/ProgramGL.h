@@ -163,8 +163,29 @@ public:
 
     void bindUniformBuffers(const char* buffer, size_t bufferSize);
 
+    /**
+     * Apply the uniform buffer of a program state, skipping what the program already holds.
+     * Nothing is uploaded when owner and revision match the last applied ones, only the dirty
+     * range when the same owner was applied last, everything otherwise.
+     * @return The number of skipped GL calls.
+     */
+    std::size_t bindUniformBuffers(const char* buffer,
+                                   size_t bufferSize,
+                                   const void* owner,
+                                   uint64_t revision,
+                                   size_t dirtyBegin,
+                                   size_t dirtyEnd);
+
+    /**
+     * Point a sampler uniform to a texture slot, sampler values are program state so the call
+     * is skipped when the program already holds the value.
+     * @return false if the GL call was skipped.
+     */
+    bool setSamplerSlot(GLint location, GLint slot);
+
 private:
     void compileProgram();
+    void linkProgram(uint64_t binaryKey);
     void computeUniformInfos();
     void setBuiltinLocations();
 
@@ -199,6 +220,11 @@ private:
 
     std::size_t _totalBufferSize = 0;  // total uniform buffer size (all blocks)
 
+    // last applied uniform data and sampler values, reset whenever the uniform infos are recomputed
+    const void* _appliedOwner = nullptr;
+    uint64_t _appliedRevision = 0;
+    std::unordered_map<GLint, GLint> _samplerSlots;
+
     int _maxLocation = -1;
     UniformLocation _builtinUniformLocation[UNIFORM_MAX];
     int _builtinAttributeLocation[Attribute::ATTRIBUTE_MAX];
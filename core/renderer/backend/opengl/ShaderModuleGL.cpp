@@ -31,16 +31,24 @@
 
 NS_AX_BACKEND_BEGIN
 
-ShaderModuleGL::ShaderModuleGL(ShaderStage stage, std::string_view source) : ShaderModule(stage)
-{
-    compileShader(stage, source);
-}
+ShaderModuleGL::ShaderModuleGL(ShaderStage stage, std::string_view source) : ShaderModule(stage), _source(source) {}
 
 ShaderModuleGL::~ShaderModuleGL()
 {
     deleteShader();
 }
 
+GLuint ShaderModuleGL::getShader()
+{
+    if (_shader == 0 && !_source.empty())
+    {
+        compileShader(_stage, _source);
+        // the programs keep their own copy of the source for context recreation
+        std::string{}.swap(_source);
+    }
+    return _shader;
+}
+
 void ShaderModuleGL::compileShader(ShaderStage stage, std::string_view source)
 {
     GLenum shaderType       = stage == ShaderStage::VERTEX ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER;
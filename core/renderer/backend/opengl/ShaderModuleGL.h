@@ -48,16 +48,18 @@ public:
     ~ShaderModuleGL();
 
     /**
-     * Get shader object.
+     * Get shader object, the shader is compiled on first use since programs loaded from the
+     * program binary cache never need it.
      * @return Shader object.
      */
-    inline GLuint getShader() const { return _shader; }
+    GLuint getShader();
 
 private:
     void compileShader(ShaderStage stage, std::string_view source);
     void deleteShader();
 
     GLuint _shader = 0;
+    std::string _source;
     friend class ProgramGL;
 };
 // end of _opengl group
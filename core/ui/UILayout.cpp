@@ -74,6 +74,9 @@ Layout::Layout()
     , _clippingRectDirty(true)
     , _stencilStateManager(new StencilStateManager())
     , _doLayoutDirty(true)
+    , _childLayoutDirty(false)
+    , _childLayoutDirtyIndex(0)
+    , _layoutManager(nullptr)
     , _isInterceptTouch(false)
     , _loopFocus(false)
     , _passFocusToChild(true)
@@ -85,6 +88,7 @@ Layout::Layout()
 Layout::~Layout()
 {
     AX_SAFE_RELEASE(_clippingStencil);
+    AX_SAFE_RELEASE(_layoutManager);
     AX_SAFE_DELETE(_stencilStateManager);
 }
 
@@ -886,6 +890,10 @@ const Vec2& Layout::getBackGroundImageTextureSize() const
 
 void Layout::setLayoutType(Type type)
 {
+    if (_layoutType != type)
+    {
+        AX_SAFE_RELEASE_NULL(_layoutManager);
+    }
     _layoutType = type;
 
     for (auto&& child : _children)
@@ -915,6 +923,28 @@ void Layout::requestDoLayout()
     _doLayoutDirty = true;
 }
 
+void Layout::requestDoLayoutForChild(Node* child)
+{
+    if (_doLayoutDirty)
+    {
+        // a full layout is pending already
+        return;
+    }
+
+    // the indices are only known once the children are sorted
+    ssize_t index = _reorderChildDirty ? 0 : _children.getIndex(child);
+    if (index < 0)
+    {
+        return;
+    }
+
+    if (!_childLayoutDirty || index < _childLayoutDirtyIndex)
+    {
+        _childLayoutDirtyIndex = index;
+    }
+    _childLayoutDirty = true;
+}
+
 Vec2 Layout::getLayoutContentSize() const
 {
     return this->getContentSize();
@@ -954,21 +984,29 @@ LayoutManager* Layout::createLayoutManager()
 void Layout::doLayout()
 {
 
-    if (!_doLayoutDirty)
+    if (!_doLayoutDirty && !_childLayoutDirty)
     {
         return;
     }
 
+    // reordering the children invalidates the arrangement cached by the layout manager
+    ssize_t firstDirtyIndex = (_doLayoutDirty || _reorderChildDirty) ? 0 : _childLayoutDirtyIndex;
+
     sortAllChildren();
 
-    LayoutManager* executant = this->createLayoutManager();
+    if (!_layoutManager)
+    {
+        _layoutManager = this->createLayoutManager();
+        AX_SAFE_RETAIN(_layoutManager);
+    }
 
-    if (executant)
+    if (_layoutManager)
     {
-        executant->doLayout(this);
+        _layoutManager->updateLayout(this, firstDirtyIndex);
     }
 
-    _doLayoutDirty = false;
+    _doLayoutDirty    = false;
+    _childLayoutDirty = false;
 }
 
 std::string Layout::getDescription() const
@@ -404,6 +404,15 @@ public:
      */
     virtual void requestDoLayout();
 
+    /**
+     * Request to refresh the layout after the size or the layout parameter of a child changed.
+     * The requests are coalesced into the next doLayout, linear layouts only rearrange the child and the children
+     * after it.
+     *
+     * @param child The child which changed.
+     */
+    void requestDoLayoutForChild(Node* child);
+
     /**
      * @lua NA
      */
@@ -647,6 +656,11 @@ protected:
     //CallbackCommand _afterVisitCmdScissor;
 
     bool _doLayoutDirty;
+    // set by requestDoLayoutForChild, the children from _childLayoutDirtyIndex on need to be arranged
+    bool _childLayoutDirty;
+    ssize_t _childLayoutDirtyIndex;
+    // kept across layouts, caches the arrangement of the last layout
+    LayoutManager* _layoutManager;
     bool _isInterceptTouch;
 
     // whether enable loop focus or not
@@ -40,12 +40,28 @@ LinearHorizontalLayoutManager* LinearHorizontalLayoutManager::create()
 
 void LinearHorizontalLayoutManager::doLayout(LayoutProtocol* layout)
 {
-    Vec2 layoutSize         = layout->getLayoutContentSize();
-    Vector<Node*> container = layout->getLayoutElements();
-    float leftBoundary      = 0.0f;
-    for (auto&& subWidget : container)
+    updateLayout(layout, 0);
+}
+
+void LinearHorizontalLayoutManager::updateLayout(LayoutProtocol* layout, ssize_t firstDirtyIndex)
+{
+    Vec2 layoutSize     = layout->getLayoutContentSize();
+    auto&& container    = layout->getLayoutElements();
+    const ssize_t count = container.size();
+
+    // the boundaries of the last layout are only valid for the same elements in the same size
+    if (static_cast<ssize_t>(_boundaries.size()) != count || !_layoutSize.equals(layoutSize))
     {
-        Widget* child = dynamic_cast<Widget*>(subWidget);
+        firstDirtyIndex = 0;
+    }
+    _boundaries.resize(count);
+    _layoutSize = layoutSize;
+
+    float leftBoundary = firstDirtyIndex > 0 ? _boundaries[firstDirtyIndex - 1] : 0.0f;
+    for (ssize_t i = firstDirtyIndex; i < count; ++i)
+    {
+        Node* subWidget = container.at(i);
+        Widget* child   = dynamic_cast<Widget*>(subWidget);
         if (child)
         {
             LinearLayoutParameter* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter());
@@ -77,6 +93,7 @@ void LinearHorizontalLayoutManager::doLayout(LayoutProtocol* layout)
                 leftBoundary = child->getRightBoundary() + mg.right;
             }
         }
+        _boundaries[i] = leftBoundary;
     }
 }
 
@@ -90,12 +107,27 @@ LinearVerticalLayoutManager* LinearVerticalLayoutManager::create()
 
 void LinearVerticalLayoutManager::doLayout(LayoutProtocol* layout)
 {
-    Vec2 layoutSize         = layout->getLayoutContentSize();
-    Vector<Node*> container = layout->getLayoutElements();
-    float topBoundary       = layoutSize.height;
+    updateLayout(layout, 0);
+}
 
-    for (auto&& subWidget : container)
+void LinearVerticalLayoutManager::updateLayout(LayoutProtocol* layout, ssize_t firstDirtyIndex)
+{
+    Vec2 layoutSize     = layout->getLayoutContentSize();
+    auto&& container    = layout->getLayoutElements();
+    const ssize_t count = container.size();
+
+    // the boundaries of the last layout are only valid for the same elements in the same size
+    if (static_cast<ssize_t>(_boundaries.size()) != count || !_layoutSize.equals(layoutSize))
+    {
+        firstDirtyIndex = 0;
+    }
+    _boundaries.resize(count);
+    _layoutSize = layoutSize;
+
+    float topBoundary = firstDirtyIndex > 0 ? _boundaries[firstDirtyIndex - 1] : layoutSize.height;
+    for (ssize_t i = firstDirtyIndex; i < count; ++i)
     {
+        Node* subWidget                = container.at(i);
         LayoutParameterProtocol* child = dynamic_cast<LayoutParameterProtocol*>(subWidget);
         if (child)
         {
@@ -130,6 +162,7 @@ void LinearVerticalLayoutManager::doLayout(LayoutProtocol* layout)
                               subWidget->getAnchorPoint().y * subWidget->getBoundingBox().size.height - mg.bottom;
             }
         }
+        _boundaries[i] = topBoundary;
     }
 }
 
@@ -283,7 +316,7 @@ RelativeLayoutManager* RelativeLayoutManager::create()
 
 Vector<Widget*> RelativeLayoutManager::getAllWidgets(ax::ui::LayoutProtocol* layout)
 {
-    Vector<Node*> container = layout->getLayoutElements();
+    auto&& container = layout->getLayoutElements();
     Vector<Widget*> widgetChildren;
     for (auto&& subWidget : container)
     {
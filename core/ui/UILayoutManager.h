@@ -28,6 +28,8 @@
 
 #include "base/Ref.h"
 #include "base/Vector.h"
+#include "math/Vec2.h"
+#include <vector>
 #include "ui/GUIExport.h"
 
 /**
@@ -58,6 +60,15 @@ public:
      */
     virtual void doLayout(LayoutProtocol* layout) = 0;
 
+    /**
+     * Lays out the elements from firstDirtyIndex on, the elements before it didn't change since the last layout
+     * by this manager. Does a full layout by default.
+     *
+     * @param layout The layout to arrange.
+     * @param firstDirtyIndex The index of the first changed element.
+     */
+    virtual void updateLayout(LayoutProtocol* layout, ssize_t /*firstDirtyIndex*/) { doLayout(layout); }
+
     friend class Layout;
 };
 
@@ -74,6 +85,11 @@ private:
     virtual ~LinearVerticalLayoutManager(){}
     static LinearVerticalLayoutManager* create();
     virtual void doLayout(LayoutProtocol* layout) override;
+    virtual void updateLayout(LayoutProtocol* layout, ssize_t firstDirtyIndex) override;
+
+    // the top boundary below every element after the last layout
+    std::vector<float> _boundaries;
+    Vec2 _layoutSize;
 
     friend class Layout;
 };
@@ -91,6 +107,11 @@ private:
     virtual ~LinearHorizontalLayoutManager(){}
     static LinearHorizontalLayoutManager* create();
     virtual void doLayout(LayoutProtocol* layout) override;
+    virtual void updateLayout(LayoutProtocol* layout, ssize_t firstDirtyIndex) override;
+
+    // the left boundary beside every element after the last layout
+    std::vector<float> _boundaries;
+    Vec2 _layoutSize;
 
     friend class Layout;
 };
@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 #include "ui/UIListView.h"
 #include "ui/UIHelper.h"
+#include <algorithm>
 
 NS_AX_BEGIN
 
@@ -49,6 +50,10 @@ ListView::ListView()
     , _curSelectedIndex(-1)
     , _innerContainerDoLayoutDirty(true)
     , _eventCallback(nullptr)
+    , _virtualItemCount(0)
+    , _virtualItemOffsetsDirty(true)
+    , _virtualItemsRebind(false)
+    , _virtualFirstIndex(0)
 {
     this->setTouchEnabled(true);
 }
@@ -339,6 +344,8 @@ void ListView::removeAllChildrenWithCleanup(bool cleanup)
     ScrollView::removeAllChildrenWithCleanup(cleanup);
     _curSelectedIndex = -1;
     _items.clear();
+    _virtualItems.clear();
+    _recycledItems.clear();
     onItemListChanged();
 }
 
@@ -382,6 +389,12 @@ void ListView::removeAllItems()
 
 Widget* ListView::getItem(ssize_t index) const
 {
+    if (_virtualItemBinder)
+    {
+        // only the items in view exist
+        index -= _virtualFirstIndex;
+        return (index < 0 || index >= _virtualItems.size()) ? nullptr : _virtualItems.at(index);
+    }
     if (index < 0 || index >= _items.size())
     {
         return nullptr;
@@ -400,6 +413,11 @@ ssize_t ListView::getIndex(Widget* item) const
     {
         return -1;
     }
+    if (_virtualItemBinder)
+    {
+        ssize_t index = _virtualItems.getIndex(item);
+        return index < 0 ? -1 : _virtualFirstIndex + index;
+    }
     return _items.getIndex(item);
 }
 
@@ -534,6 +552,294 @@ float ListView::getScrollDuration() const
     return _scrollTime;
 }
 
+void ListView::setVirtualItems(ssize_t count, const ccListViewItemBinder& binder)
+{
+    removeAllItems();
+    _virtualItemBinder = binder;
+    _virtualItemLengths.clear();
+    _virtualItemOffsets.clear();
+    _virtualItemCount  = 0;
+    _virtualFirstIndex = 0;
+
+    if (!_virtualItemBinder)
+    {
+        // back to the linear layout of the inner container
+        setDirection(_direction);
+        requestDoLayout();
+        return;
+    }
+
+    AXASSERT(_model, "The virtual mode creates its items from the item model, call setItemModel first!");
+
+    // the items are positioned by ListView
+    _innerContainer->setLayoutType(Type::ABSOLUTE);
+    setVirtualItemCount(count);
+}
+
+void ListView::setVirtualItemCount(ssize_t count)
+{
+    if (!_virtualItemBinder)
+    {
+        return;
+    }
+
+    float estimatedLength = 0.0f;
+    if (_model)
+    {
+        estimatedLength = (_direction == Direction::HORIZONTAL) ? _model->getContentSize().width * _model->getScaleX()
+                                                                : _model->getContentSize().height * _model->getScaleY();
+    }
+
+    _virtualItemCount = std::max<ssize_t>(count, 0);
+    _virtualItemLengths.resize(_virtualItemCount, estimatedLength);
+    _virtualItemOffsetsDirty = true;
+    _virtualItemsRebind      = true;
+    if (_curSelectedIndex >= _virtualItemCount)
+    {
+        _curSelectedIndex = -1;
+    }
+}
+
+ssize_t ListView::getVirtualItemCount() const
+{
+    return _virtualItemCount;
+}
+
+bool ListView::isVirtual() const
+{
+    return _virtualItemBinder != nullptr;
+}
+
+void ListView::refreshVirtualItems()
+{
+    _virtualItemsRebind = true;
+}
+
+Widget* ListView::obtainVirtualItem()
+{
+    if (!_recycledItems.empty())
+    {
+        // still retained by the inner container
+        Widget* item = _recycledItems.back();
+        _recycledItems.popBack();
+        item->setVisible(true);
+        return item;
+    }
+
+    Widget* item = _model->clone();
+    ScrollView::addChild(item, item->getLocalZOrder(), item->getTag());
+    return item;
+}
+
+void ListView::measureVirtualItem(Widget* item, ssize_t index)
+{
+    float length = (_direction == Direction::HORIZONTAL) ? item->getContentSize().width * item->getScaleX()
+                                                         : item->getContentSize().height * item->getScaleY();
+    if (length != _virtualItemLengths[index])
+    {
+        _virtualItemLengths[index] = length;
+        _virtualItemOffsetsDirty   = true;
+    }
+}
+
+void ListView::updateVirtualItemOffsets()
+{
+    _virtualItemOffsets.resize(_virtualItemCount);
+    float offset = 0.0f;
+    for (ssize_t i = 0; i < _virtualItemCount; ++i)
+    {
+        _virtualItemOffsets[i] = offset;
+        offset += _virtualItemLengths[i] + _itemsMargin;
+    }
+    _virtualItemOffsetsDirty = false;
+
+    // same as updateInnerContainerSize, from the measured or estimated lengths
+    float totalLength = (_virtualItemCount == 0) ? 0.0f : offset - _itemsMargin;
+    if (_direction == Direction::VERTICAL)
+    {
+        totalLength += (_virtualItemCount == 0) ? 0.0f : _topPadding + _bottomPadding;
+
+        // keep the items in view in place, the items are aligned to the top
+        float topBoundary = _innerContainer->getTopBoundary();
+        setInnerContainerSize(Vec2(_contentSize.width, totalLength));
+
+        const Vec2& innerSize = _innerContainer->getContentSize();
+        float bottomBoundary =
+            std::min(std::max(topBoundary - innerSize.height, _contentSize.height - innerSize.height), 0.0f);
+        setInnerContainerPosition(Vec2(_innerContainer->getPositionX(),
+                                       bottomBoundary + _innerContainer->getAnchorPoint().y * innerSize.height));
+    }
+    else
+    {
+        totalLength += (_virtualItemCount == 0) ? 0.0f : _leftPadding + _rightPadding;
+        setInnerContainerSize(Vec2(totalLength, _contentSize.height));
+    }
+}
+
+void ListView::positionVirtualItem(Widget* item, ssize_t index)
+{
+    // same as the linear layout with the margins of remedyLayoutParameter
+    const Vec2& innerSize = _innerContainer->getContentSize();
+    const Vec2 ap         = item->getAnchorPoint();
+    const Vec2 cs         = item->getBoundingBox().size;
+    float finalPosX, finalPosY;
+    if (_direction == Direction::VERTICAL)
+    {
+        finalPosY = innerSize.height - _topPadding - _virtualItemOffsets[index] - (1.0f - ap.y) * cs.height;
+        switch (_gravity)
+        {
+        case Gravity::RIGHT:
+            finalPosX = innerSize.width - (1.0f - ap.x) * cs.width;
+            break;
+        case Gravity::CENTER_HORIZONTAL:
+            finalPosX = innerSize.width / 2.0f - cs.width * (0.5f - ap.x);
+            break;
+        default:
+            finalPosX = ap.x * cs.width;
+            break;
+        }
+        finalPosX += _leftPadding;
+    }
+    else
+    {
+        finalPosX = _leftPadding + _virtualItemOffsets[index] + ap.x * cs.width;
+        switch (_gravity)
+        {
+        case Gravity::BOTTOM:
+            finalPosY = ap.y * cs.height;
+            break;
+        case Gravity::CENTER_VERTICAL:
+            finalPosY = innerSize.height / 2.0f - cs.height * (0.5f - ap.y);
+            break;
+        default:
+            finalPosY = innerSize.height - (1.0f - ap.y) * cs.height;
+            break;
+        }
+        finalPosY -= _topPadding;
+    }
+    item->setPosition(Vec2(finalPosX, finalPosY));
+}
+
+void ListView::updateVirtualItems()
+{
+    if (_direction != Direction::VERTICAL && _direction != Direction::HORIZONTAL)
+    {
+        return;
+    }
+
+    if (_innerContainerDoLayoutDirty)
+    {
+        // margins, paddings or the view size changed
+        _virtualItemOffsetsDirty     = true;
+        _innerContainerDoLayoutDirty = false;
+    }
+    if (_virtualItemOffsetsDirty)
+    {
+        updateVirtualItemOffsets();
+    }
+
+    // the range in view, as distances from the start padding
+    float viewStart, viewEnd;
+    if (_direction == Direction::VERTICAL)
+    {
+        viewEnd   = _innerContainer->getTopBoundary() - _topPadding;
+        viewStart = viewEnd - _contentSize.height;
+    }
+    else
+    {
+        viewStart = -_innerContainer->getLeftBoundary() - _leftPadding;
+        viewEnd   = viewStart + _contentSize.width;
+    }
+
+    ssize_t first = 0;
+    ssize_t last  = -1;
+    if (_virtualItemCount > 0)
+    {
+        auto begin = _virtualItemOffsets.begin();
+        first      = std::max<ssize_t>(std::upper_bound(begin, _virtualItemOffsets.end(), viewStart) - begin - 1, 0);
+        if (_virtualItemOffsets[first] + _virtualItemLengths[first] < viewStart && first + 1 < _virtualItemCount)
+        {
+            ++first;
+        }
+        last = std::max<ssize_t>(std::upper_bound(begin, _virtualItemOffsets.end(), viewEnd) - begin - 1, first);
+    }
+
+    // recycle the items which left the view, keep the others
+    const ssize_t boundFirst = _virtualFirstIndex;
+    const ssize_t boundLast  = _virtualFirstIndex + _virtualItems.size() - 1;
+    if (first != boundFirst || last != boundLast || _virtualItemsRebind)
+    {
+        for (ssize_t i = boundFirst; i <= boundLast; ++i)
+        {
+            if (i < first || i > last)
+            {
+                Widget* item = _virtualItems.at(i - boundFirst);
+                item->setVisible(false);
+                _recycledItems.pushBack(item);
+            }
+        }
+
+        Vector<Widget*> items(last - first + 1);
+        for (ssize_t i = first; i <= last; ++i)
+        {
+            if (i >= boundFirst && i <= boundLast)
+            {
+                Widget* item = _virtualItems.at(i - boundFirst);
+                if (_virtualItemsRebind)
+                {
+                    _virtualItemBinder(item, i);
+                }
+                items.pushBack(item);
+            }
+            else
+            {
+                Widget* item = obtainVirtualItem();
+                _virtualItemBinder(item, i);
+                items.pushBack(item);
+            }
+        }
+        _virtualItems       = std::move(items);
+        _virtualFirstIndex  = first;
+        _virtualItemsRebind = false;
+    }
+
+    // the bound items may change their size at any time
+    for (ssize_t i = 0, count = _virtualItems.size(); i < count; ++i)
+    {
+        measureVirtualItem(_virtualItems.at(i), _virtualFirstIndex + i);
+    }
+    if (_virtualItemOffsetsDirty)
+    {
+        updateVirtualItemOffsets();
+    }
+
+    for (ssize_t i = 0, count = _virtualItems.size(); i < count; ++i)
+    {
+        positionVirtualItem(_virtualItems.at(i), _virtualFirstIndex + i);
+    }
+}
+
+Vec2 ListView::calculateVirtualItemDestination(const Vec2& positionRatioInView,
+                                               ssize_t index,
+                                               const Vec2& itemAnchorPoint)
+{
+    // like calculateItemDestination, along the direction only
+    Vec2 destination = getInnerContainerPosition();
+    float length     = _virtualItemLengths[index];
+    if (_direction == Direction::VERTICAL)
+    {
+        float itemBottom =
+            _innerContainer->getContentSize().height - _topPadding - _virtualItemOffsets[index] - length;
+        destination.y = -(itemBottom + length * itemAnchorPoint.y - _contentSize.height * positionRatioInView.y);
+    }
+    else
+    {
+        float itemLeft = _leftPadding + _virtualItemOffsets[index];
+        destination.x  = -(itemLeft + length * itemAnchorPoint.x - _contentSize.width * positionRatioInView.x);
+    }
+    return destination;
+}
+
 void ListView::setDirection(Direction dir)
 {
     switch (dir)
@@ -561,6 +867,13 @@ void ListView::requestDoLayout()
 
 void ListView::doLayout()
 {
+    if (_virtualItemBinder)
+    {
+        // runs on every visit, the items in view change while scrolling
+        updateVirtualItems();
+        return;
+    }
+
     if (!_innerContainerDoLayoutDirty)
     {
         return;
@@ -843,14 +1156,27 @@ Vec2 ListView::calculateItemDestination(const Vec2& positionRatioInView, Widget*
 
 void ListView::jumpToItem(ssize_t itemIndex, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint)
 {
-    Widget* item = getItem(itemIndex);
-    if (item == nullptr)
+    Vec2 destination;
+    if (_virtualItemBinder)
     {
-        return;
+        if (itemIndex < 0 || itemIndex >= _virtualItemCount)
+        {
+            return;
+        }
+        doLayout();
+        destination = calculateVirtualItemDestination(positionRatioInView, itemIndex, itemAnchorPoint);
+    }
+    else
+    {
+        Widget* item = getItem(itemIndex);
+        if (item == nullptr)
+        {
+            return;
+        }
+        doLayout();
+        destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     }
-    doLayout();
 
-    Vec2 destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     if (!_bounceEnabled)
     {
         Vec2 delta         = destination - getInnerContainerPosition();
@@ -870,6 +1196,19 @@ void ListView::scrollToItem(ssize_t itemIndex,
                             const Vec2& itemAnchorPoint,
                             float timeInSec)
 {
+    if (_virtualItemBinder)
+    {
+        if (itemIndex < 0 || itemIndex >= _virtualItemCount)
+        {
+            return;
+        }
+        // the destination is based on the estimated lengths of the items which weren't in view yet
+        doLayout();
+        Vec2 destination = calculateVirtualItemDestination(positionRatioInView, itemIndex, itemAnchorPoint);
+        startAutoScrollToDestination(destination, timeInSec, true);
+        return;
+    }
+
     Widget* item = getItem(itemIndex);
     if (item == nullptr)
     {
@@ -28,6 +28,7 @@ THE SOFTWARE.
 
 #include "ui/UIScrollView.h"
 #include "ui/GUIExport.h"
+#include <vector>
 
 /**
  * @addtogroup ui
@@ -41,8 +42,8 @@ namespace ui
 /**
  *@brief ListView is a view group that displays a list of scrollable items.
  *The list items are inserted to the list by using `addChild` or  `insertDefaultItem`.
- * @warning The list item in ListView doesn't support cell reuse at the moment, if you have a large amount of data need
- *to be displayed, use  `TableView` instead. ListView is a subclass of  `ScrollView`, so it shares many features of
+ * @warning The list items in ListView aren't reused, if you have a large amount of data need to be displayed, use the
+ *virtual mode, see `setVirtualItems`. ListView is a subclass of  `ScrollView`, so it shares many features of
  *ScrollView.
  */
 class AX_GUI_DLL ListView : public ScrollView
@@ -94,6 +95,11 @@ public:
      */
     typedef std::function<void(Ref*, EventType)> ccListViewCallback;
 
+    /**
+     * Fills an item of the virtual mode with the data at index.
+     */
+    typedef std::function<void(Widget*, ssize_t)> ccListViewItemBinder;
+
     /**
      * Default constructor
      * @js ctor
@@ -303,6 +309,40 @@ public:
      */
     float getScrollDuration() const;
 
+    /**
+     * @brief Switch to the virtual mode, for lists too long to create a widget for every item.
+     *
+     * ListView only holds the items in view then. They are cloned from the item model, recycled while scrolling and
+     * filled by binder with the data at their index. The lengths of the items which weren't in view yet are estimated
+     * from the item model, the inner container is resized while the real lengths are measured.
+     * The items added before are removed, magnetic scrolling doesn't apply in the virtual mode.
+     *
+     * @param count The number of items.
+     * @param binder Fills an item with the data at an index, nullptr leaves the virtual mode.
+     * @see setItemModel
+     */
+    void setVirtualItems(ssize_t count, const ccListViewItemBinder& binder);
+
+    /**
+     * Changes the number of items of the virtual mode, the items in view are bound again.
+     */
+    void setVirtualItemCount(ssize_t count);
+
+    /**
+     * Returns the number of items of the virtual mode.
+     */
+    ssize_t getVirtualItemCount() const;
+
+    /**
+     * Query whether the list is in the virtual mode.
+     */
+    bool isVirtual() const;
+
+    /**
+     * Binds the items in view again, after the data they show changed.
+     */
+    void refreshVirtualItems();
+
     // override methods
     virtual void doLayout() override;
     virtual void requestDoLayout() override;
@@ -453,6 +493,13 @@ protected:
     void startMagneticScroll();
     Vec2 calculateItemDestination(const Vec2& positionRatioInView, Widget* item, const Vec2& itemAnchorPoint);
 
+    void updateVirtualItems();
+    void updateVirtualItemOffsets();
+    void measureVirtualItem(Widget* item, ssize_t index);
+    void positionVirtualItem(Widget* item, ssize_t index);
+    Widget* obtainVirtualItem();
+    Vec2 calculateVirtualItemDestination(const Vec2& positionRatioInView, ssize_t index, const Vec2& itemAnchorPoint);
+
 protected:
     Widget* _model;
 
@@ -476,6 +523,21 @@ protected:
 
     bool _innerContainerDoLayoutDirty;
     ccListViewCallback _eventCallback;
+
+    // virtual mode
+    ccListViewItemBinder _virtualItemBinder;
+    ssize_t _virtualItemCount;
+    // the length of every item along the direction, measured once it was in view, estimated before
+    std::vector<float> _virtualItemLengths;
+    // the distance of every item from the start padding
+    std::vector<float> _virtualItemOffsets;
+    bool _virtualItemOffsetsDirty;
+    bool _virtualItemsRebind;
+    // the bound items in index order, starting at _virtualFirstIndex
+    Vector<Widget*> _virtualItems;
+    ssize_t _virtualFirstIndex;
+    // hidden items out of view, bound again once they scroll into view
+    Vector<Widget*> _recycledItems;
 };
 
 }  // namespace ui
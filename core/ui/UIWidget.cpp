@@ -317,6 +317,11 @@ void Widget::setContentSize(const Vec2& contentSize)
         _sizePercent.set(spx, spy);
     }
     onSizeChanged();
+
+    if (auto layoutParent = dynamic_cast<Layout*>(_parent))
+    {
+        layoutParent->requestDoLayoutForChild(this);
+    }
 }
 
 void Widget::setSizePercent(const Vec2& percent)
@@ -1102,6 +1107,11 @@ void Widget::setLayoutParameter(LayoutParameter* parameter)
     }
     _layoutParameterDictionary.insert((int)parameter->getLayoutType(), parameter);
     _layoutParameterType = parameter->getLayoutType();
+
+    if (auto layoutParent = dynamic_cast<Layout*>(_parent))
+    {
+        layoutParent->requestDoLayoutForChild(this);
+    }
 }
 
 LayoutParameter* Widget::getLayoutParameter() const
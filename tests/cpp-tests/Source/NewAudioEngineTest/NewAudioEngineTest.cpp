@@ -53,6 +53,8 @@ AudioEngineTests::AudioEngineTests()
 
     ADD_TEST_CASE(AudioIssue18597Test);
     ADD_TEST_CASE(AudioIssue11143Test);
+    ADD_TEST_CASE(AudioMixerHeadlessTest);
+    ADD_TEST_CASE(AudioCacheBudgetTest);
 
     // FIXME: Please keep AudioSwitchStateTest to the last position since this test case doesn't work well on each
     // platforms.
@@ -478,7 +480,7 @@ bool AudioWavTest::init()
         _stateLabel->setPosition(layerSize.width / 2, layerSize.height * 0.7f);
         addChild(_stateLabel);
 
-        auto playPrev = TextButton::create("Play Prev", [=](TextButton* button) {
+        auto playPrev = TextButton::create("Play Prev", [this](TextButton* button) {
             if (_curIndex > 0)
             {
                 AudioEngine::stop(_audioID);
@@ -490,8 +492,8 @@ bool AudioWavTest::init()
         playPrev->setPosition(layerSize.width * 0.35f, layerSize.height * 0.5f);
         addChild(playPrev);
 
-        auto playNext = TextButton::create("Play Next", [=](TextButton* button) {
-            if (_curIndex != -1 && _curIndex < (_wavFiles.size() - 1))
+        auto playNext = TextButton::create("Play Next", [this](TextButton* button) {
+            if (_curIndex != -1 && _curIndex + 1 < static_cast<int>(_wavFiles.size()))
             {
                 AudioEngine::stop(_audioID);
                 _audioID = AudioEngine::play2d(_wavFiles[++_curIndex]);
@@ -737,7 +739,7 @@ bool AudioIssue18597Test::init()
 
         // test case for https://github.com/cocos2d/cocos2d-x/issues/18597
         this->schedule(
-            [=](float dt) {
+            [this](float dt) {
                 AXLOG("issues 18597 audio crash test");
                 for (int i = 0; i < 2; ++i)
                 {
@@ -755,7 +757,7 @@ bool AudioIssue18597Test::init()
         this->addChild(labelTime);
         // update label quickly
         this->schedule(
-            [=](float dt) {
+            [this](float dt) {
                 _time += dt;
                 char timeString[20] = {0};
                 sprintf(timeString, "Time %2.2f", _time);
@@ -1235,3 +1237,201 @@ std::string AudioUncacheInFinishedCB::subtitle() const
 {
     return "Should not crash";
 }
+
+namespace
+{
+// Mixes into in-memory buffers without any audio device, returns the failed checks.
+std::vector<std::string> runAudioMixerChecks()
+{
+    std::vector<std::string> failures;
+#define MIXER_CHECK(cond)                 \
+    do                                    \
+    {                                     \
+        if (!(cond))                      \
+            failures.emplace_back(#cond); \
+    } while (0)
+
+    auto makeClip = [](int16_t value, uint32_t frames, uint32_t channelCount, uint32_t sampleRate) {
+        auto clip          = std::make_shared<AudioMixer::Clip>();
+        clip->channelCount = channelCount;
+        clip->sampleRate   = sampleRate;
+        clip->samples.assign(frames * channelCount, value);
+        return clip;
+    };
+    std::vector<int16_t> output;
+
+    // voice stealing, the lowest priority is stolen first and higher priorities are never stolen
+    {
+        AudioMixer mixer(48000, 2);
+        auto clip = makeClip(1000, 4800, 1, 48000);
+        auto low     = mixer.play(clip, {1.0f, false, 0.0f, 0});
+        auto high    = mixer.play(clip, {1.0f, false, 0.0f, 1});
+        auto stealer = mixer.play(clip, {1.0f, false, 0.0f, 0});
+        MIXER_CHECK(!mixer.isPlaying(low));
+        MIXER_CHECK(mixer.isPlaying(high) && mixer.isPlaying(stealer));
+        MIXER_CHECK(mixer.play(clip, {1.0f, false, 0.0f, -1}) == AudioMixer::INVALID_VOICE);
+        MIXER_CHECK(mixer.getStats().stolenVoices == 1 && mixer.getStats().rejectedVoices == 1);
+        MIXER_CHECK(mixer.getVoiceCount() == 2);
+    }
+
+    // culling, an inaudible voice advances without being mixed
+    {
+        AudioMixer mixer(48000, 4);
+        mixer.setCullVolume(0.01f);
+        auto voice = mixer.play(makeClip(20000, 4800, 1, 48000), {0.001f});
+        output.assign(2 * 480, 1);
+        mixer.mix(output.data(), 480);
+        MIXER_CHECK(mixer.getStats().culledVoices == 1 && mixer.getStats().mixedVoices == 0);
+        MIXER_CHECK(std::all_of(output.begin(), output.end(), [](int16_t s) { return s == 0; }));
+        MIXER_CHECK(std::abs(mixer.getTime(voice) - 0.01f) < 1e-4f);
+    }
+
+    // resampling, a 24kHz mono clip of 100 frames lasts 200 frames at 48kHz on both channels
+    {
+        AudioMixer mixer(48000, 4);
+        auto voice = mixer.play(makeClip(1000, 100, 1, 24000), {});
+        output.assign(2 * 150, 0);
+        mixer.mix(output.data(), 150);
+        MIXER_CHECK(mixer.isPlaying(voice));
+        MIXER_CHECK(output[0] == 1000 && output[1] == 1000 && output[2 * 149 + 1] == 1000);
+        MIXER_CHECK(std::abs(mixer.getTime(voice) - 150.0f / 48000) < 1e-4f);
+        mixer.mix(output.data(), 150);
+        MIXER_CHECK(!mixer.isPlaying(voice));
+        MIXER_CHECK(output[2 * 149] == 0);
+    }
+
+    // saturation, the sum of loud voices is clamped to 16 bits
+    {
+        AudioMixer mixer(48000, 8);
+        for (int i = 0; i < 3; ++i)
+            mixer.play(makeClip(30000, 64, 2, 48000), {});
+        output.assign(2 * 32, 0);
+        mixer.mix(output.data(), 32);
+        MIXER_CHECK(std::all_of(output.begin(), output.end(), [](int16_t s) { return s == 32767; }));
+        mixer.stopAll();
+        for (int i = 0; i < 3; ++i)
+            mixer.play(makeClip(-30000, 64, 1, 48000), {});
+        mixer.mix(output.data(), 32);
+        MIXER_CHECK(std::all_of(output.begin(), output.end(), [](int16_t s) { return s == -32768; }));
+    }
+#undef MIXER_CHECK
+    return failures;
+}
+}  // namespace
+
+bool AudioMixerHeadlessTest::init()
+{
+    if (AudioEngineTestDemo::init())
+    {
+        _failures = runAudioMixerChecks();
+        for (auto&& failure : _failures)
+            AXLOG("AudioMixer check failed: %s", failure.c_str());
+        AXASSERT(_failures.empty(), "AudioMixer checks failed");
+        return true;
+    }
+
+    return false;
+}
+
+std::string AudioMixerHeadlessTest::title() const
+{
+    return "AudioMixer mixing into a buffer";
+}
+
+std::string AudioMixerHeadlessTest::subtitle() const
+{
+    return _failures.empty() ? "Stealing, culling, resampling and saturation checks passed"
+                             : StringUtils::format("%d checks failed, see the log", static_cast<int>(_failures.size()));
+}
+
+//
+void AudioCacheBudgetTest::onEnter()
+{
+    AudioEngineTestDemo::onEnter();
+
+    auto& layerSize = this->getContentSize();
+    _stateLabel     = Label::createWithTTF("status: playing", "fonts/arial.ttf", 24);
+    _stateLabel->setPosition(layerSize.width / 2, layerSize.height * 0.5f);
+    addChild(_stateLabel);
+
+    // a budget of one byte keeps only the clips which are playing decoded
+    AudioEngine::uncacheAll();
+    _oldBudget = AudioEngine::getCacheBudget();
+    AudioEngine::setCacheBudget(1);
+    _startStats = AudioEngine::getCacheStats();
+
+    _playList  = {"audio/SoundEffectsFX009/FX081.mp3", "audio/SoundEffectsFX009/FX082.mp3",
+                  "audio/SoundEffectsFX009/FX083.mp3", "audio/SoundEffectsFX009/FX081.mp3"};
+    _playIndex = 0;
+    playNext();
+}
+
+void AudioCacheBudgetTest::onExit()
+{
+    AudioEngine::setCacheBudget(_oldBudget);
+    AudioEngineTestDemo::onExit();
+}
+
+std::string AudioCacheBudgetTest::title() const
+{
+    return "Audio cache budget";
+}
+
+std::string AudioCacheBudgetTest::subtitle() const
+{
+    return "Plays 3 clips one by one with a 1 byte budget, then the first one again";
+}
+
+void AudioCacheBudgetTest::playNext()
+{
+    const bool replay = _playIndex == _playList.size() - 1;
+    if (replay)
+    {
+        // every clip which finished was evicted when the next one was decoded
+        const auto evictions = AudioEngine::getCacheStats().evictions - _startStats.evictions;
+        if (evictions < _playIndex - 1)
+        {
+            finish(StringUtils::format("failed: %u evictions, expected %u", evictions,
+                                       static_cast<unsigned int>(_playIndex - 1)));
+            return;
+        }
+    }
+
+    const auto misses = AudioEngine::getCacheStats().misses;
+    const int audioId = AudioEngine::play2d(_playList[_playIndex]);
+    if (audioId == AudioEngine::INVALID_AUDIO_ID)
+    {
+        finish("failed: can't play " + _playList[_playIndex]);
+        return;
+    }
+    if (replay && AudioEngine::getCacheStats().misses != misses + 1)
+    {
+        finish("failed: the evicted clip isn't decoded again");
+        return;
+    }
+
+    auto isDestroyed = _isDestroyed;
+    AudioEngine::setFinishCallback(audioId, [this, isDestroyed, replay](int finishID, std::string_view file) {
+        if (*isDestroyed)
+            return;
+
+        if (replay)
+        {
+            finish("passed");
+        }
+        else
+        {
+            ++_playIndex;
+            playNext();
+        }
+    });
+}
+
+void AudioCacheBudgetTest::finish(std::string_view result)
+{
+    const auto stats = AudioEngine::getCacheStats();
+    AXLOG("AudioCacheBudgetTest %s, hits: %u, misses: %u, evictions: %u", result.data(),
+          stats.hits - _startStats.hits, stats.misses - _startStats.misses, stats.evictions - _startStats.evictions);
+    AXASSERT(result == "passed", "AudioCacheBudgetTest failed");
+    _stateLabel->setString(StringUtils::format("status: %s", result.data()));
+}
@@ -33,6 +33,7 @@
 #    include "../BaseTest.h"
 
 #    include "audio/AudioEngine.h"
+#    include "audio/AudioMixer.h"
 
 DEFINE_TEST_SUITE(AudioEngineTests);
 
@@ -340,4 +341,40 @@ public:
 private:
 };
 
+class AudioMixerHeadlessTest : public AudioEngineTestDemo
+{
+public:
+    CREATE_FUNC(AudioMixerHeadlessTest);
+
+    virtual bool init() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<std::string> _failures;
+};
+
+class AudioCacheBudgetTest : public AudioEngineTestDemo
+{
+public:
+    CREATE_FUNC(AudioCacheBudgetTest);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void playNext();
+    void finish(std::string_view result);
+
+    std::vector<std::string> _playList;
+    size_t _playIndex      = 0;
+    size_t _oldBudget      = 0;
+    ax::Label* _stateLabel = nullptr;
+    ax::AudioCacheStats _startStats;
+};
+
 #endif /* defined(__NEWAUDIOENGINE_TEST_H_) */
@@ -28,6 +28,8 @@
 #include <chrono>
 #include <sstream>
 #include "renderer/backend/DriverBase.h"
+#include "renderer/backend/RenderTarget.h"
+#include "renderer/backend/null/DriverNull.h"
 
 namespace
 {
@@ -93,6 +95,7 @@ NewRendererTests::NewRendererTests()
     ADD_TEST_CASE(RendererUniformBatch2);
     ADD_TEST_CASE(SpriteCreation);
     ADD_TEST_CASE(NonBatchSprites);
+    ADD_TEST_CASE(NullBackendTest);
 };
 
 std::string MultiSceneTest::title() const
@@ -1066,3 +1069,150 @@ std::string NonBatchSprites::subtitle() const
     return "RELEASE: simulate lots of sprites, drop to 30 fps";
 #endif
 }
+
+////
+//// NullBackendTest
+////
+
+namespace
+{
+// Drives a DriverNull of its own, the renderer keeps using the platform driver.
+std::vector<std::string> runNullBackendChecks()
+{
+    using namespace ax::backend;
+
+    std::vector<std::string> failures;
+#define NULL_BACKEND_CHECK(cond)          \
+    do                                    \
+    {                                     \
+        if (!(cond))                      \
+            failures.emplace_back(#cond); \
+    } while (0)
+
+    static const char* vertexShader = R"(
+uniform mat4 u_MVPMatrix;
+attribute vec4 a_position;
+attribute vec2 a_texCoord;
+varying vec2 v_texCoord;
+void main()
+{
+    gl_Position = u_MVPMatrix * a_position;
+    v_texCoord  = a_texCoord;
+}
+)";
+    static const char* fragmentShader = R"(
+uniform vec4 u_color;
+uniform sampler2D u_tex0;
+varying vec2 v_texCoord;
+void main()
+{
+    gl_FragColor = texture2D(u_tex0, v_texCoord) * u_color;
+}
+)";
+
+    DriverNull driver;
+    auto commandBuffer = driver.newCommandBuffer();
+    auto renderTarget  = driver.newDefaultRenderTarget(TargetBufferFlags::COLOR);
+    auto vertexBuffer  = driver.newBuffer(64 * sizeof(V3F_C4B_T2F), BufferType::VERTEX, BufferUsage::DYNAMIC);
+    auto indexBuffer   = driver.newBuffer(96 * sizeof(uint16_t), BufferType::INDEX, BufferUsage::STATIC);
+    vertexBuffer->updateData(nullptr, 64 * sizeof(V3F_C4B_T2F));
+    indexBuffer->updateData(nullptr, 96 * sizeof(uint16_t));
+
+    TextureDescriptor descriptor;
+    descriptor.width  = 4;
+    descriptor.height = 4;
+    auto texture      = static_cast<Texture2DBackend*>(driver.newTexture(descriptor));
+
+    uint8_t pixels[4 * 4 * 4] = {};
+    texture->updateData(pixels, 4, 4, 0);
+
+    // the uniforms are reflected from the sources
+    auto program       = driver.newProgram(vertexShader, fragmentShader);
+    auto programState  = new ProgramState(program);
+    auto mvpLocation   = programState->getUniformLocation(Uniform::MVP_MATRIX);
+    auto colorLocation = programState->getUniformLocation("u_color");
+    NULL_BACKEND_CHECK(mvpLocation.location[0] >= 0 && colorLocation.location[0] >= 0);
+    NULL_BACKEND_CHECK(programState->getAttributeLocation("a_texCoord") >= 0);
+    programState->setTexture(programState->getUniformLocation("u_tex0"), 0, texture);
+
+    std::size_t uniformBufferSize = 0;
+    programState->getVertexUniformBuffer(uniformBufferSize);
+    NULL_BACKEND_CHECK(uniformBufferSize == sizeof(Mat4) + sizeof(Vec4));
+
+    commandBuffer->beginFrame();
+    commandBuffer->beginRenderPass(renderTarget, RenderPassDescriptor{});
+    commandBuffer->setViewport(0, 0, 320, 240);
+    commandBuffer->setViewport(0, 0, 320, 240);
+    for (int i = 0; i < 3; ++i)
+    {
+        // the first draw uploads the whole uniform buffer, the next ones only the changed color
+        const Vec4 color(1.0f, 0.5f, 0.25f, 1.0f / (i + 1));
+        programState->setUniform(colorLocation, &color, sizeof(color));
+        commandBuffer->setVertexBuffer(vertexBuffer);
+        commandBuffer->setIndexBuffer(indexBuffer);
+        commandBuffer->setProgramState(programState);
+        if (i < 2)
+            commandBuffer->drawElements(PrimitiveType::TRIANGLE, IndexFormat::U_SHORT, 96, 0);
+        else
+            commandBuffer->drawElementsInstanced(PrimitiveType::TRIANGLE, IndexFormat::U_SHORT, 96, 0, 10);
+    }
+    commandBuffer->endRenderPass();
+
+    int capturedWidth = 0, capturedHeight = 0;
+    commandBuffer->readPixels(renderTarget, [&](const PixelBufferDescriptor& pbd) {
+        capturedWidth  = pbd._width;
+        capturedHeight = pbd._height;
+    });
+    commandBuffer->endFrame();
+
+    const auto& stats = driver.getStats();
+    NULL_BACKEND_CHECK(stats.frames == 1 && stats.renderPasses == 1);
+    NULL_BACKEND_CHECK(stats.drawCalls == 3 && stats.vertices == 96 * 2 + 96 * 10);
+    NULL_BACKEND_CHECK(stats.buffers == 2 && stats.textures == 1 && stats.programs == 1);
+    NULL_BACKEND_CHECK(stats.bufferBytes == 64 * sizeof(V3F_C4B_T2F) + 96 * sizeof(uint16_t));
+    NULL_BACKEND_CHECK(stats.textureBytes == sizeof(pixels));
+    NULL_BACKEND_CHECK(stats.uniformBytes == uniformBufferSize + 2 * sizeof(Vec4));
+    NULL_BACKEND_CHECK(stats.textureBinds == 1);
+    // the viewport, then the vertex and index buffers which are released at the end of the pass
+    NULL_BACKEND_CHECK(stats.stateChanges == 3);
+    NULL_BACKEND_CHECK(capturedWidth == 320 && capturedHeight == 240);
+
+    driver.resetStats();
+    NULL_BACKEND_CHECK(driver.getStats().drawCalls == 0);
+
+    programState->release();
+    program->release();
+    texture->release();
+    indexBuffer->release();
+    vertexBuffer->release();
+    renderTarget->release();
+    commandBuffer->release();
+#undef NULL_BACKEND_CHECK
+    return failures;
+}
+}  // namespace
+
+bool NullBackendTest::init()
+{
+    if (MultiSceneTest::init())
+    {
+        _failures = runNullBackendChecks();
+        for (auto&& failure : _failures)
+            AXLOG("Null backend check failed: %s", failure.c_str());
+        AXASSERT(_failures.empty(), "Null backend checks failed");
+        return true;
+    }
+
+    return false;
+}
+
+std::string NullBackendTest::title() const
+{
+    return "Null backend";
+}
+
+std::string NullBackendTest::subtitle() const
+{
+    return _failures.empty() ? "Draws, uploads, uniforms and state changes were counted as expected"
+                             : StringUtils::format("%d checks failed, see the log", static_cast<int>(_failures.size()));
+}
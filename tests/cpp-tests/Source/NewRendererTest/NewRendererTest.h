@@ -279,4 +279,18 @@ protected:
     Ticker _contFast              = Ticker(2);
     Ticker _around30fps           = Ticker(60 * 3);
 };
+class NullBackendTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(NullBackendTest);
+
+    virtual bool init() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<std::string> _failures;
+};
+
 #endif  //__NewRendererTest_H_
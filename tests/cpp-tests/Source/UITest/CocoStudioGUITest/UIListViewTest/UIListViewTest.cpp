@@ -39,6 +39,7 @@ UIListViewTests::UIListViewTests()
     ADD_TEST_CASE(UIListViewTest_MagneticHorizontal);
     ADD_TEST_CASE(UIListViewTest_PaddingVertical);
     ADD_TEST_CASE(UIListViewTest_PaddingHorizontal);
+    ADD_TEST_CASE(UIListViewTest_Virtual);
     ADD_TEST_CASE(Issue12692);
     ADD_TEST_CASE(Issue8316);
 }
@@ -1058,3 +1059,135 @@ void UIListViewTest_Padding::sliderEvent(Ref* pSender, Slider::EventType type)
         }
     }
 }
+
+// UIListViewTest_Virtual
+bool UIListViewTest_Virtual::init()
+{
+    if (!UIScene::init())
+    {
+        return false;
+    }
+
+    Size layerSize = _uiLayer->getContentSize();
+
+    static const ssize_t NUMBER_OF_ITEMS = 1000;
+    _titleLabel = Text::create("Virtual list of 1000 items", "fonts/Marker Felt.ttf", 32);
+    _titleLabel->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    _titleLabel->setPosition(Vec2(layerSize / 2) + Vec2(0.0f, _titleLabel->getContentSize().height * 3.15f));
+    _uiLayer->addChild(_titleLabel, 3);
+
+    // Create the list view
+    _listView = ListView::create();
+    _listView->setDirection(ScrollView::Direction::VERTICAL);
+    _listView->setBounceEnabled(true);
+    _listView->setBackGroundImage("cocosui/green_edit.png");
+    _listView->setBackGroundImageScale9Enabled(true);
+    _listView->setContentSize(layerSize / 2);
+    _listView->setScrollBarPositionFromCorner(Vec2(7, 7));
+    _listView->setItemsMargin(2.0f);
+    _listView->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    _listView->setPosition(layerSize / 2);
+    _uiLayer->addChild(_listView);
+
+    // The items are cloned from the model and bound to an index
+    auto model = Button::create("cocosui/button.png", "cocosui/buttonHighlighted.png");
+    model->setContentSize(Size(120, 40));
+    model->setScale9Enabled(true);
+    _listView->setItemModel(model);
+    _listView->setVirtualItems(NUMBER_OF_ITEMS, [this](Widget* item, ssize_t index) {
+        _boundItems.insert(item);
+        static_cast<Button*>(item)->setTitleText(StringUtils::format("Button-%d", static_cast<int>(index)));
+    });
+
+    auto failures = runChecks();
+    for (auto&& failure : failures)
+        AXLOG("ListView virtual mode check failed: %s", failure.c_str());
+    AXASSERT(failures.empty(), "ListView virtual mode checks failed");
+
+    // Back to the top of the whole list for scrolling by hand
+    _listView->setVirtualItemCount(NUMBER_OF_ITEMS);
+    _listView->jumpToItem(0, Vec2::ANCHOR_MIDDLE_TOP, Vec2::ANCHOR_MIDDLE_TOP);
+
+    auto statusLabel = Text::create(failures.empty()
+                                        ? "Recycling, jumpToItem and item count checks passed"
+                                        : StringUtils::format("%d checks failed, see the log",
+                                                              static_cast<int>(failures.size())),
+                                    "fonts/Marker Felt.ttf", 18);
+    statusLabel->setPosition(Vec2(layerSize.width / 2, layerSize.height / 4 - 20.0f));
+    _uiLayer->addChild(statusLabel);
+    return true;
+}
+
+std::vector<std::string> UIListViewTest_Virtual::runChecks()
+{
+    std::vector<std::string> failures;
+#define LISTVIEW_CHECK(cond)              \
+    do                                    \
+    {                                     \
+        if (!(cond))                      \
+            failures.emplace_back(#cond); \
+    } while (0)
+
+    // the item at index is in view and shows the data of index
+    auto isBound = [this](ssize_t index) {
+        auto item = static_cast<Button*>(_listView->getItem(index));
+        return item && item->isVisible() && _listView->getIndex(item) == index &&
+               item->getTitleText() == StringUtils::format("Button-%d", static_cast<int>(index));
+    };
+    auto centerInView = [this](ssize_t index) {
+        auto item = _listView->getItem(index);
+        return _listView->convertToNodeSpace(item->convertToWorldSpaceAR(Vec2::ZERO));
+    };
+
+    // only the items in view are created
+    _listView->doLayout();
+    const auto createdItems = _boundItems.size();
+    LISTVIEW_CHECK(createdItems > 0 && createdItems < 20);
+    LISTVIEW_CHECK(isBound(0));
+    LISTVIEW_CHECK(_listView->getItem(100) == nullptr);
+
+    // scrolling an item at a time recycles the items which left the view instead of cloning the model
+    bool allBound = true;
+    for (ssize_t index = 1; index <= 200; ++index)
+    {
+        _listView->jumpToItem(index, Vec2::ANCHOR_MIDDLE_TOP, Vec2::ANCHOR_MIDDLE_TOP);
+        _listView->doLayout();
+        allBound = allBound && isBound(index);
+    }
+    LISTVIEW_CHECK(allBound);
+    LISTVIEW_CHECK(_boundItems.size() <= createdItems + 1);
+    LISTVIEW_CHECK(_listView->getItem(0) == nullptr);
+
+    // jumping far away binds the recycled items to the new indices
+    _listView->jumpToItem(700, Vec2::ANCHOR_MIDDLE, Vec2::ANCHOR_MIDDLE);
+    _listView->doLayout();
+    LISTVIEW_CHECK(isBound(700) && std::abs(centerInView(700).y - _listView->getContentSize().height / 2) < 1.0f);
+    LISTVIEW_CHECK(_boundItems.size() <= createdItems + 1);
+
+    // shrinking the list while scrolled past its new end shows its last items
+    const float innerHeight = _listView->getInnerContainerSize().height;
+    _listView->setVirtualItemCount(100);
+    _listView->doLayout();
+    LISTVIEW_CHECK(_listView->getVirtualItemCount() == 100);
+    LISTVIEW_CHECK(_listView->getInnerContainerSize().height < innerHeight);
+    LISTVIEW_CHECK(_listView->getItem(700) == nullptr);
+    LISTVIEW_CHECK(isBound(99));
+    bool inRange = true;
+    for (auto&& child : _listView->getInnerContainer()->getChildren())
+    {
+        if (child->isVisible())
+        {
+            const auto index = _listView->getIndex(static_cast<Widget*>(child));
+            inRange          = inRange && index >= 0 && index < 100;
+        }
+    }
+    LISTVIEW_CHECK(inRange);
+
+    // and jumpToItem stays within the new count
+    _listView->jumpToItem(50, Vec2::ANCHOR_MIDDLE, Vec2::ANCHOR_MIDDLE);
+    _listView->doLayout();
+    LISTVIEW_CHECK(isBound(50));
+    LISTVIEW_CHECK(_boundItems.size() <= createdItems + 1);
+#undef LISTVIEW_CHECK
+    return failures;
+}
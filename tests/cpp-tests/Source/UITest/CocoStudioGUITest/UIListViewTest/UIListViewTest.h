@@ -29,6 +29,8 @@
 #include "../UIScene.h"
 #include "ui/UIScrollView.h"
 
+#include <set>
+
 DEFINE_TEST_SUITE(UIListViewTests);
 
 class UIListViewTest_Vertical : public UIScene
@@ -219,4 +221,20 @@ public:
     }
 };
 
+// Test for the virtual mode, only the items in view exist and are recycled while scrolling
+class UIListViewTest_Virtual : public UIScene
+{
+public:
+    CREATE_FUNC(UIListViewTest_Virtual);
+
+protected:
+    virtual bool init() override;
+    std::vector<std::string> runChecks();
+
+    ax::ui::ListView* _listView = nullptr;
+    ax::ui::Text* _titleLabel   = nullptr;
+    // every widget the binder was called with, the clones of the item model
+    std::set<ax::ui::Widget*> _boundItems;
+};
+
 #endif /* defined(__TestCpp__UIListViewTest__) */